@@ -5,7 +5,7 @@
  */
 
 #include "art/Framework/Core/ModuleMacros.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 
 #include "lardataobj/RecoBase/PFParticle.h"
 #include "lardataobj/RecoBase/Track.h"
@@ -21,7 +21,7 @@ namespace lar_pandora
 /**
  *  @brief  ConsolidatedPFParticleAnalysisTemplate class
  */
-class ConsolidatedPFParticleAnalysisTemplate : public art::EDAnalyzer
+class ConsolidatedPFParticleAnalysisTemplate : public art::SharedAnalyzer
 {
 public:
     typedef art::Handle< std::vector<recob::PFParticle> > PFParticleHandle;
@@ -34,8 +34,9 @@ public:
      *  @brief  Constructor
      *
      *  @param  pset the set of input fhicl parameters
+     *  @param  frame the processing frame
      */
-    ConsolidatedPFParticleAnalysisTemplate(fhicl::ParameterSet const &pset);
+    ConsolidatedPFParticleAnalysisTemplate(fhicl::ParameterSet const &pset, art::ProcessingFrame const &frame);
 
     /**
      *  @brief  Configure memeber variables using FHiCL parameters
@@ -48,8 +49,9 @@ public:
      *  @brief  Analyze an event!
      *
      *  @param  evt the art event to analyze
+     *  @param  frame the processing frame
      */
-    void analyze(const art::Event &evt);
+    void analyze(const art::Event &evt, art::ProcessingFrame const &frame) override;
 
 private:
     /**
@@ -58,7 +60,7 @@ private:
      *  @param  pfParticleHandle the handle for the PFParticle collection
      *  @param  pfParticleMap the mapping from ID to PFParticle
      */
-    void GetPFParticleIdMap(const PFParticleHandle &pfParticleHandle, PFParticleIdMap &pfParticleMap);
+    void GetPFParticleIdMap(const PFParticleHandle &pfParticleHandle, PFParticleIdMap &pfParticleMap) const;
 
     /**
      * @brief Print out scores in PFParticleMetadata
@@ -75,7 +77,7 @@ private:
      *  @param  crParticles a vector to hold the top-level PFParticles reconstructed under the cosmic hypothesis
      *  @param  nuParticles a vector to hold the final-states of the reconstruced neutrino
      */
-    void GetFinalStatePFParticleVectors(const PFParticleIdMap &pfParticleMap, PFParticleVector &crParticles, PFParticleVector &nuParticles);
+    void GetFinalStatePFParticleVectors(const PFParticleIdMap &pfParticleMap, PFParticleVector &crParticles, PFParticleVector &nuParticles) const;
 
     /**
      *  @brief  Collect associated tracks and showers to particles in an input particle vector
@@ -86,7 +88,7 @@ private:
      *  @param  tracks a vector to hold the associated tracks
      *  @param  showers a vector to hold the associated showers
      */
-    void CollectTracksAndShowers(const PFParticleVector &particles, const PFParticleHandle &pfParticleHandle, const art::Event &evt, TrackVector &tracks, ShowerVector &showers);
+    void CollectTracksAndShowers(const PFParticleVector &particles, const PFParticleHandle &pfParticleHandle, const art::Event &evt, TrackVector &tracks, ShowerVector &showers) const;
 
     std::string m_pandoraLabel;         ///< The label for the pandora producer
     std::string m_trackLabel;           ///< The label for the track producer from PFParticles
@@ -119,9 +121,12 @@ DEFINE_ART_MODULE(ConsolidatedPFParticleAnalysisTemplate)
 namespace lar_pandora
 {
 
-ConsolidatedPFParticleAnalysisTemplate::ConsolidatedPFParticleAnalysisTemplate(fhicl::ParameterSet const &pset) : art::EDAnalyzer(pset)
+ConsolidatedPFParticleAnalysisTemplate::ConsolidatedPFParticleAnalysisTemplate(fhicl::ParameterSet const &pset, art::ProcessingFrame const &) : art::SharedAnalyzer(pset)
 {
     this->reconfigure(pset);
+
+    // ATTN All per-event state is local to analyze, so events can be processed concurrently
+    async<art::InEvent>();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -136,7 +141,7 @@ void ConsolidatedPFParticleAnalysisTemplate::reconfigure(fhicl::ParameterSet con
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void ConsolidatedPFParticleAnalysisTemplate::analyze(const art::Event &evt)
+void ConsolidatedPFParticleAnalysisTemplate::analyze(const art::Event &evt, art::ProcessingFrame const &)
 {
     // Collect the PFParticles from the event
     PFParticleHandle pfParticleHandle;
@@ -182,7 +187,7 @@ void ConsolidatedPFParticleAnalysisTemplate::analyze(const art::Event &evt)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void ConsolidatedPFParticleAnalysisTemplate::GetPFParticleIdMap(const PFParticleHandle &pfParticleHandle, PFParticleIdMap &pfParticleMap)
+void ConsolidatedPFParticleAnalysisTemplate::GetPFParticleIdMap(const PFParticleHandle &pfParticleHandle, PFParticleIdMap &pfParticleMap) const
 {
     for (unsigned int i = 0; i < pfParticleHandle->size(); ++i)
     {
@@ -222,7 +227,7 @@ void ConsolidatedPFParticleAnalysisTemplate::PrintOutScores(const art::Event &ev
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void ConsolidatedPFParticleAnalysisTemplate::GetFinalStatePFParticleVectors(const PFParticleIdMap &pfParticleMap, PFParticleVector &crParticles, PFParticleVector &nuParticles)
+void ConsolidatedPFParticleAnalysisTemplate::GetFinalStatePFParticleVectors(const PFParticleIdMap &pfParticleMap, PFParticleVector &crParticles, PFParticleVector &nuParticles) const
 {
     for (PFParticleIdMap::const_iterator it = pfParticleMap.begin(); it != pfParticleMap.end(); ++it)
     {
@@ -262,7 +267,7 @@ void ConsolidatedPFParticleAnalysisTemplate::GetFinalStatePFParticleVectors(cons
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void ConsolidatedPFParticleAnalysisTemplate::CollectTracksAndShowers(const PFParticleVector &particles, const PFParticleHandle &pfParticleHandle, const art::Event &evt, TrackVector &tracks, ShowerVector &showers)
+void ConsolidatedPFParticleAnalysisTemplate::CollectTracksAndShowers(const PFParticleVector &particles, const PFParticleHandle &pfParticleHandle, const art::Event &evt, TrackVector &tracks, ShowerVector &showers) const
 {
     // Get the associations between PFParticles and tracks/showers from the event
     art::FindManyP< recob::Track > pfPartToTrackAssoc(pfParticleHandle, evt, m_trackLabel);
@@ -5,12 +5,13 @@
  */
 
 #include "art/Framework/Core/ModuleMacros.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 
 #include "TTree.h"
 #include "TVector3.h"
 
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h"
 
 #include <string>
 
@@ -22,24 +23,25 @@ namespace lar_pandora
 /**
  *  @brief  PFParticleAnalysis class
  */
-class PFParticleAnalysis : public art::EDAnalyzer
+class PFParticleAnalysis : public art::SharedAnalyzer
 {
 public:
     /**
      *  @brief  Constructor
      *
      *  @param  pset
+     *  @param  frame
      */
-     PFParticleAnalysis(fhicl::ParameterSet const &pset);
+     PFParticleAnalysis(fhicl::ParameterSet const &pset, art::ProcessingFrame const &frame);
 
     /**
      *  @brief  Destructor
      */
      virtual ~PFParticleAnalysis();
 
-     void beginJob();
-     void endJob();
-     void analyze(const art::Event &evt);
+     void beginJob(art::ProcessingFrame const &frame) override;
+     void endJob(art::ProcessingFrame const &frame) override;
+     void analyze(const art::Event &evt, art::ProcessingFrame const &frame) override;
      void reconfigure(fhicl::ParameterSet const &pset);
 
 private:
@@ -136,9 +138,10 @@ DEFINE_ART_MODULE(PFParticleAnalysis)
 namespace lar_pandora
 {
 
-PFParticleAnalysis::PFParticleAnalysis(fhicl::ParameterSet const &pset) : art::EDAnalyzer(pset)
+PFParticleAnalysis::PFParticleAnalysis(fhicl::ParameterSet const &pset, art::ProcessingFrame const &) : art::SharedAnalyzer(pset)
 {
     this->reconfigure(pset);
+    serialize(art::SharedResource<art::TFileService>);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -159,7 +162,7 @@ void PFParticleAnalysis::reconfigure(fhicl::ParameterSet const &pset)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleAnalysis::beginJob()
+void PFParticleAnalysis::beginJob(art::ProcessingFrame const &)
 {
     mf::LogDebug("LArPandora") << " *** PFParticleAnalysis::beginJob() *** " << std::endl;
 
@@ -220,14 +223,60 @@ void PFParticleAnalysis::beginJob()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleAnalysis::endJob()
+void PFParticleAnalysis::endJob(art::ProcessingFrame const &)
 {
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleAnalysis::analyze(const art::Event &evt)
+void PFParticleAnalysis::analyze(const art::Event &evt, art::ProcessingFrame const &)
 {
+    // Get the reconstructed PFParticles
+    // =================================
+    PFParticleVector particleVector;
+    PFParticleVector particles1, particles2;
+    PFParticlesToClusters particlesToClusters;
+    PFParticlesToSpacePoints particlesToSpacePoints;
+    PFParticlesToHits particlesToHits;
+    HitsToPFParticles hitsToParticles;
+
+    LArPandoraHelper::CollectPFParticles(evt, m_particleLabel, particleVector);
+    LArPandoraHelper::CollectPFParticles(evt, m_particleLabel, particles1, particlesToClusters);
+    LArPandoraHelper::CollectPFParticles(evt, m_particleLabel, particles2, particlesToSpacePoints);
+    LArPandoraHelper::BuildPFParticleHitMaps(evt, m_particleLabel, particlesToHits, hitsToParticles);
+
+    // Get the reconstructed vertices
+    // ==============================
+    VertexVector vertexVector;
+    PFParticlesToVertices particlesToVertices;
+    LArPandoraHelper::CollectVertices(evt, m_particleLabel, vertexVector, particlesToVertices);
+
+    // Get the reconstructed tracks
+    // ============================
+    TrackVector trackVector, trackVector2;
+    PFParticlesToTracks particlesToTracks;
+    TracksToHits tracksToHits;
+    LArPandoraHelper::CollectTracks(evt, m_trackLabel, trackVector, particlesToTracks);
+    LArPandoraHelper::CollectTracks(evt, m_trackLabel, trackVector2, tracksToHits);
+
+    // Get the reconstructed showers
+    // ============================
+    ShowerVector showerVector, showerVector2;
+    PFParticlesToShowers particlesToShowers;
+    ShowersToHits showersToHits;
+    LArPandoraHelper::CollectShowers(evt, m_showerLabel, showerVector, particlesToShowers);
+    LArPandoraHelper::CollectShowers(evt, m_showerLabel, showerVector2, showersToHits);
+
+    // Get the reconstructed T0 objects
+    // ================================
+    T0Vector t0Vector;
+    PFParticlesToT0s particlesToT0s;
+    LArPandoraHelper::CollectT0s(evt, m_particleLabel, t0Vector, particlesToT0s);
+
+    // Build the hierarchy of the PFParticles
+    // ======================================
+    const PFParticleHierarchy particleHierarchy(particleVector);
+
     if (m_printDebug)
         std::cout << " *** PFParticleAnalysis::analyze(...) *** " << std::endl;
 
@@ -293,20 +342,6 @@ void PFParticleAnalysis::analyze(const art::Event &evt)
         std::cout << "  Event: " << m_event << std::endl;
     }
 
-    // Get the reconstructed PFParticles
-    // =================================
-    PFParticleVector particleVector;
-    PFParticleVector particles1, particles2;
-    PFParticlesToClusters particlesToClusters;
-    PFParticlesToSpacePoints particlesToSpacePoints;
-    PFParticlesToHits particlesToHits;
-    HitsToPFParticles hitsToParticles;
-
-    LArPandoraHelper::CollectPFParticles(evt, m_particleLabel, particleVector);
-    LArPandoraHelper::CollectPFParticles(evt, m_particleLabel, particles1, particlesToClusters);
-    LArPandoraHelper::CollectPFParticles(evt, m_particleLabel, particles2, particlesToSpacePoints);
-    LArPandoraHelper::BuildPFParticleHitMaps(evt, m_particleLabel, particlesToHits, hitsToParticles);
-
     if (m_printDebug)
         std::cout << "  PFParticles: " << particleVector.size() << std::endl;
 
@@ -316,39 +351,6 @@ void PFParticleAnalysis::analyze(const art::Event &evt)
         return;
     }
 
-    // Get the reconstructed vertices
-    // ==============================
-    VertexVector vertexVector;
-    PFParticlesToVertices particlesToVertices;
-    LArPandoraHelper::CollectVertices(evt, m_particleLabel, vertexVector, particlesToVertices);
-
-    // Get the reconstructed tracks
-    // ============================
-    TrackVector trackVector, trackVector2;
-    PFParticlesToTracks particlesToTracks;
-    TracksToHits tracksToHits;
-    LArPandoraHelper::CollectTracks(evt, m_trackLabel, trackVector, particlesToTracks);
-    LArPandoraHelper::CollectTracks(evt, m_trackLabel, trackVector2, tracksToHits);
-
-    // Get the reconstructed showers
-    // ============================
-    ShowerVector showerVector, showerVector2;
-    PFParticlesToShowers particlesToShowers;
-    ShowersToHits showersToHits;
-    LArPandoraHelper::CollectShowers(evt, m_showerLabel, showerVector, particlesToShowers);
-    LArPandoraHelper::CollectShowers(evt, m_showerLabel, showerVector2, showersToHits);
-
-    // Get the reconstructed T0 objects
-    // ================================
-    T0Vector t0Vector;
-    PFParticlesToT0s particlesToT0s;
-    LArPandoraHelper::CollectT0s(evt, m_particleLabel, t0Vector, particlesToT0s);
-
-    // Build an indexed map of the PFParticles
-    // =======================================
-    PFParticleMap particleMap;
-    LArPandoraHelper::BuildPFParticleMap(particleVector, particleMap);
-
     // Write PFParticle properties to ROOT file
     // ========================================
     for (unsigned int n = 0; n < particleVector.size(); ++n)
@@ -361,9 +363,9 @@ void PFParticleAnalysis::analyze(const art::Event &evt)
         m_primary = particle->IsPrimary();
         m_parent = (particle->IsPrimary() ? -1 : particle->Parent());
         m_daughters = particle->NumDaughters();
-        m_generation = LArPandoraHelper::GetGeneration(particleMap, particle);
-        m_neutrino = LArPandoraHelper::GetParentNeutrino(particleMap, particle);
-        m_finalstate = LArPandoraHelper::IsFinalState(particleMap, particle);
+        m_generation = LArPandoraHelper::GetGeneration(particleHierarchy, particle);
+        m_neutrino = LArPandoraHelper::GetParentNeutrino(particleHierarchy, particle);
+        m_finalstate = LArPandoraHelper::IsFinalState(particleHierarchy, particle);
         m_vertex = 0;
         m_track = 0;
         m_trackid = -999;
@@ -5,7 +5,7 @@
  */
 
 #include "art/Framework/Core/ModuleMacros.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
@@ -21,24 +21,25 @@ namespace lar_pandora
 /**
  *  @brief  PFParticleCosmicAna class
  */
-class PFParticleCosmicAna : public art::EDAnalyzer
+class PFParticleCosmicAna : public art::SharedAnalyzer
 {
 public:
     /**
      *  @brief  Constructor
      *
      *  @param  pset
+     *  @param  frame
      */
-     PFParticleCosmicAna(fhicl::ParameterSet const &pset);
+     PFParticleCosmicAna(fhicl::ParameterSet const &pset, art::ProcessingFrame const &frame);
 
     /**
      *  @brief  Destructor
      */
      virtual ~PFParticleCosmicAna();
 
-     void beginJob();
-     void endJob();
-     void analyze(const art::Event &evt);
+     void beginJob(art::ProcessingFrame const &frame) override;
+     void endJob(art::ProcessingFrame const &frame) override;
+     void analyze(const art::Event &evt, art::ProcessingFrame const &frame) override;
      void reconfigure(fhicl::ParameterSet const &pset);
 
 private:
@@ -76,6 +77,7 @@ private:
      float GetCosmicScore(const art::Ptr<recob::PFParticle> particle, const PFParticlesToTracks &recoParticlesToTracks,
          const TracksToCosmicTags &recoTracksToCosmicTags) const;
 
+
      TTree       *m_pRecoTree;              ///<
      TTree       *m_pTrueTree;              ///<
 
@@ -167,9 +169,10 @@ DEFINE_ART_MODULE(PFParticleCosmicAna)
 namespace lar_pandora
 {
 
-PFParticleCosmicAna::PFParticleCosmicAna(fhicl::ParameterSet const &pset) : art::EDAnalyzer(pset)
+PFParticleCosmicAna::PFParticleCosmicAna(fhicl::ParameterSet const &pset, art::ProcessingFrame const &) : art::SharedAnalyzer(pset)
 {
     this->reconfigure(pset);
+    serialize(art::SharedResource<art::TFileService>);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -196,7 +199,7 @@ void PFParticleCosmicAna::reconfigure(fhicl::ParameterSet const &pset)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleCosmicAna::beginJob()
+void PFParticleCosmicAna::beginJob(art::ProcessingFrame const &)
 {
     mf::LogDebug("LArPandora") << " *** PFParticleCosmicAna::beginJob() *** " << std::endl;
 
@@ -255,27 +258,18 @@ void PFParticleCosmicAna::beginJob()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleCosmicAna::endJob()
+void PFParticleCosmicAna::endJob(art::ProcessingFrame const &)
 {
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleCosmicAna::analyze(const art::Event &evt)
+void PFParticleCosmicAna::analyze(const art::Event &evt, art::ProcessingFrame const &)
 {
-    std::cout << " *** PFParticleCosmicAna::analyze(...) *** " << std::endl;
-
     //
     // Note: I've made this is MicroBooNE-only module
     //
 
-    m_run = evt.run();
-    m_event = evt.id().event();
-
-    std::cout << "  Run: " << m_run << std::endl;
-    std::cout << "  Event: " << m_event << std::endl;
-
-
     // Collect True Particles
     // ======================
     HitVector hitVector;
@@ -300,8 +294,6 @@ void PFParticleCosmicAna::analyze(const art::Event &evt)
     LArPandoraHelper::BuildPFParticleHitMaps(evt, m_particleLabel, m_particleLabel, recoParticlesToHits, recoHitsToParticles,
         (m_useDaughterPFParticles ? LArPandoraHelper::kAddDaughters : LArPandoraHelper::kIgnoreDaughters));
 
-    std::cout << "  PFParticles: " << recoParticleVector.size() << std::endl;
-
 
     // Collect Reco Tracks
     // ===================
@@ -316,6 +308,14 @@ void PFParticleCosmicAna::analyze(const art::Event &evt)
     TracksToCosmicTags recoTracksToCosmicTags;
     LArPandoraHelper::CollectCosmicTags(evt, m_cosmicLabel, recoCosmicTagVector, recoTracksToCosmicTags);
 
+    std::cout << " *** PFParticleCosmicAna::analyze(...) *** " << std::endl;
+
+    m_run = evt.run();
+    m_event = evt.id().event();
+
+    std::cout << "  Run: " << m_run << std::endl;
+    std::cout << "  Event: " << m_event << std::endl;
+    std::cout << "  PFParticles: " << recoParticleVector.size() << std::endl;
 
     // Analyse Reconstructed Particles
     // ===============================
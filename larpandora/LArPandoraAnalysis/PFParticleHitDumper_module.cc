@@ -5,16 +5,22 @@
  *
  */
 
-#include "art/Framework/Core/EDAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 
+#include "TBranch.h"
+#include "TObjArray.h"
 #include "TTree.h"
 
+#include "larcorealg/Geometry/GeometryCore.h"
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
+#include <deque>
 #include <string>
+#include <vector>
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -23,26 +29,119 @@ namespace lar_pandora {
   /**
  *  @brief  PFParticleHitDumper class
  */
-  class PFParticleHitDumper : public art::EDAnalyzer {
+  class PFParticleHitDumper : public art::SharedAnalyzer {
   public:
     /**
      *  @brief  Constructor
      *
      *  @param  pset
+     *  @param  frame
      */
-    PFParticleHitDumper(fhicl::ParameterSet const& pset);
+    PFParticleHitDumper(fhicl::ParameterSet const& pset, art::ProcessingFrame const& frame);
 
     /**
      *  @brief  Destructor
      */
     virtual ~PFParticleHitDumper();
 
-    void beginJob();
-    void endJob();
-    void analyze(const art::Event& evt);
+    void beginJob(art::ProcessingFrame const& frame) override;
+    void endJob(art::ProcessingFrame const& frame) override;
+    void analyze(const art::Event& evt, art::ProcessingFrame const& frame) override;
     void reconfigure(fhicl::ParameterSet const& pset);
 
   private:
+    /**
+     *  @brief  ColumnSet class, buffering the rows of one tree for the columnar output mode
+     */
+    class ColumnSet {
+    public:
+      /**
+       *  @brief Add an integer column, sampled from the provided address for each row
+       *
+       *  @param pTree the tree holding the column branch
+       *  @param name the branch name
+       *  @param pValue the address of the value to sample
+       */
+      void AddColumn(TTree* pTree, const std::string& name, const int* pValue);
+
+      /**
+       *  @brief Add a floating point column, sampled from the provided address for each row
+       *
+       *  @param pTree the tree holding the column branch
+       *  @param name the branch name
+       *  @param pValue the address of the value to sample
+       */
+      void AddColumn(TTree* pTree, const std::string& name, const double* pValue);
+
+      /**
+       *  @brief Reserve space for a number of rows in every column
+       *
+       *  @param nRows the number of rows
+       */
+      void Reserve(const size_t nRows);
+
+      /**
+       *  @brief Append the current values to every column
+       */
+      void AppendRow();
+
+      /**
+       *  @brief Remove all rows, keeping the allocated capacity
+       */
+      void Clear();
+
+    private:
+      template <typename T>
+      using Column = std::pair<const T*, std::vector<T>>;
+
+      // ATTN Deques keep the addresses of the column vectors, registered as branches, stable
+      std::deque<Column<int>> m_intColumns;       ///< The integer columns
+      std::deque<Column<double>> m_doubleColumns; ///< The floating point columns
+    };
+
+    /**
+     *  @brief Add a branch, holding a scalar in flat mode or a per-event column in columnar mode
+     *
+     *  @param pTree the output tree
+     *  @param columns the column set of the tree
+     *  @param name the branch name
+     *  @param pValue the address of the value to store
+     */
+    void AddBranch(TTree* pTree, ColumnSet& columns, const std::string& name, int* pValue);
+
+    /**
+     *  @brief Add a branch, holding a scalar in flat mode or a per-event column in columnar mode
+     *
+     *  @param pTree the output tree
+     *  @param columns the column set of the tree
+     *  @param name the branch name
+     *  @param pValue the address of the value to store
+     */
+    void AddBranch(TTree* pTree, ColumnSet& columns, const std::string& name, double* pValue);
+
+    /**
+     *  @brief Store the current values, as a tree entry in flat mode or as a column row in columnar mode
+     *
+     *  @param pTree the output tree
+     *  @param columns the column set of the tree
+     */
+    void FillRow(TTree* pTree, ColumnSet& columns);
+
+    /**
+     *  @brief Write the buffered columns of the current event as a single tree entry
+     *
+     *  @param pTree the output tree
+     *  @param columns the column set of the tree
+     */
+    void FillColumns(TTree* pTree, ColumnSet& columns);
+
+    /**
+     *  @brief Apply the configured basket size and compression settings to all branches of a tree
+     *
+     *  @param pTree the output tree
+     */
+    void ConfigureTree(TTree* pTree) const;
+
     /**
      *  @brief Store 3D track hits
      *
@@ -64,10 +163,11 @@ namespace lar_pandora {
     /**
      *  @brief Store 2D hits
      *
+     *  @param detProp the detector properties, to convert from ticks to X
      *  @param hitVector the input vector of 2D hits
      *  @param hitsToParticles mapping between 2D hits and PFParticles
      */
-    void FillReco2D(const art::Event& event,
+    void FillReco2D(const detinfo::DetectorPropertiesData& detProp,
                     const HitVector& hitVector,
                     const HitsToPFParticles& hitsToParticles);
 
@@ -92,9 +192,13 @@ namespace lar_pandora {
     /**
      *  @brief Store raw data
      *
+     *  @param geometry the geometry, to convert from channel to wire ID
+     *  @param detProp the detector properties, to convert from ticks to X
      *  @param wireVector the input vector of reconstructed wires
      */
-    void FillRecoWires(const art::Event& event, const WireVector& wireVector);
+    void FillRecoWires(const geo::GeometryCore& geometry,
+                       const detinfo::DetectorPropertiesData& detProp,
+                       const WireVector& wireVector);
 
     /**
      *  @brief Conversion from wire ID to U/V/W coordinate
@@ -129,12 +233,19 @@ namespace lar_pandora {
                  const double y,
                  const double z) const;
 
+
     TTree* m_pRecoTracks;     ///<
     TTree* m_pReco3D;         ///<
     TTree* m_pReco2D;         ///<
     TTree* m_pRecoComparison; ///<
     TTree* m_pRecoWire;       ///<
 
+    ColumnSet m_recoTracksColumns;     ///<
+    ColumnSet m_reco3DColumns;         ///<
+    ColumnSet m_reco2DColumns;         ///<
+    ColumnSet m_recoComparisonColumns; ///<
+    ColumnSet m_recoWireColumns;       ///<
+
     int m_run;      ///<
     int m_event;    ///<
     int m_particle; ///<
@@ -166,8 +277,11 @@ namespace lar_pandora {
     std::string m_trackLabel;      ///<
     std::string m_showerLabel;     ///<
 
-    bool m_storeWires; ///<
-    bool m_printDebug; ///< switch for print statements (TODO: use message service!)
+    bool m_storeWires;         ///<
+    bool m_columnarOutput;     ///< whether to store one entry per event, with vector branches
+    int m_basketSize;          ///< branch basket size in bytes (ROOT default if not positive)
+    int m_compressionSettings; ///< 100 * algorithm + level (file default if negative)
+    bool m_printDebug;         ///< switch for print statements (TODO: use message service!)
   };
 
   DEFINE_ART_MODULE(PFParticleHitDumper)
@@ -206,9 +320,12 @@ namespace lar_pandora {
 
 namespace lar_pandora {
 
-  PFParticleHitDumper::PFParticleHitDumper(fhicl::ParameterSet const& pset) : art::EDAnalyzer(pset)
+  PFParticleHitDumper::PFParticleHitDumper(fhicl::ParameterSet const& pset,
+                                           art::ProcessingFrame const&)
+    : art::SharedAnalyzer(pset)
   {
     this->reconfigure(pset);
+    serialize(art::SharedResource<art::TFileService>);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -221,6 +338,9 @@ namespace lar_pandora {
   PFParticleHitDumper::reconfigure(fhicl::ParameterSet const& pset)
   {
     m_storeWires = pset.get<bool>("StoreWires", false);
+    m_columnarOutput = pset.get<bool>("ColumnarOutput", false);
+    m_basketSize = pset.get<int>("BasketSize", 0);
+    m_compressionSettings = pset.get<int>("CompressionSettings", -1);
     m_trackLabel = pset.get<std::string>("TrackModule", "pandoraTrack");
     m_showerLabel = pset.get<std::string>("ShowerModule", "pandoraShower");
     m_particleLabel = pset.get<std::string>("PFParticleModule", "pandora");
@@ -234,7 +354,7 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleHitDumper::beginJob()
+  PFParticleHitDumper::beginJob(art::ProcessingFrame const&)
   {
     mf::LogDebug("LArPandora") << " *** PFParticleHitDumper::beginJob() *** " << std::endl;
 
@@ -244,103 +364,77 @@ namespace lar_pandora {
     m_pRecoTracks = tfs->make<TTree>("pandoraTracks", "LAr Reco Tracks");
     m_pRecoTracks->Branch("run", &m_run, "run/I");
     m_pRecoTracks->Branch("event", &m_event, "event/I");
-    m_pRecoTracks->Branch("particle", &m_particle, "particle/I");
-    m_pRecoTracks->Branch("x", &m_x, "x/D");
-    m_pRecoTracks->Branch("y", &m_y, "y/D");
-    m_pRecoTracks->Branch("z", &m_z, "z/D");
+    this->AddBranch(m_pRecoTracks, m_recoTracksColumns, "particle", &m_particle);
+    this->AddBranch(m_pRecoTracks, m_recoTracksColumns, "x", &m_x);
+    this->AddBranch(m_pRecoTracks, m_recoTracksColumns, "y", &m_y);
+    this->AddBranch(m_pRecoTracks, m_recoTracksColumns, "z", &m_z);
 
     m_pReco3D = tfs->make<TTree>("pandora3D", "LAr Reco 3D");
     m_pReco3D->Branch("run", &m_run, "run/I");
     m_pReco3D->Branch("event", &m_event, "event/I");
-    m_pReco3D->Branch("particle", &m_particle, "particle/I");
-    m_pReco3D->Branch("primary", &m_primary, "primary/I");
-    m_pReco3D->Branch("pdgcode", &m_pdgcode, "pdgcode/I");
-    m_pReco3D->Branch("cstat", &m_cstat, "cstat/I");
-    m_pReco3D->Branch("tpc", &m_tpc, "tpc/I");
-    m_pReco3D->Branch("plane", &m_plane, "plane/I");
-    m_pReco3D->Branch("x", &m_x, "x/D");
-    m_pReco3D->Branch("y", &m_y, "y/D");
-    m_pReco3D->Branch("u", &m_u, "u/D");
-    m_pReco3D->Branch("v", &m_v, "v/D");
-    m_pReco3D->Branch("z", &m_z, "z/D");
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "particle", &m_particle);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "primary", &m_primary);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "pdgcode", &m_pdgcode);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "cstat", &m_cstat);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "tpc", &m_tpc);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "plane", &m_plane);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "x", &m_x);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "y", &m_y);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "u", &m_u);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "v", &m_v);
+    this->AddBranch(m_pReco3D, m_reco3DColumns, "z", &m_z);
 
     m_pReco2D = tfs->make<TTree>("pandora2D", "LAr Reco 2D");
     m_pReco2D->Branch("run", &m_run, "run/I");
     m_pReco2D->Branch("event", &m_event, "event/I");
-    m_pReco2D->Branch("particle", &m_particle, "particle/I");
-    m_pReco2D->Branch("pdgcode", &m_pdgcode, "pdgcode/I");
-    m_pReco2D->Branch("cstat", &m_cstat, "cstat/I");
-    m_pReco2D->Branch("tpc", &m_tpc, "tpc/I");
-    m_pReco2D->Branch("plane", &m_plane, "plane/I");
-    m_pReco2D->Branch("wire", &m_wire, "wire/I");
-    m_pReco2D->Branch("x", &m_x, "x/D");
-    m_pReco2D->Branch("w", &m_w, "w/D");
-    m_pReco2D->Branch("q", &m_q, "q/D");
+    this->AddBranch(m_pReco2D, m_reco2DColumns, "particle", &m_particle);
+    this->AddBranch(m_pReco2D, m_reco2DColumns, "pdgcode", &m_pdgcode);
+    this->AddBranch(m_pReco2D, m_reco2DColumns, "cstat", &m_cstat);
+    this->AddBranch(m_pReco2D, m_reco2DColumns, "tpc", &m_tpc);
+    this->AddBranch(m_pReco2D, m_reco2DColumns, "plane", &m_plane);
+    this->AddBranch(m_pReco2D, m_reco2DColumns, "wire", &m_wire);
+    this->AddBranch(m_pReco2D, m_reco2DColumns, "x", &m_x);
+    this->AddBranch(m_pReco2D, m_reco2DColumns, "w", &m_w);
+    this->AddBranch(m_pReco2D, m_reco2DColumns, "q", &m_q);
 
     m_pRecoComparison = tfs->make<TTree>("pandora2Dcomparison", "LAr Reco 2D (comparison)");
     m_pRecoComparison->Branch("run", &m_run, "run/I");
     m_pRecoComparison->Branch("event", &m_event, "event/I");
-    m_pRecoComparison->Branch("particle", &m_particle, "particle/I");
-    m_pRecoComparison->Branch("pdgcode", &m_pdgcode, "pdgcode/I");
-    m_pRecoComparison->Branch(
-      "hitsFromSpacePoints", &m_hitsFromSpacePoints, "hitsFromSpacePoints/I");
-    m_pRecoComparison->Branch("hitsFromClusters", &m_hitsFromClusters, "hitsFromClusters/I");
-    m_pRecoComparison->Branch(
-      "hitsFromTrackOrShower", &m_hitsFromTrackOrShower, "hitsFromTrackOrShower/I");
+    this->AddBranch(m_pRecoComparison, m_recoComparisonColumns, "particle", &m_particle);
+    this->AddBranch(m_pRecoComparison, m_recoComparisonColumns, "pdgcode", &m_pdgcode);
+    this->AddBranch(
+      m_pRecoComparison, m_recoComparisonColumns, "hitsFromSpacePoints", &m_hitsFromSpacePoints);
+    this->AddBranch(
+      m_pRecoComparison, m_recoComparisonColumns, "hitsFromClusters", &m_hitsFromClusters);
+    this->AddBranch(
+      m_pRecoComparison, m_recoComparisonColumns, "hitsFromTrackOrShower", &m_hitsFromTrackOrShower);
 
     m_pRecoWire = tfs->make<TTree>("rawdata", "LAr Reco Wires");
     m_pRecoWire->Branch("run", &m_run, "run/I");
     m_pRecoWire->Branch("event", &m_event, "event/I");
-    m_pRecoWire->Branch("cstat", &m_cstat, "cstat/I");
-    m_pRecoWire->Branch("tpc", &m_tpc, "tpc/I");
-    m_pRecoWire->Branch("plane", &m_plane, "plane/I");
-    m_pRecoWire->Branch("wire", &m_wire, "wire/I");
-    m_pRecoWire->Branch("x", &m_x, "x/D");
-    m_pRecoWire->Branch("w", &m_w, "w/D");
-    m_pRecoWire->Branch("q", &m_q, "q/D");
+    this->AddBranch(m_pRecoWire, m_recoWireColumns, "cstat", &m_cstat);
+    this->AddBranch(m_pRecoWire, m_recoWireColumns, "tpc", &m_tpc);
+    this->AddBranch(m_pRecoWire, m_recoWireColumns, "plane", &m_plane);
+    this->AddBranch(m_pRecoWire, m_recoWireColumns, "wire", &m_wire);
+    this->AddBranch(m_pRecoWire, m_recoWireColumns, "x", &m_x);
+    this->AddBranch(m_pRecoWire, m_recoWireColumns, "w", &m_w);
+    this->AddBranch(m_pRecoWire, m_recoWireColumns, "q", &m_q);
+
+    for (TTree* pTree : {m_pRecoTracks, m_pReco3D, m_pReco2D, m_pRecoComparison, m_pRecoWire})
+      this->ConfigureTree(pTree);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleHitDumper::endJob()
+  PFParticleHitDumper::endJob(art::ProcessingFrame const&)
   {}
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleHitDumper::analyze(const art::Event& evt)
+  PFParticleHitDumper::analyze(const art::Event& evt, art::ProcessingFrame const&)
   {
-    if (m_printDebug) std::cout << " *** PFParticleHitDumper::analyze(...) *** " << std::endl;
-
-    m_run = evt.run();
-    m_event = evt.id().event();
-
-    m_particle = -1;
-    m_primary = 0;
-    m_pdgcode = 0;
-
-    m_cstat = 0;
-    m_tpc = 0;
-    m_plane = 0;
-    m_wire = 0;
-
-    m_x = 0.0;
-    m_y = 0.0;
-    m_u = 0.0;
-    m_v = 0.0;
-    m_z = 0.0;
-    m_w = 0.0;
-    m_q = 0.0;
-
-    if (m_printDebug) {
-      std::cout << "  Run: " << m_run << std::endl;
-      std::cout << "  Event: " << m_event << std::endl;
-    }
-
-    // Need geometry service to convert channel to wire ID
-    art::ServiceHandle<geo::Geometry const> theGeometry;
-
     // Get particles, tracks, space points, hits (and wires)
     // ====================================================
     TrackVector trackVector, trackVectorExtra;
@@ -380,6 +474,40 @@ namespace lar_pandora {
 
     if (m_storeWires) LArPandoraHelper::CollectWires(evt, m_calwireLabel, wireVector);
 
+    // Need geometry service to convert channel to wire ID, and detector properties to convert
+    // from ticks to X; set up once per event, before any tree is filled
+    const geo::GeometryCore& theGeometry(*art::ServiceHandle<geo::Geometry const>());
+    auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt);
+    auto const detProp =
+      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData);
+
+    if (m_printDebug) std::cout << " *** PFParticleHitDumper::analyze(...) *** " << std::endl;
+
+    m_run = evt.run();
+    m_event = evt.id().event();
+
+    m_particle = -1;
+    m_primary = 0;
+    m_pdgcode = 0;
+
+    m_cstat = 0;
+    m_tpc = 0;
+    m_plane = 0;
+    m_wire = 0;
+
+    m_x = 0.0;
+    m_y = 0.0;
+    m_u = 0.0;
+    m_v = 0.0;
+    m_z = 0.0;
+    m_w = 0.0;
+    m_q = 0.0;
+
+    if (m_printDebug) {
+      std::cout << "  Run: " << m_run << std::endl;
+      std::cout << "  Event: " << m_event << std::endl;
+    }
+
     if (m_printDebug) std::cout << "  PFParticles: " << particleVector.size() << std::endl;
 
     // Loop over Tracks (Fill 3D Track Tree)
@@ -395,7 +523,7 @@ namespace lar_pandora {
     // Loop over Hits (Fill 2D Reco Tree)
     // ==================================
     if (m_printDebug) std::cout << "   PFParticleHitDumper::FillReco2D(...) " << std::endl;
-    this->FillReco2D(evt, hitVector, hitsToParticles);
+    this->FillReco2D(detProp, hitVector, hitsToParticles);
 
     // Loop over Hits (Fill Associated 2D Hits Tree)
     // =============================================
@@ -413,7 +541,17 @@ namespace lar_pandora {
     // Loop over Wires (Fill Reco Wire Tree)
     // =====================================
     if (m_printDebug) std::cout << "   PFParticleHitDumper::FillRecoWires(...) " << std::endl;
-    this->FillRecoWires(evt, wireVector);
+    this->FillRecoWires(theGeometry, detProp, wireVector);
+
+    // Write one entry per tree for this event (columnar mode only)
+    // ============================================================
+    if (m_columnarOutput) {
+      this->FillColumns(m_pRecoTracks, m_recoTracksColumns);
+      this->FillColumns(m_pReco3D, m_reco3DColumns);
+      this->FillColumns(m_pReco2D, m_reco2DColumns);
+      this->FillColumns(m_pRecoComparison, m_recoComparisonColumns);
+      this->FillColumns(m_pRecoWire, m_recoWireColumns);
+    }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -427,8 +565,8 @@ namespace lar_pandora {
     m_y = 0.0;
     m_z = 0.0;
 
-    // Create dummy entry if there are no particles
-    if (particlesToTracks.empty()) { m_pRecoTracks->Fill(); }
+    // Create dummy entry if there are no particles (an empty event entry suffices in columnar mode)
+    if (particlesToTracks.empty() && !m_columnarOutput) { m_pRecoTracks->Fill(); }
 
     // Loop over tracks
     for (PFParticlesToTracks::const_iterator iter = particlesToTracks.begin(),
@@ -456,7 +594,7 @@ namespace lar_pandora {
           m_y = position.y();
           m_z = position.z();
 
-          m_pRecoTracks->Fill();
+          this->FillRow(m_pRecoTracks, m_recoTracksColumns);
         }
       }
     }
@@ -482,8 +620,8 @@ namespace lar_pandora {
     m_y = 0.0;
     m_z = 0.0;
 
-    // Create dummy entry if there are no particles
-    if (particleVector.empty()) { m_pReco3D->Fill(); }
+    // Create dummy entry if there are no particles (an empty event entry suffices in columnar mode)
+    if (particleVector.empty() && !m_columnarOutput) { m_pReco3D->Fill(); }
 
     // Store associations between particle and particle ID
     PFParticleMap theParticleMap;
@@ -493,6 +631,12 @@ namespace lar_pandora {
       theParticleMap[particle->Self()] = particle;
     }
 
+    size_t nSpacePoints(0);
+    for (const auto& entry : particlesToSpacePoints)
+      nSpacePoints += entry.second.size();
+
+    m_reco3DColumns.Reserve(nSpacePoints);
+
     // Loop over particles
     for (PFParticlesToSpacePoints::const_iterator iter1 = particlesToSpacePoints.begin(),
                                                   iterEnd1 = particlesToSpacePoints.end();
@@ -543,7 +687,7 @@ namespace lar_pandora {
         m_u = this->YZtoU(m_cstat, m_tpc, m_y, m_z);
         m_v = this->YZtoV(m_cstat, m_tpc, m_y, m_z);
 
-        m_pReco3D->Fill();
+        this->FillRow(m_pReco3D, m_reco3DColumns);
       }
     }
   }
@@ -560,8 +704,10 @@ namespace lar_pandora {
                                             const PFParticlesToShowers& particlesToShowers,
                                             const ShowersToHits& showersToHits)
   {
-    // Create dummy entry if there are no 2D hits
-    if (particleVector.empty()) { m_pRecoComparison->Fill(); }
+    // Create dummy entry if there are no 2D hits (an empty event entry suffices in columnar mode)
+    if (particleVector.empty() && !m_columnarOutput) { m_pRecoComparison->Fill(); }
+
+    m_recoComparisonColumns.Reserve(particleVector.size());
 
     for (unsigned int i = 0; i < particleVector.size(); ++i) {
       //initialise variables
@@ -607,14 +753,14 @@ namespace lar_pandora {
                   << " hits from clusters, and its recob::Track/Shower has "
                   << m_hitsFromTrackOrShower << " associated hits " << std::endl;
 
-      m_pRecoComparison->Fill();
+      this->FillRow(m_pRecoComparison, m_recoComparisonColumns);
     }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleHitDumper::FillReco2D(const art::Event& e,
+  PFParticleHitDumper::FillReco2D(const detinfo::DetectorPropertiesData& detProp,
                                   const HitVector& hitVector,
                                   const HitsToPFParticles& hitsToParticles)
   {
@@ -629,11 +775,10 @@ namespace lar_pandora {
     m_w = 0.0;
     m_q = 0.0;
 
-    // Create dummy entry if there are no 2D hits
-    if (hitVector.empty()) { m_pReco2D->Fill(); }
+    // Create dummy entry if there are no 2D hits (an empty event entry suffices in columnar mode)
+    if (hitVector.empty() && !m_columnarOutput) { m_pReco2D->Fill(); }
 
-    // Need DetectorProperties service to convert from ticks to X
-    auto const detProp = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e);
+    m_reco2DColumns.Reserve(hitVector.size());
 
     // Loop over 2D hits
     for (unsigned int i = 0; i < hitVector.size(); ++i) {
@@ -659,24 +804,20 @@ namespace lar_pandora {
       m_x = detProp.ConvertTicksToX(hit->PeakTime(), wireID.Plane, wireID.TPC, wireID.Cryostat);
       m_w = this->GetUVW(wireID);
 
-      m_pReco2D->Fill();
+      this->FillRow(m_pReco2D, m_reco2DColumns);
     }
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleHitDumper::FillRecoWires(const art::Event& e, const WireVector& wireVector)
+  PFParticleHitDumper::FillRecoWires(const geo::GeometryCore& theGeometry,
+                                     const detinfo::DetectorPropertiesData& detProp,
+                                     const WireVector& wireVector)
   {
 
-    // Create dummy entry if there are no wires
-    if (wireVector.empty()) { m_pRecoWire->Fill(); }
-
-    // Need geometry service to convert channel to wire ID
-    art::ServiceHandle<geo::Geometry const> theGeometry;
-
-    // Need DetectorProperties service to convert from ticks to X
-    auto const detProp = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e);
+    // Create dummy entry if there are no wires (an empty event entry suffices in columnar mode)
+    if (wireVector.empty() && !m_columnarOutput) { m_pRecoWire->Fill(); }
 
     // Loop over wires
     int signalCounter(0);
@@ -685,7 +826,7 @@ namespace lar_pandora {
       const art::Ptr<recob::Wire> wire = wireVector.at(i);
 
       const std::vector<float>& signals(wire->Signal());
-      const std::vector<geo::WireID> wireIds = theGeometry->ChannelToWire(wire->Channel());
+      const std::vector<geo::WireID> wireIds = theGeometry.ChannelToWire(wire->Channel());
 
       if ((signalCounter++) < 10 && m_printDebug)
         std::cout << "    numWires=" << wireVector.size() << " numSignals=" << signals.size()
@@ -717,7 +858,7 @@ namespace lar_pandora {
           m_x = detProp.ConvertTicksToX(time, wireID.Plane, wireID.TPC, wireID.Cryostat);
           m_w = this->GetUVW(wireID);
 
-          m_pRecoWire->Fill();
+          this->FillRow(m_pRecoWire, m_recoWireColumns);
         }
       }
     }
@@ -790,4 +931,125 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  PFParticleHitDumper::AddBranch(TTree* pTree,
+                                 ColumnSet& columns,
+                                 const std::string& name,
+                                 int* pValue)
+  {
+    if (m_columnarOutput)
+      columns.AddColumn(pTree, name, pValue);
+    else
+      pTree->Branch(name.c_str(), pValue, (name + "/I").c_str());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleHitDumper::AddBranch(TTree* pTree,
+                                 ColumnSet& columns,
+                                 const std::string& name,
+                                 double* pValue)
+  {
+    if (m_columnarOutput)
+      columns.AddColumn(pTree, name, pValue);
+    else
+      pTree->Branch(name.c_str(), pValue, (name + "/D").c_str());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleHitDumper::FillRow(TTree* pTree, ColumnSet& columns)
+  {
+    if (m_columnarOutput)
+      columns.AppendRow();
+    else
+      pTree->Fill();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleHitDumper::FillColumns(TTree* pTree, ColumnSet& columns)
+  {
+    pTree->Fill();
+    columns.Clear();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleHitDumper::ConfigureTree(TTree* pTree) const
+  {
+    if (m_basketSize > 0) pTree->SetBasketSize("*", m_basketSize);
+
+    if (m_compressionSettings >= 0) {
+      TObjArray* pBranches(pTree->GetListOfBranches());
+
+      for (int i = 0; i < pBranches->GetEntriesFast(); ++i)
+        static_cast<TBranch*>(pBranches->At(i))->SetCompressionSettings(m_compressionSettings);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleHitDumper::ColumnSet::AddColumn(TTree* pTree,
+                                            const std::string& name,
+                                            const int* pValue)
+  {
+    m_intColumns.emplace_back(pValue, std::vector<int>());
+    pTree->Branch(name.c_str(), &m_intColumns.back().second);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleHitDumper::ColumnSet::AddColumn(TTree* pTree,
+                                            const std::string& name,
+                                            const double* pValue)
+  {
+    m_doubleColumns.emplace_back(pValue, std::vector<double>());
+    pTree->Branch(name.c_str(), &m_doubleColumns.back().second);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleHitDumper::ColumnSet::Reserve(const size_t nRows)
+  {
+    for (Column<int>& column : m_intColumns)
+      column.second.reserve(nRows);
+
+    for (Column<double>& column : m_doubleColumns)
+      column.second.reserve(nRows);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleHitDumper::ColumnSet::AppendRow()
+  {
+    for (Column<int>& column : m_intColumns)
+      column.second.push_back(*column.first);
+
+    for (Column<double>& column : m_doubleColumns)
+      column.second.push_back(*column.first);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  PFParticleHitDumper::ColumnSet::Clear()
+  {
+    for (Column<int>& column : m_intColumns)
+      column.second.clear();
+
+    for (Column<double>& column : m_doubleColumns)
+      column.second.clear();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
 } //namespace lar_pandora
@@ -5,14 +5,16 @@
  *
  */
 
-#include "art/Framework/Core/EDAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 
 #include "TTree.h"
 
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h"
 
 #include <string>
+#include <unordered_map>
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -21,23 +23,24 @@ namespace lar_pandora {
   /**
  *  @brief  PFParticleMonitoring class
  */
-  class PFParticleMonitoring : public art::EDAnalyzer {
+  class PFParticleMonitoring : public art::SharedAnalyzer {
   public:
     /**
      *  @brief  Constructor
      *
      *  @param  pset
+     *  @param  frame
      */
-    PFParticleMonitoring(fhicl::ParameterSet const& pset);
+    PFParticleMonitoring(fhicl::ParameterSet const& pset, art::ProcessingFrame const& frame);
 
     /**
      *  @brief  Destructor
      */
     virtual ~PFParticleMonitoring();
 
-    void beginJob();
-    void endJob();
-    void analyze(const art::Event& evt);
+    void beginJob(art::ProcessingFrame const& frame) override;
+    void endJob(art::ProcessingFrame const& frame) override;
+    void analyze(const art::Event& evt, art::ProcessingFrame const& frame) override;
     void reconfigure(fhicl::ParameterSet const& pset);
 
   private:
@@ -45,6 +48,24 @@ namespace lar_pandora {
     typedef std::set<art::Ptr<simb::MCParticle>> MCParticleSet;
     typedef std::set<art::Ptr<simb::MCTruth>> MCTruthSet;
 
+    typedef std::unordered_map<art::Ptr<recob::Hit>, art::Ptr<recob::PFParticle>>
+      HitsToPFParticlesIndex;
+    typedef std::unordered_map<art::Ptr<recob::Hit>, art::Ptr<simb::MCParticle>>
+      HitsToMCParticlesIndex;
+    typedef std::unordered_map<art::Ptr<recob::Hit>, art::Ptr<simb::MCTruth>> HitsToMCTruthIndex;
+    typedef std::unordered_map<art::Ptr<recob::Hit>, art::Ptr<recob::SpacePoint>>
+      HitsToSpacePointsIndex;
+
+    /**
+     *  @brief  Build a hash index from an ordered mapping of hits to objects
+     *
+     *  @param  hitMap the input ordered mapping from hits to objects
+     *  @param  hitIndex the output hash index from hits to objects
+     */
+    template <typename T>
+    static void BuildHitIndex(const std::map<art::Ptr<recob::Hit>, art::Ptr<T>>& hitMap,
+                              std::unordered_map<art::Ptr<recob::Hit>, art::Ptr<T>>& hitIndex);
+
     /**
      *  @brief  Build mapping from true neutrinos to hits
      *
@@ -56,20 +77,20 @@ namespace lar_pandora {
     void BuildTrueNeutrinoHitMaps(const MCTruthToMCParticles& truthToParticles,
                                   const MCParticlesToHits& trueParticlesToHits,
                                   MCTruthToHits& trueNeutrinosToHits,
-                                  HitsToMCTruth& trueHitsToNeutrinos) const;
+                                  HitsToMCTruthIndex& trueHitsToNeutrinos) const;
 
     /**
      *  @brief  Build mapping from reconstructed neutrinos to hits
      *
-     *  @param recoParticleMap  the input mapping from reconstructed particle and particle ID
+     *  @param recoParticleHierarchy  the input hierarchy of reconstructed particles
      *  @param recoParticlesToHits  the input mapping from reconstructed particles to hits
      *  @param recoNeutrinosToHits  the output mapping from reconstructed particles to hits
      *  @param recoHitsToNeutrinos  the output mapping from reconstructed hits to particles
      */
-    void BuildRecoNeutrinoHitMaps(const PFParticleMap& recoParticleMap,
+    void BuildRecoNeutrinoHitMaps(const PFParticleHierarchy& recoParticleHierarchy,
                                   const PFParticlesToHits& recoParticlesToHits,
                                   PFParticlesToHits& recoNeutrinosToHits,
-                                  HitsToPFParticles& recoHitsToNeutrinos) const;
+                                  HitsToPFParticlesIndex& recoHitsToNeutrinos) const;
 
     /**
      *  @brief Perform matching between true and reconstructed neutrino events
@@ -80,7 +101,7 @@ namespace lar_pandora {
      *  @param matchedNeutrinoHits  the output matches between reconstructed neutrinos and hits
      */
     void GetRecoToTrueMatches(const PFParticlesToHits& recoNeutrinosToHits,
-                              const HitsToMCTruth& trueHitsToNeutrinos,
+                              const HitsToMCTruthIndex& trueHitsToNeutrinos,
                               MCTruthToPFParticles& matchedNeutrinos,
                               MCTruthToHits& matchedNeutrinoHits) const;
 
@@ -95,7 +116,7 @@ namespace lar_pandora {
      *  @param trueVeto  the veto list for true particles
      */
     void GetRecoToTrueMatches(const PFParticlesToHits& recoNeutrinosToHits,
-                              const HitsToMCTruth& trueHitsToNeutrinos,
+                              const HitsToMCTruthIndex& trueHitsToNeutrinos,
                               MCTruthToPFParticles& matchedNeutrinos,
                               MCTruthToHits& matchedNeutrinoHits,
                               PFParticleSet& recoVeto,
@@ -110,7 +131,7 @@ namespace lar_pandora {
      *  @param matchedHits the output matches between reconstructed particles and hits
      */
     void GetRecoToTrueMatches(const PFParticlesToHits& recoParticlesToHits,
-                              const HitsToMCParticles& trueHitsToParticles,
+                              const HitsToMCParticlesIndex& trueHitsToParticles,
                               MCParticlesToPFParticles& matchedParticles,
                               MCParticlesToHits& matchedHits) const;
 
@@ -125,7 +146,7 @@ namespace lar_pandora {
      *  @param trueVeto the veto list for true particles
      */
     void GetRecoToTrueMatches(const PFParticlesToHits& recoParticlesToHits,
-                              const HitsToMCParticles& trueHitsToParticles,
+                              const HitsToMCParticlesIndex& trueHitsToParticles,
                               MCParticlesToPFParticles& matchedParticles,
                               MCParticlesToHits& matchedHits,
                               PFParticleSet& recoVeto,
@@ -161,6 +182,7 @@ namespace lar_pandora {
                      const int startT,
                      const int endT) const;
 
+
     TTree* m_pRecoTree; ///<
 
     int m_run;   ///<
@@ -297,10 +319,12 @@ namespace lar_pandora {
 
 namespace lar_pandora {
 
-  PFParticleMonitoring::PFParticleMonitoring(fhicl::ParameterSet const& pset)
-    : art::EDAnalyzer(pset)
+  PFParticleMonitoring::PFParticleMonitoring(fhicl::ParameterSet const& pset,
+                                             art::ProcessingFrame const&)
+    : art::SharedAnalyzer(pset)
   {
     this->reconfigure(pset);
+    serialize(art::SharedResource<art::TFileService>);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -331,7 +355,7 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleMonitoring::beginJob()
+  PFParticleMonitoring::beginJob(art::ProcessingFrame const&)
   {
     mf::LogDebug("LArPandora") << " *** PFParticleMonitoring::beginJob() *** " << std::endl;
 
@@ -410,96 +434,14 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleMonitoring::endJob()
+  PFParticleMonitoring::endJob(art::ProcessingFrame const&)
   {}
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleMonitoring::analyze(const art::Event& evt)
+  PFParticleMonitoring::analyze(const art::Event& evt, art::ProcessingFrame const&)
   {
-    if (m_printDebug) std::cout << " *** PFParticleMonitoring::analyze(...) *** " << std::endl;
-
-    m_run = evt.run();
-    m_event = evt.id().event();
-    m_index = 0;
-
-    m_nMCParticles = 0;
-    m_nNeutrinoPfos = 0;
-    m_nPrimaryPfos = 0;
-    m_nDaughterPfos = 0;
-
-    m_mcPdg = 0;
-    m_mcNuPdg = 0;
-    m_mcParentPdg = 0;
-    m_mcPrimaryPdg = 0;
-    m_mcIsNeutrino = 0;
-    m_mcIsPrimary = 0;
-    m_mcIsDecay = 0;
-    m_mcIsCC = 0;
-
-    m_pfoPdg = 0;
-    m_pfoNuPdg = 0;
-    m_pfoParentPdg = 0;
-    m_pfoPrimaryPdg = 0;
-    m_pfoIsNeutrino = 0;
-    m_pfoIsPrimary = 0;
-    m_pfoIsStitched = 0;
-    m_pfoTrack = 0;
-    m_pfoVertex = 0;
-    m_pfoVtxX = 0.0;
-    m_pfoVtxY = 0.0;
-    m_pfoVtxZ = 0.0;
-    m_pfoEndX = 0.0;
-    m_pfoEndY = 0.0;
-    m_pfoEndZ = 0.0;
-    m_pfoDirX = 0.0;
-    m_pfoDirY = 0.0;
-    m_pfoDirZ = 0.0;
-    m_pfoLength = 0.0;
-    m_pfoStraightLength = 0.0;
-
-    m_mcVertex = 0;
-    m_mcVtxX = 0.0;
-    m_mcVtxY = 0.0;
-    m_mcVtxZ = 0.0;
-    m_mcEndX = 0.0;
-    m_mcEndY = 0.0;
-    m_mcEndZ = 0.0;
-    m_mcDirX = 0.0;
-    m_mcDirY = 0.0;
-    m_mcDirZ = 0.0;
-    m_mcEnergy = 0.0;
-    m_mcLength = 0.0;
-    m_mcStraightLength = 0.0;
-
-    m_completeness = 0.0;
-    m_purity = 0.0;
-
-    m_nMCHits = 0;
-    m_nPfoHits = 0;
-    m_nMatchedHits = 0;
-    m_nMCHitsU = 0;
-    m_nMCHitsV = 0;
-    m_nMCHitsW = 0;
-    m_nPfoHitsU = 0;
-    m_nPfoHitsV = 0;
-    m_nPfoHitsW = 0;
-    m_nMatchedHitsU = 0;
-    m_nMatchedHitsV = 0;
-    m_nMatchedHitsW = 0;
-
-    m_nTrueWithoutRecoHits = 0;
-    m_nRecoWithoutTrueHits = 0;
-
-    m_spacepointsMinX = 0.0;
-    m_spacepointsMaxX = 0.0;
-
-    if (m_printDebug) {
-      std::cout << "  Run: " << m_run << std::endl;
-      std::cout << "  Event: " << m_event << std::endl;
-    }
-
     // Collect Hits
     // ============
     HitVector hitVector;
@@ -611,18 +553,132 @@ namespace lar_pandora {
       std::cout << "  MatchedParticles: " << trueParticlesToHits.size() << std::endl;
     }
 
-    if (trueParticlesToHits.empty()) {
-      m_pRecoTree->Fill();
-      return;
-    }
-
     // Build Reco and True Particle Maps (for Parent/Daughter Navigation)
     // =================================================================
     MCParticleMap trueParticleMap;
-    PFParticleMap recoParticleMap;
-
     LArPandoraHelper::BuildMCParticleMap(trueParticleVector, trueParticleMap);
-    LArPandoraHelper::BuildPFParticleMap(recoParticleVector, recoParticleMap);
+
+    const PFParticleHierarchy recoParticleHierarchy(recoParticleVector);
+
+    // Build hash indices of the Hit Maps (for per-hit lookups)
+    // ========================================================
+    HitsToPFParticlesIndex recoHitsToParticlesIndex;
+    HitsToMCParticlesIndex trueHitsToParticlesIndex;
+    HitsToSpacePointsIndex hitsToSpacePointsIndex;
+
+    PFParticleMonitoring::BuildHitIndex(recoHitsToParticles, recoHitsToParticlesIndex);
+    PFParticleMonitoring::BuildHitIndex(trueHitsToParticles, trueHitsToParticlesIndex);
+    PFParticleMonitoring::BuildHitIndex(hitsToSpacePoints, hitsToSpacePointsIndex);
+
+    // Match Reco Neutrinos to True Neutrinos
+    // ======================================
+    PFParticlesToHits recoNeutrinosToHits;
+    HitsToPFParticlesIndex recoHitsToNeutrinos;
+    HitsToMCTruthIndex trueHitsToNeutrinos;
+    MCTruthToHits trueNeutrinosToHits;
+    this->BuildRecoNeutrinoHitMaps(
+      recoParticleHierarchy, recoParticlesToHits, recoNeutrinosToHits, recoHitsToNeutrinos);
+    this->BuildTrueNeutrinoHitMaps(
+      truthToParticles, trueParticlesToHits, trueNeutrinosToHits, trueHitsToNeutrinos);
+
+    MCTruthToPFParticles matchedNeutrinos;
+    MCTruthToHits matchedNeutrinoHits;
+    this->GetRecoToTrueMatches(
+      recoNeutrinosToHits, trueHitsToNeutrinos, matchedNeutrinos, matchedNeutrinoHits);
+
+    // Match Reco Particles to True Particles
+    // ======================================
+    MCParticlesToPFParticles matchedParticles;
+    MCParticlesToHits matchedParticleHits;
+    this->GetRecoToTrueMatches(
+      recoParticlesToHits, trueHitsToParticlesIndex, matchedParticles, matchedParticleHits);
+
+    if (m_printDebug) std::cout << " *** PFParticleMonitoring::analyze(...) *** " << std::endl;
+
+    m_run = evt.run();
+    m_event = evt.id().event();
+    m_index = 0;
+
+    m_nMCParticles = 0;
+    m_nNeutrinoPfos = 0;
+    m_nPrimaryPfos = 0;
+    m_nDaughterPfos = 0;
+
+    m_mcPdg = 0;
+    m_mcNuPdg = 0;
+    m_mcParentPdg = 0;
+    m_mcPrimaryPdg = 0;
+    m_mcIsNeutrino = 0;
+    m_mcIsPrimary = 0;
+    m_mcIsDecay = 0;
+    m_mcIsCC = 0;
+
+    m_pfoPdg = 0;
+    m_pfoNuPdg = 0;
+    m_pfoParentPdg = 0;
+    m_pfoPrimaryPdg = 0;
+    m_pfoIsNeutrino = 0;
+    m_pfoIsPrimary = 0;
+    m_pfoIsStitched = 0;
+    m_pfoTrack = 0;
+    m_pfoVertex = 0;
+    m_pfoVtxX = 0.0;
+    m_pfoVtxY = 0.0;
+    m_pfoVtxZ = 0.0;
+    m_pfoEndX = 0.0;
+    m_pfoEndY = 0.0;
+    m_pfoEndZ = 0.0;
+    m_pfoDirX = 0.0;
+    m_pfoDirY = 0.0;
+    m_pfoDirZ = 0.0;
+    m_pfoLength = 0.0;
+    m_pfoStraightLength = 0.0;
+
+    m_mcVertex = 0;
+    m_mcVtxX = 0.0;
+    m_mcVtxY = 0.0;
+    m_mcVtxZ = 0.0;
+    m_mcEndX = 0.0;
+    m_mcEndY = 0.0;
+    m_mcEndZ = 0.0;
+    m_mcDirX = 0.0;
+    m_mcDirY = 0.0;
+    m_mcDirZ = 0.0;
+    m_mcEnergy = 0.0;
+    m_mcLength = 0.0;
+    m_mcStraightLength = 0.0;
+
+    m_completeness = 0.0;
+    m_purity = 0.0;
+
+    m_nMCHits = 0;
+    m_nPfoHits = 0;
+    m_nMatchedHits = 0;
+    m_nMCHitsU = 0;
+    m_nMCHitsV = 0;
+    m_nMCHitsW = 0;
+    m_nPfoHitsU = 0;
+    m_nPfoHitsV = 0;
+    m_nPfoHitsW = 0;
+    m_nMatchedHitsU = 0;
+    m_nMatchedHitsV = 0;
+    m_nMatchedHitsW = 0;
+
+    m_nTrueWithoutRecoHits = 0;
+    m_nRecoWithoutTrueHits = 0;
+
+    m_spacepointsMinX = 0.0;
+    m_spacepointsMaxX = 0.0;
+
+    if (m_printDebug) {
+      std::cout << "  Run: " << m_run << std::endl;
+      std::cout << "  Event: " << m_event << std::endl;
+    }
+
+    if (trueParticlesToHits.empty()) {
+      m_pRecoTree->Fill();
+      return;
+    }
 
     m_nMCParticles = trueParticlesToHits.size();
     m_nNeutrinoPfos = 0;
@@ -637,7 +693,7 @@ namespace lar_pandora {
       const art::Ptr<recob::PFParticle> recoParticle = *iter;
 
       if (LArPandoraHelper::IsNeutrino(recoParticle)) { m_nNeutrinoPfos++; }
-      else if (LArPandoraHelper::IsFinalState(recoParticleMap, recoParticle)) {
+      else if (LArPandoraHelper::IsFinalState(recoParticleHierarchy, recoParticle)) {
         m_nPrimaryPfos++;
       }
       else {
@@ -645,22 +701,7 @@ namespace lar_pandora {
       }
     }
 
-    // Match Reco Neutrinos to True Neutrinos
-    // ======================================
-    PFParticlesToHits recoNeutrinosToHits;
-    HitsToPFParticles recoHitsToNeutrinos;
-    HitsToMCTruth trueHitsToNeutrinos;
-    MCTruthToHits trueNeutrinosToHits;
-    this->BuildRecoNeutrinoHitMaps(
-      recoParticleMap, recoParticlesToHits, recoNeutrinosToHits, recoHitsToNeutrinos);
-    this->BuildTrueNeutrinoHitMaps(
-      truthToParticles, trueParticlesToHits, trueNeutrinosToHits, trueHitsToNeutrinos);
-
-    MCTruthToPFParticles matchedNeutrinos;
-    MCTruthToHits matchedNeutrinoHits;
-    this->GetRecoToTrueMatches(
-      recoNeutrinosToHits, trueHitsToNeutrinos, matchedNeutrinos, matchedNeutrinoHits);
-
+    // Compare true and reconstructed neutrinos
     for (MCTruthToHits::const_iterator iter = trueNeutrinosToHits.begin(),
                                        iterEnd = trueNeutrinosToHits.end();
          iter != iterEnd;
@@ -832,13 +873,6 @@ namespace lar_pandora {
       ++m_index; // Increment index number
     }
 
-    // Match Reco Particles to True Particles
-    // ======================================
-    MCParticlesToPFParticles matchedParticles;
-    MCParticlesToHits matchedParticleHits;
-    this->GetRecoToTrueMatches(
-      recoParticlesToHits, trueHitsToParticles, matchedParticles, matchedParticleHits);
-
     // Compare true and reconstructed particles
     for (MCParticlesToHits::const_iterator iter = trueParticlesToHits.begin(),
                                            iterEnd = trueParticlesToHits.end();
@@ -989,8 +1023,8 @@ namespace lar_pandora {
            ++hIter1) {
         const art::Ptr<recob::Hit> hit = *hIter1;
 
-        HitsToSpacePoints::const_iterator hIter2 = hitsToSpacePoints.find(hit);
-        if (hitsToSpacePoints.end() == hIter2) continue;
+        HitsToSpacePointsIndex::const_iterator hIter2 = hitsToSpacePointsIndex.find(hit);
+        if (hitsToSpacePointsIndex.end() == hIter2) continue;
 
         const art::Ptr<recob::SpacePoint> spacepoint = hIter2->second;
         const double X(spacepoint->XYZ()[0]);
@@ -1011,7 +1045,7 @@ namespace lar_pandora {
                                      hIterEnd1 = trueHitVector.end();
            hIter1 != hIterEnd1;
            ++hIter1) {
-        if (recoHitsToParticles.find(*hIter1) == recoHitsToParticles.end())
+        if (recoHitsToParticlesIndex.find(*hIter1) == recoHitsToParticlesIndex.end())
           ++m_nTrueWithoutRecoHits;
       }
 
@@ -1025,15 +1059,15 @@ namespace lar_pandora {
       if (matchedParticles.end() != pIter1) {
         const art::Ptr<recob::PFParticle> recoParticle = pIter1->second;
         m_pfoPdg = recoParticle->PdgCode();
-        m_pfoNuPdg = LArPandoraHelper::GetParentNeutrino(recoParticleMap, recoParticle);
-        m_pfoIsPrimary = LArPandoraHelper::IsFinalState(recoParticleMap, recoParticle);
+        m_pfoNuPdg = LArPandoraHelper::GetParentNeutrino(recoParticleHierarchy, recoParticle);
+        m_pfoIsPrimary = LArPandoraHelper::IsFinalState(recoParticleHierarchy, recoParticle);
 
         const art::Ptr<recob::PFParticle> parentParticle =
-          LArPandoraHelper::GetParentPFParticle(recoParticleMap, recoParticle);
+          LArPandoraHelper::GetParentPFParticle(recoParticleHierarchy, recoParticle);
         m_pfoParentPdg = parentParticle->PdgCode();
 
         const art::Ptr<recob::PFParticle> primaryParticle =
-          LArPandoraHelper::GetFinalStatePFParticle(recoParticleMap, recoParticle);
+          LArPandoraHelper::GetFinalStatePFParticle(recoParticleHierarchy, recoParticle);
         m_pfoPrimaryPdg = primaryParticle->PdgCode();
 
         PFParticlesToHits::const_iterator pIter2 = recoParticlesToHits.find(recoParticle);
@@ -1047,7 +1081,7 @@ namespace lar_pandora {
                                        hIterEnd2 = recoHitVector.end();
              hIter2 != hIterEnd2;
              ++hIter2) {
-          if (trueHitsToParticles.find(*hIter2) == trueHitsToParticles.end())
+          if (trueHitsToParticlesIndex.find(*hIter2) == trueHitsToParticlesIndex.end())
             ++m_nRecoWithoutTrueHits;
         }
 
@@ -1144,7 +1178,7 @@ namespace lar_pandora {
   PFParticleMonitoring::BuildTrueNeutrinoHitMaps(const MCTruthToMCParticles& truthToParticles,
                                                  const MCParticlesToHits& trueParticlesToHits,
                                                  MCTruthToHits& trueNeutrinosToHits,
-                                                 HitsToMCTruth& trueHitsToNeutrinos) const
+                                                 HitsToMCTruthIndex& trueHitsToNeutrinos) const
   {
     for (MCTruthToMCParticles::const_iterator iter1 = truthToParticles.begin(),
                                               iterEnd1 = truthToParticles.end();
@@ -1176,18 +1210,19 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleMonitoring::BuildRecoNeutrinoHitMaps(const PFParticleMap& recoParticleMap,
+  PFParticleMonitoring::BuildRecoNeutrinoHitMaps(const PFParticleHierarchy& recoParticleHierarchy,
                                                  const PFParticlesToHits& recoParticlesToHits,
                                                  PFParticlesToHits& recoNeutrinosToHits,
-                                                 HitsToPFParticles& recoHitsToNeutrinos) const
+                                                 HitsToPFParticlesIndex& recoHitsToNeutrinos) const
   {
-    for (PFParticleMap::const_iterator iter1 = recoParticleMap.begin(),
-                                       iterEnd1 = recoParticleMap.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> recoParticle = iter1->second;
+    for (size_t index = 0; index < recoParticleHierarchy.GetNParticles(); ++index) {
+      const art::Ptr<recob::PFParticle> recoParticle = recoParticleHierarchy.GetParticle(index);
+
+      // ATTN Skip particles shadowed by a later particle with the same ID
+      if (recoParticleHierarchy.GetIndex(recoParticle->Self()) != index) continue;
+
       const art::Ptr<recob::PFParticle> recoNeutrino =
-        LArPandoraHelper::GetParentPFParticle(recoParticleMap, recoParticle);
+        LArPandoraHelper::GetParentPFParticle(recoParticleHierarchy, recoParticle);
 
       if (!LArPandoraHelper::IsNeutrino(recoNeutrino)) continue;
 
@@ -1210,7 +1245,7 @@ namespace lar_pandora {
 
   void
   PFParticleMonitoring::GetRecoToTrueMatches(const PFParticlesToHits& recoNeutrinosToHits,
-                                             const HitsToMCTruth& trueHitsToNeutrinos,
+                                             const HitsToMCTruthIndex& trueHitsToNeutrinos,
                                              MCTruthToPFParticles& matchedNeutrinos,
                                              MCTruthToHits& matchedNeutrinoHits) const
   {
@@ -1229,7 +1264,7 @@ namespace lar_pandora {
 
   void
   PFParticleMonitoring::GetRecoToTrueMatches(const PFParticlesToHits& recoNeutrinosToHits,
-                                             const HitsToMCTruth& trueHitsToNeutrinos,
+                                             const HitsToMCTruthIndex& trueHitsToNeutrinos,
                                              MCTruthToPFParticles& matchedNeutrinos,
                                              MCTruthToHits& matchedNeutrinoHits,
                                              PFParticleSet& vetoReco,
@@ -1246,14 +1281,14 @@ namespace lar_pandora {
 
       const HitVector& hitVector = iter1->second;
 
-      MCTruthToHits truthContributionMap;
+      std::unordered_map<art::Ptr<simb::MCTruth>, HitVector> truthContributionMap;
 
       for (HitVector::const_iterator iter2 = hitVector.begin(), iterEnd2 = hitVector.end();
            iter2 != iterEnd2;
            ++iter2) {
         const art::Ptr<recob::Hit> hit = *iter2;
 
-        HitsToMCTruth::const_iterator iter3 = trueHitsToNeutrinos.find(hit);
+        HitsToMCTruthIndex::const_iterator iter3 = trueHitsToNeutrinos.find(hit);
         if (trueHitsToNeutrinos.end() == iter3) continue;
 
         const art::Ptr<simb::MCTruth> trueNeutrino = iter3->second;
@@ -1262,19 +1297,20 @@ namespace lar_pandora {
         truthContributionMap[trueNeutrino].push_back(hit);
       }
 
-      MCTruthToHits::const_iterator mIter = truthContributionMap.end();
+      // ATTN Ties go to the lowest key, as they did when iterating over an ordered map
+      auto mIter = truthContributionMap.cend();
 
-      for (MCTruthToHits::const_iterator iter4 = truthContributionMap.begin(),
-                                         iterEnd4 = truthContributionMap.end();
+      for (auto iter4 = truthContributionMap.cbegin(), iterEnd4 = truthContributionMap.cend();
            iter4 != iterEnd4;
            ++iter4) {
-        if ((truthContributionMap.end() == mIter) ||
-            (iter4->second.size() > mIter->second.size())) {
+        if ((truthContributionMap.cend() == mIter) ||
+            (iter4->second.size() > mIter->second.size()) ||
+            ((iter4->second.size() == mIter->second.size()) && (iter4->first < mIter->first))) {
           mIter = iter4;
         }
       }
 
-      if (truthContributionMap.end() != mIter) {
+      if (truthContributionMap.cend() != mIter) {
         const art::Ptr<simb::MCTruth> trueNeutrino = mIter->first;
 
         MCTruthToHits::const_iterator iter5 = matchedNeutrinoHits.find(trueNeutrino);
@@ -1310,7 +1346,7 @@ namespace lar_pandora {
 
   void
   PFParticleMonitoring::GetRecoToTrueMatches(const PFParticlesToHits& recoParticlesToHits,
-                                             const HitsToMCParticles& trueHitsToParticles,
+                                             const HitsToMCParticlesIndex& trueHitsToParticles,
                                              MCParticlesToPFParticles& matchedParticles,
                                              MCParticlesToHits& matchedHits) const
   {
@@ -1325,7 +1361,7 @@ namespace lar_pandora {
 
   void
   PFParticleMonitoring::GetRecoToTrueMatches(const PFParticlesToHits& recoParticlesToHits,
-                                             const HitsToMCParticles& trueHitsToParticles,
+                                             const HitsToMCParticlesIndex& trueHitsToParticles,
                                              MCParticlesToPFParticles& matchedParticles,
                                              MCParticlesToHits& matchedHits,
                                              PFParticleSet& vetoReco,
@@ -1342,14 +1378,14 @@ namespace lar_pandora {
 
       const HitVector& hitVector = iter1->second;
 
-      MCParticlesToHits truthContributionMap;
+      std::unordered_map<art::Ptr<simb::MCParticle>, HitVector> truthContributionMap;
 
       for (HitVector::const_iterator iter2 = hitVector.begin(), iterEnd2 = hitVector.end();
            iter2 != iterEnd2;
            ++iter2) {
         const art::Ptr<recob::Hit> hit = *iter2;
 
-        HitsToMCParticles::const_iterator iter3 = trueHitsToParticles.find(hit);
+        HitsToMCParticlesIndex::const_iterator iter3 = trueHitsToParticles.find(hit);
         if (trueHitsToParticles.end() == iter3) continue;
 
         const art::Ptr<simb::MCParticle> trueParticle = iter3->second;
@@ -1358,19 +1394,20 @@ namespace lar_pandora {
         truthContributionMap[trueParticle].push_back(hit);
       }
 
-      MCParticlesToHits::const_iterator mIter = truthContributionMap.end();
+      // ATTN Ties go to the lowest key, as they did when iterating over an ordered map
+      auto mIter = truthContributionMap.cend();
 
-      for (MCParticlesToHits::const_iterator iter4 = truthContributionMap.begin(),
-                                             iterEnd4 = truthContributionMap.end();
+      for (auto iter4 = truthContributionMap.cbegin(), iterEnd4 = truthContributionMap.cend();
            iter4 != iterEnd4;
            ++iter4) {
-        if ((truthContributionMap.end() == mIter) ||
-            (iter4->second.size() > mIter->second.size())) {
+        if ((truthContributionMap.cend() == mIter) ||
+            (iter4->second.size() > mIter->second.size()) ||
+            ((iter4->second.size() == mIter->second.size()) && (iter4->first < mIter->first))) {
           mIter = iter4;
         }
       }
 
-      if (truthContributionMap.end() != mIter) {
+      if (truthContributionMap.cend() != mIter) {
         const art::Ptr<simb::MCParticle> trueParticle = mIter->first;
 
         MCParticlesToHits::const_iterator iter5 = matchedHits.find(trueParticle);
@@ -1404,6 +1441,20 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  template <typename T>
+  void
+  PFParticleMonitoring::BuildHitIndex(
+    const std::map<art::Ptr<recob::Hit>, art::Ptr<T>>& hitMap,
+    std::unordered_map<art::Ptr<recob::Hit>, art::Ptr<T>>& hitIndex)
+  {
+    hitIndex.reserve(hitMap.size());
+
+    for (const auto& mapEntry : hitMap)
+      hitIndex.emplace(mapEntry.first, mapEntry.second);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   int
   PFParticleMonitoring::CountHitsByType(const int view, const HitVector& hitVector) const
   {
@@ -4,8 +4,8 @@
  *  @brief  Analysis module for created particles
  */
 
-#include "art/Framework/Core/EDAnalyzer.h"
 #include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 
 #include "TTree.h"
 
@@ -18,23 +18,24 @@ namespace lar_pandora {
   /**
  *  @brief  PFParticleTrackAna class
  */
-  class PFParticleTrackAna : public art::EDAnalyzer {
+  class PFParticleTrackAna : public art::SharedAnalyzer {
   public:
     /**
      *  @brief  Constructor
      *
      *  @param  pset
+     *  @param  frame
      */
-    PFParticleTrackAna(fhicl::ParameterSet const& pset);
+    PFParticleTrackAna(fhicl::ParameterSet const& pset, art::ProcessingFrame const& frame);
 
     /**
      *  @brief  Destructor
      */
     virtual ~PFParticleTrackAna();
 
-    void beginJob();
-    void endJob();
-    void analyze(const art::Event& evt);
+    void beginJob(art::ProcessingFrame const& frame) override;
+    void endJob(art::ProcessingFrame const& frame) override;
+    void analyze(const art::Event& evt, art::ProcessingFrame const& frame) override;
     void reconfigure(fhicl::ParameterSet const& pset);
 
   private:
@@ -94,9 +95,12 @@ namespace lar_pandora {
 
 namespace lar_pandora {
 
-  PFParticleTrackAna::PFParticleTrackAna(fhicl::ParameterSet const& pset) : art::EDAnalyzer(pset)
+  PFParticleTrackAna::PFParticleTrackAna(fhicl::ParameterSet const& pset,
+                                         art::ProcessingFrame const&)
+    : art::SharedAnalyzer(pset)
   {
     this->reconfigure(pset);
+    serialize(art::SharedResource<art::TFileService>);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -116,7 +120,7 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleTrackAna::beginJob()
+  PFParticleTrackAna::beginJob(art::ProcessingFrame const&)
   {
     //
     art::ServiceHandle<art::TFileService const> tfs;
@@ -144,14 +148,18 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleTrackAna::endJob()
+  PFParticleTrackAna::endJob(art::ProcessingFrame const&)
   {}
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  PFParticleTrackAna::analyze(const art::Event& evt)
+  PFParticleTrackAna::analyze(const art::Event& evt, art::ProcessingFrame const&)
   {
+    TrackVector trackVector;
+    TracksToHits tracksToHits;
+    LArPandoraHelper::CollectTracks(evt, m_trackModuleLabel, trackVector, tracksToHits);
+
     std::cout << " *** PFParticleTrackAna::analyze(...) *** " << std::endl;
 
     m_run = evt.run();
@@ -177,10 +185,6 @@ namespace lar_pandora {
     std::cout << "  Run: " << m_run << std::endl;
     std::cout << "  Event: " << m_event << std::endl;
 
-    TrackVector trackVector;
-    TracksToHits tracksToHits;
-    LArPandoraHelper::CollectTracks(evt, m_trackModuleLabel, trackVector, tracksToHits);
-
     std::cout << "  Tracks: " << trackVector.size() << std::endl;
 
     // art::ServiceHandle<geo::Geometry const> theGeometry;
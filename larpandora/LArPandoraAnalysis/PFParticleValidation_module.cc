@@ -6,12 +6,14 @@
  */
 
 #include "art/Framework/Core/ModuleMacros.h"
-#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
 
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -21,24 +23,25 @@ namespace lar_pandora
 /**
  *  @brief  PFParticleValidation class
  */
-class PFParticleValidation : public art::EDAnalyzer
+class PFParticleValidation : public art::SharedAnalyzer
 {
 public:
     /**
      *  @brief  Constructor
      *
      *  @param  pset
+     *  @param  frame
      */
-     PFParticleValidation(fhicl::ParameterSet const &pset);
+     PFParticleValidation(fhicl::ParameterSet const &pset, art::ProcessingFrame const &frame);
 
     /**
      *  @brief  Destructor
      */
      virtual ~PFParticleValidation();
 
-     void beginJob();
-     void endJob();
-     void analyze(const art::Event &evt);
+     void beginJob(art::ProcessingFrame const &frame) override;
+     void endJob(art::ProcessingFrame const &frame) override;
+     void analyze(const art::Event &evt, art::ProcessingFrame const &frame) override;
      void reconfigure(fhicl::ParameterSet const &pset);
 
 private:
@@ -121,8 +124,33 @@ private:
     typedef std::map<int, MatchingDetails> MatchingDetailsMap;
     typedef std::map<SimpleMCPrimary, SimpleMatchedPfoList> MCPrimaryMatchingMap; // SimpleMCPrimary has a defined operator<
 
-    typedef std::map< art::Ptr<recob::PFParticle>, HitVector > PFParticleToMatchedHits;
-    typedef std::map< art::Ptr<simb::MCParticle>,  PFParticleToMatchedHits > MCParticleMatchingMap;
+    /**
+     * @brief   HitCounts class
+     */
+    class HitCounts
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        HitCounts();
+
+        /**
+         *  @brief  Count a hit in a specified view
+         *
+         *  @param  view the view
+         */
+        void AddHit(const geo::View_t view);
+
+        int                                 m_nHitsTotal;               ///< The total number of hits
+        int                                 m_nHitsU;                   ///< The number of u hits
+        int                                 m_nHitsV;                   ///< The number of v hits
+        int                                 m_nHitsW;                   ///< The number of w hits
+    };
+
+    typedef std::unordered_map< art::Ptr<recob::PFParticle>, HitCounts > PFParticleToHitCounts;
+    typedef std::unordered_map< const simb::MCParticle*, PFParticleToHitCounts > MCParticleMatchingMap;
+    typedef std::unordered_map< art::Ptr<recob::Hit>, const simb::MCParticle* > HitsToMCParticlesIndex;
 
     /**
      *  @brief  Performing matching between true and reconstructed particles
@@ -130,7 +158,7 @@ private:
      *  @param  recoParticlesToHits the mapping from reconstructed particles to hits
      *  @param  trueParticlesToHits the mapping from true particles to hits
      *  @param  hitsToTrueParticles the mapping from hits to true particles
-     *  @param  mcParticleMatchingMap the output matches between all reconstructed and true particles
+     *  @param  mcParticleMatchingMap the output numbers of hits shared between all reconstructed and true particles
      */
     void GetMCParticleMatchingMap(const PFParticlesToHits &recoParticlesToHits, const MCParticlesToHits &trueParticlesToHits,
         const HitsToMCParticles &hitsToTrueParticles, MCParticleMatchingMap &mcParticleMatchingMap) const;
@@ -151,8 +179,8 @@ private:
      *  @brief  Obtain a sorted list of matched pfos for each mc primary
      *
      *  @param  simpleMCPrimaryList the simple mc primary list
-     *  @param  mcToFullPfoMatchingMap the mc to full pfo matching map
-     *  @param  pfoToHitListMap the pfo to hit list map
+     *  @param  mcParticleMatchingMap the mc to pfo shared hit counts
+     *  @param  pfParticlesToHits the pfo to hit list map
      *  @param  mcPrimaryMatchingMap to receive the populated mc primary matching map
      */
     void GetMCPrimaryMatchingMap(const SimpleMCPrimaryList &simpleMCPrimaryList, const MCParticleMatchingMap &mcParticleMatchingMap,
@@ -290,6 +318,8 @@ private:
      */
     static bool SortSimpleMatchedPfos(const SimpleMatchedPfo &lhs, const SimpleMatchedPfo &rhs);
 
+    std::mutex          m_printMutex;                   ///< Serialises the printout of concurrent events
+
     std::string         m_hitfinderLabel;               ///< The name/label of the hit producer module
     std::string         m_particleLabel;                ///< The name/label of the particle producer module
     std::string         m_geantModuleLabel;             ///< The name/label of the geant module
@@ -333,10 +363,11 @@ DEFINE_ART_MODULE(PFParticleValidation)
 namespace lar_pandora
 {
 
-PFParticleValidation::PFParticleValidation(fhicl::ParameterSet const &pset) :
-    art::EDAnalyzer(pset)
+PFParticleValidation::PFParticleValidation(fhicl::ParameterSet const &pset, art::ProcessingFrame const &) :
+    art::SharedAnalyzer(pset)
 {
     this->reconfigure(pset);
+    async<art::InEvent>();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -367,19 +398,19 @@ void PFParticleValidation::reconfigure(fhicl::ParameterSet const &pset)
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleValidation::beginJob()
+void PFParticleValidation::beginJob(art::ProcessingFrame const &)
 {
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleValidation::endJob()
+void PFParticleValidation::endJob(art::ProcessingFrame const &)
 {
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PFParticleValidation::analyze(const art::Event &evt)
+void PFParticleValidation::analyze(const art::Event &evt, art::ProcessingFrame const &)
 {
     HitVector hitVector;
     LArPandoraHelper::CollectHits(evt, m_hitfinderLabel, hitVector);
@@ -418,15 +449,19 @@ void PFParticleValidation::analyze(const art::Event &evt)
     PFParticleVector recoNeutrinoVector;
     this->GetRecoNeutrinos(evt, recoNeutrinoVector);
 
+    MatchingDetailsMap matchingDetailsMap;
+
+    if (m_printMatchingToScreen)
+        this->PerformMatching(mcPrimaryMatchingMap, matchingDetailsMap);
+
+    // ATTN Keep the printout of each event in one piece when events are processed concurrently
+    std::lock_guard<std::mutex> lock(m_printMutex);
+
     if (m_printAllToScreen)
         this->PrintAllOutput(mcTruthVector, recoNeutrinoVector, mcPrimaryMatchingMap);
 
     if (m_printMatchingToScreen)
-    {
-        MatchingDetailsMap matchingDetailsMap;
-        this->PerformMatching(mcPrimaryMatchingMap, matchingDetailsMap);
         this->PrintMatchingOutput(mcPrimaryMatchingMap, matchingDetailsMap);
-    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -435,27 +470,35 @@ void PFParticleValidation::GetMCParticleMatchingMap(const PFParticlesToHits &pfP
     const HitsToMCParticles &hitsToMCParticles, MCParticleMatchingMap &mcParticleMatchingMap) const
 {
     // Create a placeholder entry for all mc particles with >0 hits
+    mcParticleMatchingMap.reserve(mcParticlesToHits.size());
+
     for (const MCParticlesToHits::value_type &mcParticleToHitsEntry : mcParticlesToHits)
     {
         if (!mcParticleToHitsEntry.second.empty())
-            (void) mcParticleMatchingMap.insert(MCParticleMatchingMap::value_type(mcParticleToHitsEntry.first, PFParticleToMatchedHits()));
+            (void) mcParticleMatchingMap.insert(MCParticleMatchingMap::value_type(mcParticleToHitsEntry.first.get(), PFParticleToHitCounts()));
     }
 
-    // Store true to reco matching details
+    // Hash the hit to true particle mapping, for constant-time lookup of each reco hit
+    HitsToMCParticlesIndex hitsToMCParticlesIndex;
+    hitsToMCParticlesIndex.reserve(hitsToMCParticles.size());
+
+    for (const HitsToMCParticles::value_type &hitToMCParticle : hitsToMCParticles)
+        (void) hitsToMCParticlesIndex.insert(HitsToMCParticlesIndex::value_type(hitToMCParticle.first, hitToMCParticle.second.get()));
+
+    // Count the hits shared between each reco particle and each true particle
     for (const PFParticlesToHits::value_type &recoParticleToHits : pfParticlesToHits)
     {
         const art::Ptr<recob::PFParticle> pRecoParticle(recoParticleToHits.first);
         const HitVector &hitVector(recoParticleToHits.second);
 
-        for (const art::Ptr<recob::Hit> pHit : hitVector)
+        for (const art::Ptr<recob::Hit> &pHit : hitVector)
         {
-            HitsToMCParticles::const_iterator mcParticleIter = hitsToMCParticles.find(pHit);
+            HitsToMCParticlesIndex::const_iterator mcParticleIter = hitsToMCParticlesIndex.find(pHit);
 
-            if (hitsToMCParticles.end() == mcParticleIter)
+            if (hitsToMCParticlesIndex.end() == mcParticleIter)
                 continue;
 
-            const art::Ptr<simb::MCParticle> pTrueParticle = mcParticleIter->second;
-            mcParticleMatchingMap[pTrueParticle][pRecoParticle].push_back(pHit);
+            mcParticleMatchingMap[mcParticleIter->second][pRecoParticle].AddHit(pHit->View());
         }
     }
 }
@@ -493,7 +536,7 @@ void PFParticleValidation::GetSimpleMCPrimaryList(const art::Event &evt, const M
             simpleMCPrimary.m_nMCHitsW = this->CountHitsByType(geo::kW, hitVector);
         }
 
-        MCParticleMatchingMap::const_iterator matchedPfoIter = mcParticleMatchingMap.find(pMCPrimary);
+        MCParticleMatchingMap::const_iterator matchedPfoIter = mcParticleMatchingMap.find(pMCPrimary.get());
 
         if (mcParticleMatchingMap.end() != matchedPfoIter)
             simpleMCPrimary.m_nMatchedPfos = matchedPfoIter->second.size();
@@ -526,65 +569,64 @@ bool PFParticleValidation::IsNeutrinoInduced(const art::Ptr<simb::MCParticle> pM
 void PFParticleValidation::GetMCPrimaryMatchingMap(const SimpleMCPrimaryList &simpleMCPrimaryList, const MCParticleMatchingMap &mcParticleMatchingMap,
     const PFParticlesToHits &pfParticlesToHits, MCPrimaryMatchingMap &mcPrimaryMatchingMap) const
 {
+    // Index the pfos by particle ID, keeping the first pfo for each ID, and count the hits of each pfo once
+    std::unordered_map<size_t, art::Ptr<recob::PFParticle> > pfoIdToPfo;
+    PFParticleToHitCounts pfoHitCounts;
+    pfoIdToPfo.reserve(pfParticlesToHits.size());
+    pfoHitCounts.reserve(pfParticlesToHits.size());
+
+    for (const PFParticlesToHits::value_type &pfParticleToHits : pfParticlesToHits)
+    {
+        (void) pfoIdToPfo.insert(std::make_pair(pfParticleToHits.first->Self(), pfParticleToHits.first));
+
+        HitCounts &hitCounts(pfoHitCounts[pfParticleToHits.first]);
+
+        for (const art::Ptr<recob::Hit> &pHit : pfParticleToHits.second)
+            hitCounts.AddHit(pHit->View());
+    }
+
     for (const SimpleMCPrimary &simpleMCPrimary : simpleMCPrimaryList)
     {
         SimpleMatchedPfoList simpleMatchedPfoList;
-        MCParticleMatchingMap::const_iterator matchedPfoIter = mcParticleMatchingMap.end();
-
-        // ATTN Nasty workaround I
-        for (MCParticleMatchingMap::const_iterator iter = mcParticleMatchingMap.begin(), iterEnd = mcParticleMatchingMap.end(); iter != iterEnd; ++iter)
-        {
-            if (simpleMCPrimary.m_pAddress == iter->first.get())
-            {
-                matchedPfoIter = iter;
-                break;
-            };
-        }
+        MCParticleMatchingMap::const_iterator matchedPfoIter = mcParticleMatchingMap.find(simpleMCPrimary.m_pAddress);
 
         if (mcParticleMatchingMap.end() != matchedPfoIter)
         {
-            for (const PFParticleToMatchedHits::value_type &contribution : matchedPfoIter->second)
+            for (const PFParticleToHitCounts::value_type &contribution : matchedPfoIter->second)
             {
                 const art::Ptr<recob::PFParticle> pMatchedPfo(contribution.first);
-                const HitVector &matchedHitVector(contribution.second);
+                const HitCounts &matchedHitCounts(contribution.second);
 
                 SimpleMatchedPfo simpleMatchedPfo;
                 simpleMatchedPfo.m_pAddress = pMatchedPfo.get();
                 simpleMatchedPfo.m_id = pMatchedPfo->Self();
 
                 // ATTN Assume pfos have either zero or one parents. Ignore parent neutrino.
-                PFParticlesToHits::const_iterator parentPfoIter = pfParticlesToHits.end();
-
-                // ATTN Nasty workaround II, bad place for another loop.
-                for (PFParticlesToHits::const_iterator iter = pfParticlesToHits.begin(), iterEnd = pfParticlesToHits.end(); iter != iterEnd; ++iter)
+                if (!pMatchedPfo->IsPrimary())
                 {
-                    if (pMatchedPfo->Parent() == iter->first->Self())
-                    {
-                        parentPfoIter = iter;
-                        break;
-                    };
-                }
+                    const auto parentPfoIter(pfoIdToPfo.find(pMatchedPfo->Parent()));
 
-                if ((pfParticlesToHits.end() != parentPfoIter) && !LArPandoraHelper::IsNeutrino(parentPfoIter->first))
-                    simpleMatchedPfo.m_parentId = parentPfoIter->first->Self();
+                    if ((pfoIdToPfo.end() != parentPfoIter) && !LArPandoraHelper::IsNeutrino(parentPfoIter->second))
+                        simpleMatchedPfo.m_parentId = parentPfoIter->second->Self();
+                }
 
                 simpleMatchedPfo.m_pdgCode = pMatchedPfo->PdgCode();
-                simpleMatchedPfo.m_nMatchedHitsTotal = matchedHitVector.size();
-                simpleMatchedPfo.m_nMatchedHitsU = this->CountHitsByType(geo::kU, matchedHitVector);
-                simpleMatchedPfo.m_nMatchedHitsV = this->CountHitsByType(geo::kV, matchedHitVector);
-                simpleMatchedPfo.m_nMatchedHitsW = this->CountHitsByType(geo::kW, matchedHitVector);
+                simpleMatchedPfo.m_nMatchedHitsTotal = matchedHitCounts.m_nHitsTotal;
+                simpleMatchedPfo.m_nMatchedHitsU = matchedHitCounts.m_nHitsU;
+                simpleMatchedPfo.m_nMatchedHitsV = matchedHitCounts.m_nHitsV;
+                simpleMatchedPfo.m_nMatchedHitsW = matchedHitCounts.m_nHitsW;
 
-                PFParticlesToHits::const_iterator pfoHitsIter = pfParticlesToHits.find(pMatchedPfo);
+                PFParticleToHitCounts::const_iterator pfoHitsIter = pfoHitCounts.find(pMatchedPfo);
 
-                if (pfParticlesToHits.end() == pfoHitsIter)
+                if (pfoHitCounts.end() == pfoHitsIter)
                     throw cet::exception("LArPandora") << " PFParticleValidation::analyze --- Presence of PFParticle in map mandatory.";
 
-                const HitVector &pfoHitVector(pfoHitsIter->second);
+                const HitCounts &pfoHitCount(pfoHitsIter->second);
 
-                simpleMatchedPfo.m_nPfoHitsTotal = pfoHitVector.size();
-                simpleMatchedPfo.m_nPfoHitsU = this->CountHitsByType(geo::kU, pfoHitVector);
-                simpleMatchedPfo.m_nPfoHitsV = this->CountHitsByType(geo::kV, pfoHitVector);
-                simpleMatchedPfo.m_nPfoHitsW = this->CountHitsByType(geo::kW, pfoHitVector);
+                simpleMatchedPfo.m_nPfoHitsTotal = pfoHitCount.m_nHitsTotal;
+                simpleMatchedPfo.m_nPfoHitsU = pfoHitCount.m_nHitsU;
+                simpleMatchedPfo.m_nPfoHitsV = pfoHitCount.m_nHitsV;
+                simpleMatchedPfo.m_nPfoHitsW = pfoHitCount.m_nHitsW;
 
                 simpleMatchedPfoList.push_back(simpleMatchedPfo);
             }
@@ -945,4 +987,29 @@ PFParticleValidation::MatchingDetails::MatchingDetails() :
 {
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+PFParticleValidation::HitCounts::HitCounts() :
+    m_nHitsTotal(0),
+    m_nHitsU(0),
+    m_nHitsV(0),
+    m_nHitsW(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void PFParticleValidation::HitCounts::AddHit(const geo::View_t view)
+{
+    ++m_nHitsTotal;
+
+    if (geo::kU == view)
+        ++m_nHitsU;
+    else if (geo::kV == view)
+        ++m_nHitsV;
+    else if (geo::kW == view)
+        ++m_nHitsW;
+}
+
 } //namespace lar_pandora
@@ -25,6 +25,11 @@
 #include "lardataobj/RecoBase/Slice.h"
 
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h"
+
+#include <memory>
+#include <set>
+#include <vector>
 
 namespace lar_pandora
 {
@@ -48,6 +53,46 @@ private:
     template <class T>
         using Association = art::FindManyP<T>;
 
+    /**
+     *  @brief  Class holding an association that is only read from the event when it is first accessed
+     */
+    template <class T, class U>
+    class LazyAssociation
+    {
+    public:
+        /**
+         *  @brief  Constructor
+         *
+         *  @param  evt the art event
+         *  @param  label the producer label (the association is unavailable if empty)
+         *  @param  collection the input collection (from which object are associated), which must outlive this object
+         */
+        LazyAssociation(const art::Event &evt, const std::string &label, const Collection<T> &collection);
+
+        /**
+         *  @brief  Whether the association has been requested, i.e. has a producer label
+         */
+        bool IsAvailable() const;
+
+        /**
+         *  @brief  Get the number of entries in the association, without reading it
+         */
+        size_t size() const;
+
+        /**
+         *  @brief  Get the objects associated to a given input object, reading the association on first use
+         *
+         *  @param  key the key of the input object
+         */
+        const std::vector< art::Ptr<U> > &at(const size_t key) const;
+
+    private:
+        const art::Event                              &m_evt;           ///< The art event
+        const std::string                              m_label;         ///< The producer label
+        const Collection<T>                           &m_collection;    ///< The input collection
+        mutable std::unique_ptr< Association<U> >      m_pAssociation;  ///< The association, once read
+    };
+
     /**
      *  @brief  Class holding the handle for all of the data types from Pandora
      */
@@ -64,10 +109,8 @@ private:
          */
         PandoraData(const art::Event &evt, const std::string &pandoraLabel, const std::string &trackLabel = "", const std::string &showerLabel = "");
 
-        /**
-         *  @brief  Default destructor
-         */
-        ~PandoraData();
+        PandoraData(PandoraData const &) = delete;
+        PandoraData & operator = (PandoraData const &) = delete;
 
         // Collections
         Collection<recob::PFParticle>           m_pfParticleCollection;                ///< The PFParticle handle
@@ -81,21 +124,21 @@ private:
         Collection<recob::Slice>                m_sliceCollection;                     ///< The Slice handle
 
         // Associations
-        Association<larpandoraobj::PFParticleMetadata> *m_pPFParticleToMetadataAssociation;    ///< The PFParticle to metadata association
-        Association<recob::Cluster>            *m_pPFParticleToClusterAssociation;     ///< The PFParticle to cluster association
-        Association<recob::SpacePoint>         *m_pPFParticleToSpacePointAssociation;  ///< The PFParticle to space point association
-        Association<recob::Vertex>             *m_pPFParticleToVertexAssociation;      ///< The PFParticle to vertex association
-        Association<recob::Track>              *m_pPFParticleToTrackAssociation;       ///< The PFParticle to track association
-        Association<recob::Shower>             *m_pPFParticleToShowerAssociation;      ///< The PFParticle to shower association
-        Association<recob::Slice>              *m_pPFParticleToSliceAssociation;       ///< The PFParticle to slice association
-
-        Association<recob::Hit>                *m_pClusterToHitAssociation;            ///< The Cluster to hit association
-        Association<recob::Hit>                *m_pSpacePointToHitAssociation;         ///< The SpacePoint to hit association
-        Association<recob::Hit>                *m_pTrackToHitAssociation;              ///< The Track to hit association
-        Association<recob::Hit>                *m_pShowerToHitAssociation;             ///< The Shower to hit association
-        Association<recob::Hit>                *m_pSliceToHitAssociation;              ///< The Slice to hit association
-
-        Association<recob::PCAxis>             *m_pShowerToPCAxisAssociation;          ///< The Shower to PCAxis association
+        LazyAssociation<recob::PFParticle, larpandoraobj::PFParticleMetadata> m_pfParticleToMetadataAssociation;   ///< The PFParticle to metadata association
+        LazyAssociation<recob::PFParticle, recob::Cluster>      m_pfParticleToClusterAssociation;      ///< The PFParticle to cluster association
+        LazyAssociation<recob::PFParticle, recob::SpacePoint>   m_pfParticleToSpacePointAssociation;   ///< The PFParticle to space point association
+        LazyAssociation<recob::PFParticle, recob::Vertex>       m_pfParticleToVertexAssociation;       ///< The PFParticle to vertex association
+        LazyAssociation<recob::PFParticle, recob::Track>        m_pfParticleToTrackAssociation;        ///< The PFParticle to track association
+        LazyAssociation<recob::PFParticle, recob::Shower>       m_pfParticleToShowerAssociation;       ///< The PFParticle to shower association
+        LazyAssociation<recob::PFParticle, recob::Slice>        m_pfParticleToSliceAssociation;        ///< The PFParticle to slice association
+
+        LazyAssociation<recob::Cluster, recob::Hit>             m_clusterToHitAssociation;             ///< The Cluster to hit association
+        LazyAssociation<recob::SpacePoint, recob::Hit>          m_spacePointToHitAssociation;          ///< The SpacePoint to hit association
+        LazyAssociation<recob::Track, recob::Hit>               m_trackToHitAssociation;               ///< The Track to hit association
+        LazyAssociation<recob::Shower, recob::Hit>              m_showerToHitAssociation;              ///< The Shower to hit association
+        LazyAssociation<recob::Slice, recob::Hit>               m_sliceToHitAssociation;               ///< The Slice to hit association
+
+        LazyAssociation<recob::Shower, recob::PCAxis>           m_showerToPCAxisAssociation;           ///< The Shower to PCAxis association
 
     private:
         /**
@@ -107,17 +150,6 @@ private:
          */
         template <class T>
         void LoadCollection(const art::Event &evt, const std::string &label, Collection<T> &collection);
-
-        /**
-         *  @brief  Load an association from the event
-         *
-         *  @param  evt the art event
-         *  @param  label the producer label
-         *  @param  collection the input collection (from which object are associated)
-         *  @param  pAssociation the output association
-         */
-        template <class T, class U>
-        void LoadAssociation(const art::Event &evt, const std::string &label, const Collection<T> &collection, Association<U> *&pAssociation);
     };
 
     // -------------------------------------------------------------------------------------------------------------------------------------
@@ -144,22 +176,30 @@ private:
     void PrintPFParticleHierarchy(const PandoraData &data) const;
 
     /**
-     *  @brief  Build the map from PFParticle ID to PFParticle from the input data
+     *  @brief  Collect the PFParticles from which to start printing the hierarchy, applying the slice and PFParticle selections
+     *
+     *  @param  hierarchy the PFParticle hierarchy
+     *  @param  data the pandora collections and associations
+     *  @param  rootIndices the output hierarchy indices of the selected PFParticles
+     */
+    void GetRootPFParticles(const PFParticleHierarchy &hierarchy, const PandoraData &data, std::vector<size_t> &rootIndices) const;
+
+    /**
+     *  @brief  Whether a PFParticle belongs to one of the selected slices
      *
+     *  @param  particle the particle
      *  @param  data the pandora collections and associations
-     *  @param  pfParticleMap the output PFParticle map
      */
-    void BuildPFParticleMap(const PandoraData &data, PFParticleMap &pfParticleMap) const;
+    bool IsInSelectedSlice(const art::Ptr< recob::PFParticle > &particle, const PandoraData &data) const;
 
     /**
-     *  @brief  Print a given PFParticle
+     *  @brief  Print a given PFParticle, excluding its daughters
      *
      *  @param  particle the particle to print
-     *  @param  pfParticleMap the input mapping from PFParticle ID to PFParticle
      *  @param  data the pandora collections and associations
      *  @param  depth the number of characters to indent
      */
-    void PrintParticle(const art::Ptr< recob::PFParticle > &particle, const PFParticleMap &pfParticleMap, const PandoraData &data, const unsigned int depth) const;
+    void PrintParticle(const art::Ptr< recob::PFParticle > &particle, const PandoraData &data, const unsigned int depth) const;
 
     /**
      *  @brief  Print a given Hit
@@ -251,6 +291,10 @@ private:
     std::string m_pandoraLabel;    ///< The label of the Pandora pattern recognition producer
     std::string m_trackLabel;      ///< The track producer label
     std::string m_showerLabel;     ///< The shower producer label
+
+    std::set<int>    m_selectedSliceIds;       ///< The IDs of the slices to print (all if empty)
+    std::set<size_t> m_selectedPFParticleIds;  ///< The IDs of the PFParticles from which to print the hierarchy (all primaries if empty)
+    int              m_maxHierarchyDepth;      ///< The maximum number of generations below the first printed PFParticles (no limit if negative)
 };
 
 DEFINE_ART_MODULE(LArPandoraEventDump)
@@ -267,8 +311,15 @@ LArPandoraEventDump::LArPandoraEventDump(fhicl::ParameterSet const &pset) :
     EDAnalyzer(pset),
     m_pandoraLabel(pset.get<std::string>("PandoraLabel")),
     m_trackLabel(pset.get<std::string>("TrackLabel" , "")),
-    m_showerLabel(pset.get<std::string>("ShowerLabel", ""))
+    m_showerLabel(pset.get<std::string>("ShowerLabel", "")),
+    m_maxHierarchyDepth(pset.get<int>("MaxHierarchyDepth", -1))
 {
+    for (const int sliceId : pset.get< std::vector<int> >("SelectedSliceIds", {}))
+        m_selectedSliceIds.insert(sliceId);
+
+    for (const size_t pfParticleId : pset.get< std::vector<size_t> >("SelectedPFParticleIds", {}))
+        m_selectedPFParticleIds.insert(pfParticleId);
+
     m_verbosityLevel = pset.get<std::string>("VerbosityLevel");
     std::transform(m_verbosityLevel.begin(), m_verbosityLevel.end(), m_verbosityLevel.begin(), ::tolower);
 
@@ -329,44 +380,44 @@ void LArPandoraEventDump::PrintEventSummary(const PandoraData &data) const
     std::cout << "Association sizes" << std::endl;
     std::cout << std::string(80, '-') << std::endl;
 
-    if (data.m_pPFParticleToMetadataAssociation)
-        std::cout << "PFParticle -> Metadata   : " << data.m_pPFParticleToMetadataAssociation->size() << std::endl;
+    if (data.m_pfParticleToMetadataAssociation.IsAvailable())
+        std::cout << "PFParticle -> Metadata   : " << data.m_pfParticleToMetadataAssociation.size() << std::endl;
 
-    if (data.m_pPFParticleToClusterAssociation)
-        std::cout << "PFParticle -> Cluster    : " << data.m_pPFParticleToClusterAssociation->size() << std::endl;
+    if (data.m_pfParticleToClusterAssociation.IsAvailable())
+        std::cout << "PFParticle -> Cluster    : " << data.m_pfParticleToClusterAssociation.size() << std::endl;
 
-    if (data.m_pPFParticleToSpacePointAssociation)
-        std::cout << "PFParticle -> SpacePoint : " << data.m_pPFParticleToSpacePointAssociation->size() << std::endl;
+    if (data.m_pfParticleToSpacePointAssociation.IsAvailable())
+        std::cout << "PFParticle -> SpacePoint : " << data.m_pfParticleToSpacePointAssociation.size() << std::endl;
 
-    if (data.m_pPFParticleToVertexAssociation)
-        std::cout << "PFParticle -> Vertex     : " << data.m_pPFParticleToVertexAssociation->size() << std::endl;
+    if (data.m_pfParticleToVertexAssociation.IsAvailable())
+        std::cout << "PFParticle -> Vertex     : " << data.m_pfParticleToVertexAssociation.size() << std::endl;
 
-    if (data.m_pPFParticleToTrackAssociation)
-        std::cout << "PFParticle -> Track      : " << data.m_pPFParticleToTrackAssociation->size() << std::endl;
+    if (data.m_pfParticleToTrackAssociation.IsAvailable())
+        std::cout << "PFParticle -> Track      : " << data.m_pfParticleToTrackAssociation.size() << std::endl;
 
-    if (data.m_pPFParticleToShowerAssociation)
-        std::cout << "PFParticle -> Shower     : " << data.m_pPFParticleToShowerAssociation->size() << std::endl;
+    if (data.m_pfParticleToShowerAssociation.IsAvailable())
+        std::cout << "PFParticle -> Shower     : " << data.m_pfParticleToShowerAssociation.size() << std::endl;
 
-    if (data.m_pPFParticleToSliceAssociation)
-        std::cout << "PFParticle -> Slice      : " << data.m_pPFParticleToSliceAssociation->size() << std::endl;
+    if (data.m_pfParticleToSliceAssociation.IsAvailable())
+        std::cout << "PFParticle -> Slice      : " << data.m_pfParticleToSliceAssociation.size() << std::endl;
 
-    if (data.m_pClusterToHitAssociation)
-        std::cout << "Cluster    -> Hit        : " << data.m_pClusterToHitAssociation->size() << std::endl;
+    if (data.m_clusterToHitAssociation.IsAvailable())
+        std::cout << "Cluster    -> Hit        : " << data.m_clusterToHitAssociation.size() << std::endl;
 
-    if (data.m_pSpacePointToHitAssociation)
-        std::cout << "SpacePoint -> Hit        : " << data.m_pSpacePointToHitAssociation->size() << std::endl;
+    if (data.m_spacePointToHitAssociation.IsAvailable())
+        std::cout << "SpacePoint -> Hit        : " << data.m_spacePointToHitAssociation.size() << std::endl;
 
-    if (data.m_pTrackToHitAssociation)
-        std::cout << "Track      -> Hit        : " << data.m_pTrackToHitAssociation->size() << std::endl;
+    if (data.m_trackToHitAssociation.IsAvailable())
+        std::cout << "Track      -> Hit        : " << data.m_trackToHitAssociation.size() << std::endl;
 
-    if (data.m_pShowerToHitAssociation)
-        std::cout << "Shower     -> Hit        : " << data.m_pShowerToHitAssociation->size() << std::endl;
+    if (data.m_showerToHitAssociation.IsAvailable())
+        std::cout << "Shower     -> Hit        : " << data.m_showerToHitAssociation.size() << std::endl;
 
-    if (data.m_pShowerToPCAxisAssociation)
-        std::cout << "Shower     -> PCAxis     : " << data.m_pShowerToPCAxisAssociation->size() << std::endl;
+    if (data.m_showerToPCAxisAssociation.IsAvailable())
+        std::cout << "Shower     -> PCAxis     : " << data.m_showerToPCAxisAssociation.size() << std::endl;
 
-    if (data.m_pSliceToHitAssociation)
-        std::cout << "Slice      -> Hit        : " << data.m_pSliceToHitAssociation->size() << std::endl;
+    if (data.m_sliceToHitAssociation.IsAvailable())
+        std::cout << "Slice      -> Hit        : " << data.m_sliceToHitAssociation.size() << std::endl;
 
     std::cout << std::endl;
 }
@@ -375,37 +426,85 @@ void LArPandoraEventDump::PrintEventSummary(const PandoraData &data) const
 
 void LArPandoraEventDump::PrintPFParticleHierarchy(const PandoraData &data) const
 {
-    // Get the mapping from PFParticle ID to PFParticle
-    PFParticleMap pfParticleMap;
-    this->BuildPFParticleMap(data, pfParticleMap);
+    PFParticleVector particleVector;
 
-    // Print all primary PFParticles
     for (unsigned int i = 0; i < data.m_pfParticleCollection->size(); ++i)
+        particleVector.emplace_back(data.m_pfParticleCollection, i);
+
+    const PFParticleHierarchy hierarchy(particleVector);
+
+    std::vector<size_t> rootIndices;
+    this->GetRootPFParticles(hierarchy, data, rootIndices);
+
+    // Walk the hierarchy depth-first with an explicit stack of (index, generation), printing each particle before its daughters
+    std::vector< std::pair<size_t, int> > stack;
+
+    for (auto iter = rootIndices.rbegin(); iter != rootIndices.rend(); ++iter)
+        stack.emplace_back(*iter, 0);
+
+    while (!stack.empty())
+    {
+        const size_t index(stack.back().first);
+        const int generation(stack.back().second);
+        stack.pop_back();
+
+        const art::Ptr<recob::PFParticle> &particle(hierarchy.GetParticle(index));
+        this->PrintParticle(particle, data, 4 * generation);
+
+        if ((m_maxHierarchyDepth >= 0) && (generation >= m_maxHierarchyDepth))
+            continue;
+
+        const std::vector<size_t> &daughterIds(particle->Daughters());
+
+        for (auto iter = daughterIds.rbegin(); iter != daughterIds.rend(); ++iter)
+        {
+            const size_t daughterIndex(hierarchy.GetIndex(*iter));
+
+            if (PFParticleHierarchy::kInvalidIndex == daughterIndex)
+                throw cet::exception("LArPandoraEventDump") << "Couldn't find daughter of PFParticle in the PFParticle map";
+
+            stack.emplace_back(daughterIndex, generation + 1);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void LArPandoraEventDump::GetRootPFParticles(const PFParticleHierarchy &hierarchy, const PandoraData &data, std::vector<size_t> &rootIndices) const
+{
+    for (size_t index = 0; index < hierarchy.GetNParticles(); ++index)
     {
-        const art::Ptr<recob::PFParticle> particle(data.m_pfParticleCollection, i);
+        const art::Ptr<recob::PFParticle> &particle(hierarchy.GetParticle(index));
 
-        if (!particle->IsPrimary())
+        if (m_selectedPFParticleIds.empty() ? !particle->IsPrimary() : !m_selectedPFParticleIds.count(particle->Self()))
             continue;
 
-        this->PrintParticle(particle, pfParticleMap, data, 0);
+        if (!m_selectedSliceIds.empty() && !this->IsInSelectedSlice(particle, data))
+            continue;
+
+        rootIndices.push_back(index);
     }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraEventDump::BuildPFParticleMap(const PandoraData &data, PFParticleMap &pfParticleMap) const
+bool LArPandoraEventDump::IsInSelectedSlice(const art::Ptr< recob::PFParticle > &particle, const PandoraData &data) const
 {
-    for (unsigned int i = 0; i < data.m_pfParticleCollection->size(); ++i)
+    if (!data.m_pfParticleToSliceAssociation.IsAvailable())
+        return false;
+
+    for (const auto &slice : data.m_pfParticleToSliceAssociation.at(particle.key()))
     {
-        const art::Ptr<recob::PFParticle> particle(data.m_pfParticleCollection, i);
-        pfParticleMap[particle->Self()] = particle;
+        if (m_selectedSliceIds.count(slice->ID()))
+            return true;
     }
+
+    return false;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &particle, const PFParticleMap &pfParticleMap,
-    const PandoraData &data, const unsigned int depth) const
+void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &particle, const PandoraData &data, const unsigned int depth) const
 {
     this->PrintRule(depth);
     this->PrintTitle("PFParticle", depth);
@@ -421,9 +520,9 @@ void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &par
         this->PrintProperty("Parent", particle->Parent(), depth);
 
     // Print the metadata
-    if (data.m_pPFParticleToMetadataAssociation)
+    if (data.m_pfParticleToMetadataAssociation.IsAvailable())
     {
-        const auto &metadata(data.m_pPFParticleToMetadataAssociation->at(particle.key()));
+        const auto &metadata(data.m_pfParticleToMetadataAssociation.at(particle.key()));
         this->PrintProperty("# Metadata", metadata.size(), depth);
 
         for (const auto &metadatum : metadata)
@@ -437,9 +536,9 @@ void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &par
     }
 
     // Print the slices
-    if (data.m_pPFParticleToSliceAssociation)
+    if (data.m_pfParticleToSliceAssociation.IsAvailable())
     {
-        const auto &slices(data.m_pPFParticleToSliceAssociation->at(particle.key()));
+        const auto &slices(data.m_pfParticleToSliceAssociation.at(particle.key()));
         this->PrintProperty("# Slices", slices.size(), depth);
 
         if (m_verbosityLevel != "summary")
@@ -451,9 +550,9 @@ void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &par
     }
 
     // Print the clusters
-    if (data.m_pPFParticleToClusterAssociation)
+    if (data.m_pfParticleToClusterAssociation.IsAvailable())
     {
-        const auto &clusters(data.m_pPFParticleToClusterAssociation->at(particle.key()));
+        const auto &clusters(data.m_pfParticleToClusterAssociation.at(particle.key()));
         this->PrintProperty("# Clusters", clusters.size(), depth);
 
         if (m_verbosityLevel != "summary")
@@ -464,9 +563,9 @@ void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &par
     }
 
     // Print the space points
-    if (data.m_pPFParticleToSpacePointAssociation)
+    if (data.m_pfParticleToSpacePointAssociation.IsAvailable())
     {
-        const auto &spacePoints(data.m_pPFParticleToSpacePointAssociation->at(particle.key()));
+        const auto &spacePoints(data.m_pfParticleToSpacePointAssociation.at(particle.key()));
         this->PrintProperty("# SpacePoints", spacePoints.size(), depth);
 
         if (m_verbosityLevel != "summary")
@@ -477,9 +576,9 @@ void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &par
     }
 
     // Print the vertices
-    if (data.m_pPFParticleToVertexAssociation)
+    if (data.m_pfParticleToVertexAssociation.IsAvailable())
     {
-        const auto &vertices(data.m_pPFParticleToVertexAssociation->at(particle.key()));
+        const auto &vertices(data.m_pfParticleToVertexAssociation.at(particle.key()));
         this->PrintProperty("# Vertices", vertices.size(), depth);
 
         if (m_verbosityLevel != "summary")
@@ -490,9 +589,9 @@ void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &par
     }
 
     // Print the tracks
-    if (data.m_pPFParticleToTrackAssociation)
+    if (data.m_pfParticleToTrackAssociation.IsAvailable())
     {
-        const auto &tracks(data.m_pPFParticleToTrackAssociation->at(particle.key()));
+        const auto &tracks(data.m_pfParticleToTrackAssociation.at(particle.key()));
         this->PrintProperty("# Tracks", tracks.size(), depth);
 
         if (m_verbosityLevel != "summary")
@@ -503,9 +602,9 @@ void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &par
     }
 
     // Print the showers
-    if (data.m_pPFParticleToShowerAssociation)
+    if (data.m_pfParticleToShowerAssociation.IsAvailable())
     {
-        const auto &showers(data.m_pPFParticleToShowerAssociation->at(particle.key()));
+        const auto &showers(data.m_pfParticleToShowerAssociation.at(particle.key()));
         this->PrintProperty("# Showers", showers.size(), depth);
 
         if (m_verbosityLevel != "summary")
@@ -515,20 +614,9 @@ void LArPandoraEventDump::PrintParticle(const art::Ptr< recob::PFParticle > &par
         }
     }
 
-    // Print the daughters
+    // Print the number of daughters, which are printed next by the caller
     this->PrintProperty("# Daughters", particle->NumDaughters(), depth);
     this->PrintRule(depth);
-
-    for (auto &daughterId : particle->Daughters())
-    {
-        const auto daughterIter(pfParticleMap.find(daughterId));
-
-        if (daughterIter == pfParticleMap.end())
-            throw cet::exception("LArPandoraEventDump") << "Couldn't find daughter of PFParticle in the PFParticle map";
-
-        const auto &daughter(daughterIter->second);
-        this->PrintParticle(daughter, pfParticleMap, data, depth + 4);
-    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -551,10 +639,10 @@ void LArPandoraEventDump::PrintSlice(const art::Ptr<recob::Slice> &slice, const
     this->PrintProperty("Key", slice.key(), depth + 2);
     this->PrintProperty("ID", slice->ID(), depth + 2);
 
-    if (!data.m_pSliceToHitAssociation)
+    if (!data.m_sliceToHitAssociation.IsAvailable())
         return;
 
-    const auto &hits(data.m_pSliceToHitAssociation->at(slice.key()));
+    const auto &hits(data.m_sliceToHitAssociation.at(slice.key()));
     this->PrintProperty("# Hits", hits.size(), depth + 2);
 
     if (m_verbosityLevel != "extreme")
@@ -574,10 +662,10 @@ void LArPandoraEventDump::PrintCluster(const art::Ptr<recob::Cluster> &cluster,
     this->PrintProperty("ID", cluster->ID(), depth + 2);
     this->PrintProperty("View", cluster->View(), depth + 2);
 
-    if (!data.m_pClusterToHitAssociation)
+    if (!data.m_clusterToHitAssociation.IsAvailable())
         return;
 
-    const auto &hits(data.m_pClusterToHitAssociation->at(cluster.key()));
+    const auto &hits(data.m_clusterToHitAssociation.at(cluster.key()));
     this->PrintProperty("# Hits", hits.size(), depth + 2);
 
     if (m_verbosityLevel == "detailed")
@@ -600,10 +688,10 @@ void LArPandoraEventDump::PrintSpacePoint(const art::Ptr<recob::SpacePoint> &spa
     this->PrintProperty("Y", position[1], depth + 2);
     this->PrintProperty("Z", position[2], depth + 2);
 
-    if (!data.m_pSpacePointToHitAssociation)
+    if (!data.m_spacePointToHitAssociation.IsAvailable())
         return;
 
-    const auto &hits(data.m_pSpacePointToHitAssociation->at(spacePoint.key()));
+    const auto &hits(data.m_spacePointToHitAssociation.at(spacePoint.key()));
     this->PrintProperty("# Hits", hits.size(), depth + 2);
 
     if (m_verbosityLevel == "detailed")
@@ -636,10 +724,10 @@ void LArPandoraEventDump::PrintTrack(const art::Ptr<recob::Track> &track, const
     this->PrintProperty("# Trajectory points", track->NumberTrajectoryPoints(), depth + 2);
     this->PrintProperty("Length", track->Length(), depth + 2);
 
-    if (!data.m_pTrackToHitAssociation)
+    if (!data.m_trackToHitAssociation.IsAvailable())
         return;
 
-    const auto &hits(data.m_pTrackToHitAssociation->at(track.key()));
+    const auto &hits(data.m_trackToHitAssociation.at(track.key()));
     this->PrintProperty("# Hits", hits.size(), depth + 2);
 
     if (m_verbosityLevel == "detailed")
@@ -663,9 +751,9 @@ void LArPandoraEventDump::PrintShower(const art::Ptr<recob::Shower> &shower, con
     this->PrintProperty("Length", shower->Length(), depth + 2);
     this->PrintProperty("OpenAngle", shower->OpenAngle(), depth + 2);
 
-    if (data.m_pShowerToPCAxisAssociation)
+    if (data.m_showerToPCAxisAssociation.IsAvailable())
     {
-        const auto &pcAxes(data.m_pShowerToPCAxisAssociation->at(shower.key()));
+        const auto &pcAxes(data.m_showerToPCAxisAssociation.at(shower.key()));
         this->PrintProperty("# PCAxes", pcAxes.size(), depth + 2);
 
         for (const auto &pcAxis : pcAxes)
@@ -677,10 +765,10 @@ void LArPandoraEventDump::PrintShower(const art::Ptr<recob::Shower> &shower, con
         }
     }
 
-    if (!data.m_pShowerToHitAssociation)
+    if (!data.m_showerToHitAssociation.IsAvailable())
         return;
 
-    const auto &hits(data.m_pShowerToHitAssociation->at(shower.key()));
+    const auto &hits(data.m_showerToHitAssociation.at(shower.key()));
     this->PrintProperty("# Hits", hits.size(), depth + 2);
 
     if (m_verbosityLevel == "detailed")
@@ -724,22 +812,21 @@ void LArPandoraEventDump::PrintProperty(const std::string &name, const T &value,
 
 LArPandoraEventDump::PandoraData::PandoraData(const art::Event &evt, const std::string &pandoraLabel, const std::string &trackLabel,
     const std::string &showerLabel) :
-    m_pPFParticleToMetadataAssociation(nullptr),
-    m_pPFParticleToClusterAssociation(nullptr),
-    m_pPFParticleToSpacePointAssociation(nullptr),
-    m_pPFParticleToVertexAssociation(nullptr),
-    m_pPFParticleToTrackAssociation(nullptr),
-    m_pPFParticleToShowerAssociation(nullptr),
-    m_pPFParticleToSliceAssociation(nullptr),
-    m_pClusterToHitAssociation(nullptr),
-    m_pSpacePointToHitAssociation(nullptr),
-    m_pTrackToHitAssociation(nullptr),
-    m_pShowerToHitAssociation(nullptr),
-    m_pSliceToHitAssociation(nullptr),
-    m_pShowerToPCAxisAssociation(nullptr)
+    m_pfParticleToMetadataAssociation(evt, pandoraLabel, m_pfParticleCollection),
+    m_pfParticleToClusterAssociation(evt, pandoraLabel, m_pfParticleCollection),
+    m_pfParticleToSpacePointAssociation(evt, pandoraLabel, m_pfParticleCollection),
+    m_pfParticleToVertexAssociation(evt, pandoraLabel, m_pfParticleCollection),
+    m_pfParticleToTrackAssociation(evt, trackLabel, m_pfParticleCollection),
+    m_pfParticleToShowerAssociation(evt, showerLabel, m_pfParticleCollection),
+    m_pfParticleToSliceAssociation(evt, pandoraLabel, m_pfParticleCollection),
+    m_clusterToHitAssociation(evt, pandoraLabel, m_clusterCollection),
+    m_spacePointToHitAssociation(evt, pandoraLabel, m_spacePointCollection),
+    m_trackToHitAssociation(evt, trackLabel, m_trackCollection),
+    m_showerToHitAssociation(evt, showerLabel, m_showerCollection),
+    m_sliceToHitAssociation(evt, pandoraLabel, m_sliceCollection),
+    m_showerToPCAxisAssociation(evt, showerLabel, m_showerCollection)
 {
-
-    // Load the collections
+    // Load the collections, the associations are only read from the event when first accessed
     this->LoadCollection(evt, pandoraLabel, m_pfParticleCollection);
     this->LoadCollection(evt, pandoraLabel, m_pfParticleMetadataCollection);
     this->LoadCollection(evt, pandoraLabel, m_clusterCollection);
@@ -749,68 +836,59 @@ LArPandoraEventDump::PandoraData::PandoraData(const art::Event &evt, const std::
     this->LoadCollection(evt, showerLabel , m_showerCollection);
     this->LoadCollection(evt, showerLabel , m_pcAxisCollection);
     this->LoadCollection(evt, pandoraLabel, m_sliceCollection);
+}
 
-    // Load the associations
-    this->LoadAssociation(evt, pandoraLabel, m_pfParticleCollection, m_pPFParticleToMetadataAssociation);
-    this->LoadAssociation(evt, pandoraLabel, m_pfParticleCollection, m_pPFParticleToClusterAssociation);
-    this->LoadAssociation(evt, pandoraLabel, m_pfParticleCollection, m_pPFParticleToSpacePointAssociation);
-    this->LoadAssociation(evt, pandoraLabel, m_pfParticleCollection, m_pPFParticleToVertexAssociation);
-    this->LoadAssociation(evt, pandoraLabel, m_pfParticleCollection, m_pPFParticleToSliceAssociation);
-    this->LoadAssociation(evt, pandoraLabel, m_clusterCollection   , m_pClusterToHitAssociation);
-    this->LoadAssociation(evt, pandoraLabel, m_spacePointCollection, m_pSpacePointToHitAssociation);
-    this->LoadAssociation(evt, pandoraLabel, m_sliceCollection,      m_pSliceToHitAssociation);
-
-    this->LoadAssociation(evt, trackLabel  , m_pfParticleCollection, m_pPFParticleToTrackAssociation);
-    this->LoadAssociation(evt, trackLabel  , m_trackCollection     , m_pTrackToHitAssociation);
-
-    this->LoadAssociation(evt, showerLabel , m_pfParticleCollection, m_pPFParticleToShowerAssociation);
-    this->LoadAssociation(evt, showerLabel , m_showerCollection    , m_pShowerToHitAssociation);
-    this->LoadAssociation(evt, showerLabel , m_showerCollection    , m_pShowerToPCAxisAssociation);
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <class T>
+void LArPandoraEventDump::PandoraData::LoadCollection(const art::Event &evt, const std::string &label, Collection<T> &collection)
+{
+    if (label.empty())
+        return;
+
+    evt.getByLabel(label, collection);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-LArPandoraEventDump::PandoraData::~PandoraData()
+template <class T, class U>
+LArPandoraEventDump::LazyAssociation<T, U>::LazyAssociation(const art::Event &evt, const std::string &label, const Collection<T> &collection) :
+    m_evt(evt),
+    m_label(label),
+    m_collection(collection)
 {
-    // Clean up all heap memory
-    delete m_pPFParticleToMetadataAssociation;
-    delete m_pPFParticleToClusterAssociation;
-    delete m_pPFParticleToSpacePointAssociation;
-    delete m_pPFParticleToVertexAssociation;
-    delete m_pPFParticleToTrackAssociation;
-    delete m_pPFParticleToShowerAssociation;
-    delete m_pPFParticleToSliceAssociation;
-    delete m_pClusterToHitAssociation;
-    delete m_pSpacePointToHitAssociation;
-    delete m_pTrackToHitAssociation;
-    delete m_pShowerToHitAssociation;
-    delete m_pShowerToPCAxisAssociation;
-    delete m_pSliceToHitAssociation;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-template <class T>
-void LArPandoraEventDump::PandoraData::LoadCollection(const art::Event &evt, const std::string &label, Collection<T> &collection)
+template <class T, class U>
+bool LArPandoraEventDump::LazyAssociation<T, U>::IsAvailable() const
 {
-    if (label.empty())
-        return;
+    return !m_label.empty();
+}
 
-    evt.getByLabel(label, collection);
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+template <class T, class U>
+size_t LArPandoraEventDump::LazyAssociation<T, U>::size() const
+{
+    // ATTN The association has one entry per object in the input collection
+    return m_pAssociation ? m_pAssociation->size() : m_collection->size();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 template <class T, class U>
-void LArPandoraEventDump::PandoraData::LoadAssociation(const art::Event &evt, const std::string &label, const Collection<T> &collection, Association<U> *&pAssociation)
+const std::vector< art::Ptr<U> > &LArPandoraEventDump::LazyAssociation<T, U>::at(const size_t key) const
 {
-    if (label.empty())
-        return;
+    if (!this->IsAvailable())
+        throw cet::exception("LArPandoraEventDump") << "Association requested without a producer label";
 
-    if (pAssociation)
-        throw cet::exception("LArPandoraEventDump") << "Association supplied type has already been loaded!";
+    if (!m_pAssociation)
+        m_pAssociation = std::make_unique< Association<U> >(m_collection, m_evt, m_label);
 
-    pAssociation = new Association<U>(collection, evt, label);
+    return m_pAssociation->at(key);
 }
 
 } // namespace lar_pandora
@@ -187,26 +187,16 @@ shower::LArPandoraShowerAlg::ShowerCentre(
   return centre_position;
 }
 
+//Returns the vector to the shower centre and the total charge of the shower, for either form of the
+//spacepoint to hit association.
+template <class HitAssociation>
 TVector3
-shower::LArPandoraShowerAlg::ShowerCentre(
+shower::LArPandoraShowerAlg::ShowerCentreFromHits(
   detinfo::DetectorClocksData const& clockData,
   detinfo::DetectorPropertiesData const& detProp,
-  std::vector<art::Ptr<recob::SpacePoint>> const& showerspcs,
-  art::FindManyP<recob::Hit> const& fmh) const
-{
-
-  float totalCharge = 0;
-  return shower::LArPandoraShowerAlg::ShowerCentre(
-    clockData, detProp, showerspcs, fmh, totalCharge);
-}
-
-//Returns the vector to the shower centre and the total charge of the shower.
-TVector3
-shower::LArPandoraShowerAlg::ShowerCentre(detinfo::DetectorClocksData const& clockData,
-                                          detinfo::DetectorPropertiesData const& detProp,
-                                          std::vector<art::Ptr<recob::SpacePoint>> const& showersps,
-                                          art::FindManyP<recob::Hit> const& fmh,
-                                          float& totalCharge) const
+  std::vector<art::Ptr<recob::SpacePoint>> const& showersps,
+  HitAssociation const& fmh,
+  float& totalCharge) const
 {
 
   TVector3 pos, chargePoint = TVector3(0, 0, 0);
@@ -218,7 +208,7 @@ shower::LArPandoraShowerAlg::ShowerCentre(detinfo::DetectorClocksData const& clo
     pos = SpacePointPosition(sp);
 
     //Get the associated hits
-    std::vector<art::Ptr<recob::Hit>> const& hits = fmh.at(sp.key());
+    auto const& hits = fmh.at(sp.key());
 
     //Average the charge unless sepcified.
     float charge = 0;
@@ -288,6 +278,96 @@ shower::LArPandoraShowerAlg::ShowerCentre(detinfo::DetectorClocksData const& clo
   return centre;
 }
 
+TVector3
+shower::LArPandoraShowerAlg::ShowerCentre(
+  detinfo::DetectorClocksData const& clockData,
+  detinfo::DetectorPropertiesData const& detProp,
+  std::vector<art::Ptr<recob::SpacePoint>> const& showerspcs,
+  art::FindManyP<recob::Hit> const& fmh) const
+{
+
+  float totalCharge = 0;
+  return ShowerCentreFromHits(clockData, detProp, showerspcs, fmh, totalCharge);
+}
+
+TVector3
+shower::LArPandoraShowerAlg::ShowerCentre(
+  detinfo::DetectorClocksData const& clockData,
+  detinfo::DetectorPropertiesData const& detProp,
+  std::vector<art::Ptr<recob::SpacePoint>> const& showerspcs,
+  reco::shower::ShowerAssociationView<recob::Hit> const& fmh) const
+{
+
+  float totalCharge = 0;
+  return ShowerCentreFromHits(clockData, detProp, showerspcs, fmh, totalCharge);
+}
+
+TVector3
+shower::LArPandoraShowerAlg::ShowerCentre(detinfo::DetectorClocksData const& clockData,
+                                          detinfo::DetectorPropertiesData const& detProp,
+                                          std::vector<art::Ptr<recob::SpacePoint>> const& showersps,
+                                          art::FindManyP<recob::Hit> const& fmh,
+                                          float& totalCharge) const
+{
+  return ShowerCentreFromHits(clockData, detProp, showersps, fmh, totalCharge);
+}
+
+TVector3
+shower::LArPandoraShowerAlg::ShowerCentre(
+  detinfo::DetectorClocksData const& clockData,
+  detinfo::DetectorPropertiesData const& detProp,
+  std::vector<art::Ptr<recob::SpacePoint>> const& showersps,
+  reco::shower::ShowerAssociationView<recob::Hit> const& fmh,
+  float& totalCharge) const
+{
+  return ShowerCentreFromHits(clockData, detProp, showersps, fmh, totalCharge);
+}
+
+TVector3
+shower::LArPandoraShowerAlg::ShowerCentre(
+  reco::shower::ShowerSpacePointTable const& spacePointTable,
+  std::vector<art::Ptr<recob::SpacePoint>> const& showersps) const
+{
+
+  float totalCharge = 0;
+  return shower::LArPandoraShowerAlg::ShowerCentre(spacePointTable, showersps, totalCharge);
+}
+
+//Returns the vector to the shower centre and the total charge of the shower, using the
+//spacepoint charges precomputed in the event table.
+TVector3
+shower::LArPandoraShowerAlg::ShowerCentre(
+  reco::shower::ShowerSpacePointTable const& spacePointTable,
+  std::vector<art::Ptr<recob::SpacePoint>> const& showersps,
+  float& totalCharge) const
+{
+
+  TVector3 chargePoint = TVector3(0, 0, 0);
+
+  //Loop over the spacepoints and get the charge weighted center.
+  for (auto const& sp : showersps) {
+
+    float charge = fUseCollectionOnly ? spacePointTable.GetCollectionCharge(sp.key()) :
+                                        spacePointTable.GetTruncatedCharge(sp.key());
+
+    if (!fUseCollectionOnly && std::isnan(charge)) {
+      mf::LogWarning("LArPandoraShowerAlg") << "no points used to make the charge value. \n";
+    }
+
+    chargePoint += charge * spacePointTable.GetPosition(sp.key());
+    totalCharge += charge;
+
+    if (charge == 0) {
+      mf::LogWarning("LArPandoraShowerAlg") << "Averaged charge, within 2 sigma, for a spacepoint "
+                                               "is zero, Maybe this not a good method. \n";
+    }
+  }
+
+  double intotalcharge = 1 / totalCharge;
+  TVector3 centre = chargePoint * intotalcharge;
+  return centre;
+}
+
 //Return the spacepoint position in 3D cartesian coordinates.
 TVector3
 shower::LArPandoraShowerAlg::SpacePointPosition(art::Ptr<recob::SpacePoint> const& sp) const
@@ -308,15 +388,16 @@ shower::LArPandoraShowerAlg::DistanceBetweenSpacePoints(
 }
 
 //Return the charge of the spacepoint in ADC.
+template <class HitAssociation>
 double
-shower::LArPandoraShowerAlg::SpacePointCharge(art::Ptr<recob::SpacePoint> const& sp,
-                                              art::FindManyP<recob::Hit> const& fmh) const
+shower::LArPandoraShowerAlg::SpacePointChargeFromHits(art::Ptr<recob::SpacePoint> const& sp,
+                                                      HitAssociation const& fmh) const
 {
 
   double Charge = 0;
 
   //Average over the charge even though there is only one
-  std::vector<art::Ptr<recob::Hit>> const& hits = fmh.at(sp.key());
+  auto const& hits = fmh.at(sp.key());
   for (auto const& hit : hits) {
     Charge += hit->Integral();
   }
@@ -326,16 +407,32 @@ shower::LArPandoraShowerAlg::SpacePointCharge(art::Ptr<recob::SpacePoint> const&
   return Charge;
 }
 
+double
+shower::LArPandoraShowerAlg::SpacePointCharge(art::Ptr<recob::SpacePoint> const& sp,
+                                              art::FindManyP<recob::Hit> const& fmh) const
+{
+  return SpacePointChargeFromHits(sp, fmh);
+}
+
+double
+shower::LArPandoraShowerAlg::SpacePointCharge(
+  art::Ptr<recob::SpacePoint> const& sp,
+  reco::shower::ShowerAssociationView<recob::Hit> const& fmh) const
+{
+  return SpacePointChargeFromHits(sp, fmh);
+}
+
 //Return the spacepoint time.
+template <class HitAssociation>
 double
-shower::LArPandoraShowerAlg::SpacePointTime(art::Ptr<recob::SpacePoint> const& sp,
-                                            art::FindManyP<recob::Hit> const& fmh) const
+shower::LArPandoraShowerAlg::SpacePointTimeFromHits(art::Ptr<recob::SpacePoint> const& sp,
+                                                    HitAssociation const& fmh) const
 {
 
   double Time = 0;
 
   //Average over the hits
-  std::vector<art::Ptr<recob::Hit>> const& hits = fmh.at(sp.key());
+  auto const& hits = fmh.at(sp.key());
   for (auto const& hit : hits) {
     Time += hit->PeakTime();
   }
@@ -344,6 +441,21 @@ shower::LArPandoraShowerAlg::SpacePointTime(art::Ptr<recob::SpacePoint> const& s
   return Time;
 }
 
+double
+shower::LArPandoraShowerAlg::SpacePointTime(art::Ptr<recob::SpacePoint> const& sp,
+                                            art::FindManyP<recob::Hit> const& fmh) const
+{
+  return SpacePointTimeFromHits(sp, fmh);
+}
+
+double
+shower::LArPandoraShowerAlg::SpacePointTime(
+  art::Ptr<recob::SpacePoint> const& sp,
+  reco::shower::ShowerAssociationView<recob::Hit> const& fmh) const
+{
+  return SpacePointTimeFromHits(sp, fmh);
+}
+
 //Return the cooordinates of the hit in cm in wire direction and x.
 TVector2
 shower::LArPandoraShowerAlg::HitCoordinates(detinfo::DetectorPropertiesData const& detProp,
@@ -484,6 +596,184 @@ shower::LArPandoraShowerAlg::CalculateRMS(const std::vector<float>& perps) const
   return std::sqrt(sum / (perps.size() - 1));
 }
 
+void
+shower::LArPandoraShowerAlg::PCAAccumulator::Add(const double x,
+                                                 const double y,
+                                                 const double z,
+                                                 const double weight)
+{
+
+  const double pos[3] = {x, y, z};
+  ++fNumPoints;
+  fSumW += weight;
+  for (unsigned int i = 0; i < 3; ++i) {
+    fSumX[i] += weight * pos[i];
+    for (unsigned int j = i; j < 3; ++j) {
+      fSumXX[i][j] += weight * pos[i] * pos[j];
+    }
+  }
+}
+
+void
+shower::LArPandoraShowerAlg::PCAAccumulator::Add(TVector3 const& pos, const double weight)
+{
+  Add(pos.X(), pos.Y(), pos.Z(), weight);
+}
+
+void
+shower::LArPandoraShowerAlg::PCAAccumulator::Merge(PCAAccumulator const& other)
+{
+
+  fNumPoints += other.fNumPoints;
+  fSumW += other.fSumW;
+  for (unsigned int i = 0; i < 3; ++i) {
+    fSumX[i] += other.fSumX[i];
+    for (unsigned int j = i; j < 3; ++j) {
+      fSumXX[i][j] += other.fSumXX[i][j];
+    }
+  }
+}
+
+TVector3
+shower::LArPandoraShowerAlg::PCAAccumulator::GetMean() const
+{
+
+  if (fSumW == 0) return TVector3{0, 0, 0};
+  return TVector3{fSumX[0] / fSumW, fSumX[1] / fSumW, fSumX[2] / fSumW};
+}
+
+void
+shower::LArPandoraShowerAlg::PCAAccumulator::GetSecondMoments(double moments[3][3]) const
+{
+
+  for (unsigned int i = 0; i < 3; ++i) {
+    for (unsigned int j = i; j < 3; ++j) {
+      moments[i][j] = fSumW == 0 ? 0 : fSumXX[i][j] / fSumW;
+      moments[j][i] = moments[i][j];
+    }
+  }
+}
+
+void
+shower::LArPandoraShowerAlg::PCAAccumulator::GetCovariance(double covariance[3][3]) const
+{
+
+  GetSecondMoments(covariance);
+  if (fSumW == 0) return;
+
+  const double mean[3] = {fSumX[0] / fSumW, fSumX[1] / fSumW, fSumX[2] / fSumW};
+  for (unsigned int i = 0; i < 3; ++i) {
+    for (unsigned int j = i; j < 3; ++j) {
+      covariance[i][j] -= mean[i] * mean[j];
+      covariance[j][i] = covariance[i][j];
+    }
+  }
+}
+
+shower::LArPandoraShowerAlg::PCAResult
+shower::LArPandoraShowerAlg::PrincipalComponents(PCAAccumulator const& accumulator,
+                                                 const bool aboutMean) const
+{
+
+  double matrix[3][3];
+  if (aboutMean) { accumulator.GetCovariance(matrix); }
+  else {
+    accumulator.GetSecondMoments(matrix);
+  }
+  return SymmetricEigenDecomposition(matrix);
+}
+
+//Eigenvalues from the trigonometric solution of the characteristic cubic. The eigenvector of the
+//best separated eigenvalue comes from the cross products of the rows of (A - lambda I), the other
+//two from a Jacobi rotation in the plane perpendicular to it, so degenerate cases stay orthonormal.
+shower::LArPandoraShowerAlg::PCAResult
+shower::LArPandoraShowerAlg::SymmetricEigenDecomposition(const double matrix[3][3])
+{
+
+  PCAResult result;
+
+  const double a00 = matrix[0][0], a11 = matrix[1][1], a22 = matrix[2][2];
+  const double a01 = matrix[0][1], a02 = matrix[0][2], a12 = matrix[1][2];
+
+  const double q = (a00 + a11 + a22) / 3.;
+  const double b00 = a00 - q, b11 = a11 - q, b22 = a22 - q;
+  const double p2 = b00 * b00 + b11 * b11 + b22 * b22 + 2. * (a01 * a01 + a02 * a02 + a12 * a12);
+
+  //A multiple of the identity, every direction is an eigenvector
+  if (p2 <= 0 || !std::isfinite(p2)) {
+    for (unsigned int i = 0; i < 3; ++i) {
+      result.eigenValues[i] = q;
+      result.eigenVectors[i] = TVector3{i == 0 ? 1. : 0., i == 1 ? 1. : 0., i == 2 ? 1. : 0.};
+    }
+    return result;
+  }
+
+  const double p = std::sqrt(p2 / 6.);
+  const double detB = b00 * (b11 * b22 - a12 * a12) - a01 * (a01 * b22 - a12 * a02) +
+                      a02 * (a01 * a12 - b11 * a02);
+  const double r = std::clamp(detB / (2. * p * p * p), -1., 1.);
+  const double phi = std::acos(r) / 3.;
+
+  result.eigenValues[0] = q + 2. * p * std::cos(phi);
+  result.eigenValues[2] = q + 2. * p * std::cos(phi + 2. * TMath::Pi() / 3.);
+  result.eigenValues[1] = 3. * q - result.eigenValues[0] - result.eigenValues[2];
+
+  //Start from the eigenvalue furthest from the middle one
+  const bool firstIsLargest = (result.eigenValues[0] - result.eigenValues[1]) >=
+                              (result.eigenValues[1] - result.eigenValues[2]);
+  const unsigned int first = firstIsLargest ? 0 : 2;
+  const double lambda = result.eigenValues[first];
+
+  const TVector3 row0{a00 - lambda, a01, a02};
+  const TVector3 row1{a01, a11 - lambda, a12};
+  const TVector3 row2{a02, a12, a22 - lambda};
+  const TVector3 crosses[3] = {row0.Cross(row1), row0.Cross(row2), row1.Cross(row2)};
+
+  unsigned int best = 0;
+  for (unsigned int i = 1; i < 3; ++i) {
+    if (crosses[i].Mag2() > crosses[best].Mag2()) best = i;
+  }
+  const TVector3 v = crosses[best].Mag2() > 0 ? crosses[best].Unit() : TVector3{1, 0, 0};
+
+  //Orthonormal basis of the plane perpendicular to v
+  const TVector3 u = v.Orthogonal().Unit();
+  const TVector3 w = v.Cross(u);
+
+  auto const quadratic = [&](TVector3 const& x, TVector3 const& y) {
+    return x.X() * (a00 * y.X() + a01 * y.Y() + a02 * y.Z()) +
+           x.Y() * (a01 * y.X() + a11 * y.Y() + a12 * y.Z()) +
+           x.Z() * (a02 * y.X() + a12 * y.Y() + a22 * y.Z());
+  };
+  const double m00 = quadratic(u, u);
+  const double m01 = quadratic(u, w);
+  const double m11 = quadratic(w, w);
+
+  //The rotation by theta gives the larger eigenvalue of the 2x2 block
+  const double theta = 0.5 * std::atan2(2. * m01, m00 - m11);
+  const double c = std::cos(theta);
+  const double s = std::sin(theta);
+  const TVector3 larger = c * u + s * w;
+  const TVector3 smaller = c * w - s * u;
+
+  if (firstIsLargest) {
+    result.eigenVectors[0] = v;
+    result.eigenVectors[1] = larger;
+    result.eigenVectors[2] = smaller;
+  }
+  else {
+    result.eigenVectors[0] = larger;
+    result.eigenVectors[1] = smaller;
+    result.eigenVectors[2] = v;
+  }
+
+  //Refine the eigenvalues with the Rayleigh quotients, which are more precise than the
+  //cubic solution when two eigenvalues are close
+  for (unsigned int i = 0; i < 3; ++i) {
+    result.eigenValues[i] = quadratic(result.eigenVectors[i], result.eigenVectors[i]);
+  }
+  return result;
+}
+
 double
 shower::LArPandoraShowerAlg::SCECorrectPitch(double const& pitch,
                                              TVector3 const& pos,
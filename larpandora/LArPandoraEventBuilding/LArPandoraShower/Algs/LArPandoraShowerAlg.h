@@ -21,10 +21,13 @@
 #include "lardataobj/RecoBase/Track.h"
 #include "larevt/SpaceCharge/SpaceCharge.h"
 #include "larevt/SpaceChargeServices/SpaceChargeService.h"
+#include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerAssociationView.hh"
 #include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerElementHolder.hh"
+#include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerSpacePointTable.hh"
 
 //C++ Includes
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <map>
 #include <vector>
@@ -52,8 +55,49 @@ namespace shower {
 
 class shower::LArPandoraShowerAlg {
 public:
+  //Accumulates the weighted first and second moments of a set of 3D points for a PCA.
+  //Fixed size, so it can be kept on the stack, and accumulators of subsets can be merged.
+  class PCAAccumulator {
+  public:
+    void Add(const double x, const double y, const double z, const double weight = 1);
+    void Add(TVector3 const& pos, const double weight = 1);
+    void Merge(PCAAccumulator const& other);
+
+    unsigned int GetNumPoints() const { return fNumPoints; }
+    double GetSumWeights() const { return fSumW; }
+
+    //Weighted mean of the points
+    TVector3 GetMean() const;
+
+    //Weighted second moments about the origin, normalised by the sum of weights
+    void GetSecondMoments(double moments[3][3]) const;
+
+    //Weighted covariance about the mean, normalised by the sum of weights
+    void GetCovariance(double covariance[3][3]) const;
+
+  private:
+    unsigned int fNumPoints = 0;
+    double fSumW = 0;
+    double fSumX[3] = {0, 0, 0};
+    double fSumXX[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
+  };
+
+  //Eigenvalues sorted from largest to smallest with their unit eigenvectors.
+  struct PCAResult {
+    double eigenValues[3];
+    TVector3 eigenVectors[3];
+  };
+
   explicit LArPandoraShowerAlg(const fhicl::ParameterSet& pset);
 
+  //PCA of the points in the accumulator, either about their mean or about the origin
+  //(for points that have already been centred).
+  PCAResult PrincipalComponents(PCAAccumulator const& accumulator,
+                                const bool aboutMean = true) const;
+
+  //Closed form eigen decomposition of a symmetric 3x3 matrix.
+  static PCAResult SymmetricEigenDecomposition(const double matrix[3][3]);
+
   void OrderShowerHits(detinfo::DetectorPropertiesData const& detProp,
                        std::vector<art::Ptr<recob::Hit>>& hits,
                        TVector3 const& ShowerDirection,
@@ -83,6 +127,24 @@ public:
                         std::vector<art::Ptr<recob::SpacePoint>> const& showerspcs,
                         art::FindManyP<recob::Hit> const& fmh) const;
 
+  TVector3 ShowerCentre(detinfo::DetectorClocksData const& clockData,
+                        detinfo::DetectorPropertiesData const& detProp,
+                        std::vector<art::Ptr<recob::SpacePoint>> const& showersps,
+                        reco::shower::ShowerAssociationView<recob::Hit> const& fmh,
+                        float& totalCharge) const;
+
+  TVector3 ShowerCentre(detinfo::DetectorClocksData const& clockData,
+                        detinfo::DetectorPropertiesData const& detProp,
+                        std::vector<art::Ptr<recob::SpacePoint>> const& showerspcs,
+                        reco::shower::ShowerAssociationView<recob::Hit> const& fmh) const;
+
+  TVector3 ShowerCentre(reco::shower::ShowerSpacePointTable const& spacePointTable,
+                        std::vector<art::Ptr<recob::SpacePoint>> const& showersps,
+                        float& totalCharge) const;
+
+  TVector3 ShowerCentre(reco::shower::ShowerSpacePointTable const& spacePointTable,
+                        std::vector<art::Ptr<recob::SpacePoint>> const& showersps) const;
+
   TVector3 SpacePointPosition(art::Ptr<recob::SpacePoint> const& sp) const;
 
   double DistanceBetweenSpacePoints(art::Ptr<recob::SpacePoint> const& sp_a,
@@ -91,9 +153,15 @@ public:
   double SpacePointCharge(art::Ptr<recob::SpacePoint> const& sp,
                           art::FindManyP<recob::Hit> const& fmh) const;
 
+  double SpacePointCharge(art::Ptr<recob::SpacePoint> const& sp,
+                          reco::shower::ShowerAssociationView<recob::Hit> const& fmh) const;
+
   double SpacePointTime(art::Ptr<recob::SpacePoint> const& sp,
                         art::FindManyP<recob::Hit> const& fmh) const;
 
+  double SpacePointTime(art::Ptr<recob::SpacePoint> const& sp,
+                        reco::shower::ShowerAssociationView<recob::Hit> const& fmh) const;
+
   TVector2 HitCoordinates(detinfo::DetectorPropertiesData const& detProp,
                           art::Ptr<recob::Hit> const& hit) const;
 
@@ -136,6 +204,22 @@ public:
                 std::string const& evd_disp_name_append = "") const;
 
 private:
+  //Shared by the art::FindManyP and ShowerAssociationView forms of the public functions.
+  template <class HitAssociation>
+  TVector3 ShowerCentreFromHits(detinfo::DetectorClocksData const& clockData,
+                                detinfo::DetectorPropertiesData const& detProp,
+                                std::vector<art::Ptr<recob::SpacePoint>> const& showersps,
+                                HitAssociation const& fmh,
+                                float& totalCharge) const;
+
+  template <class HitAssociation>
+  double SpacePointChargeFromHits(art::Ptr<recob::SpacePoint> const& sp,
+                                  HitAssociation const& fmh) const;
+
+  template <class HitAssociation>
+  double SpacePointTimeFromHits(art::Ptr<recob::SpacePoint> const& sp,
+                                HitAssociation const& fmh) const;
+
   bool fUseCollectionOnly;
   art::InputTag fPFParticleLabel;
   bool fSCEXFlip; // If a (legacy) flip is needed in x componant of spatial SCE correction
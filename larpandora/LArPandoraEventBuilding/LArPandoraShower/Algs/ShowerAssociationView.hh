@@ -0,0 +1,164 @@
+//###################################################################
+//### Name:        ShowerAssociationView                          ###
+//### Description: Per event view of an association, laid out as  ###
+//###              one offset array over the keys of the first    ###
+//###              collection and one array of the associated     ###
+//###              Ptrs. Lookups return non-owning spans so no    ###
+//###              vectors are made per key. Built once per event ###
+//###              by the ShowerElementHolder and shared by the   ###
+//###              module and tools of LArPandoraModularShower.   ###
+//###################################################################
+
+#ifndef ShowerAssociationView_HH
+#define ShowerAssociationView_HH
+
+//Framework includes
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "cetlib_except/exception.h"
+
+//C++ Inlcudes
+#include <numeric>
+#include <vector>
+
+namespace reco::shower {
+  class ShowerAssociationViewBase;
+  template <class T> class ShowerAssociationSpan;
+  template <class T> class ShowerAssociationView;
+}
+
+//Non-owning range over a contiguous block of the view. Only valid for the event the view was built in.
+template <class T>
+class reco::shower::ShowerAssociationSpan {
+
+  public:
+
+    ShowerAssociationSpan(const T* First, const T* Last):
+      first(First), last(Last){
+      }
+
+    const T* begin() const { return first; }
+    const T* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+
+    const T& operator[](const size_t i) const { return first[i]; }
+    const T& front() const { return *first; }
+    const T& back() const { return *(last - 1); }
+
+    const T& at(const size_t i) const {
+      if(i >= size()){
+        throw cet::exception("ShowerAssociationSpan") << "Index " << i << " out of range " << size() << std::endl;
+      }
+      return first[i];
+    }
+
+    //Copy into a vector, for the functions that need to own or reorder the elements.
+    std::vector<T> ToVector() const {
+      return std::vector<T>(first, last);
+    }
+
+  private:
+
+    const T* first;
+    const T* last;
+};
+
+//Base class so the holder can keep views of any type.
+class reco::shower::ShowerAssociationViewBase {
+
+  public:
+
+    virtual ~ShowerAssociationViewBase() noexcept = default;
+};
+
+//View of the objects of type T associated to each element of a collection. The entries of a key are in the
+//order they appear in the art::Assns, the same order art::FindManyP gives.
+template <class T>
+class reco::shower::ShowerAssociationView : public reco::shower::ShowerAssociationViewBase {
+
+  public:
+
+    //Tag to build the view from an association stored the other way round, as art::FindManyP allows.
+    struct Reversed {};
+
+    //Build the view for the nKeys elements of the collection with product ID keyID. Association entries for
+    //other collections are ignored, as art::FindManyP does.
+    template <class L, class D>
+      ShowerAssociationView(const size_t nKeys, const art::ProductID& keyID, const art::Assns<L,T,D>& assns){
+        Fill(nKeys, keyID, assns,
+            [](auto const& assn) -> auto const& { return assn.first; },
+            [](auto const& assn) -> auto const& { return assn.second; });
+      }
+
+    //Build the view from an association whose left side is T and whose right side is the keyed collection.
+    template <class R, class D>
+      ShowerAssociationView(const size_t nKeys, const art::ProductID& keyID, const art::Assns<T,R,D>& assns, Reversed){
+        Fill(nKeys, keyID, assns,
+            [](auto const& assn) -> auto const& { return assn.second; },
+            [](auto const& assn) -> auto const& { return assn.first; });
+      }
+
+    //Number of keys in the collection.
+    size_t size() const {
+      return offsets.size() - 1;
+    }
+
+    //Ptrs associated to the element with this key.
+    ShowerAssociationSpan<art::Ptr<T> > at(const size_t key) const {
+      CheckKey(key);
+      return ShowerAssociationSpan<art::Ptr<T> >(ptrs.data() + offsets[key], ptrs.data() + offsets[key + 1]);
+    }
+
+    //Keys in their own collection of the objects associated to the element with this key.
+    ShowerAssociationSpan<size_t> keysAt(const size_t key) const {
+      CheckKey(key);
+      return ShowerAssociationSpan<size_t>(keys.data() + offsets[key], keys.data() + offsets[key + 1]);
+    }
+
+  private:
+
+    template <class Assns, class KeyPtr, class ValuePtr>
+      void Fill(const size_t nKeys, const art::ProductID& keyID, const Assns& assns, KeyPtr&& keyPtr, ValuePtr&& valuePtr){
+
+        //Count the entries of each key, then turn the counts into offsets
+        offsets.assign(nKeys + 1, 0);
+        for(auto const& assn: assns){
+          auto const& key = keyPtr(assn);
+          if(key.id() != keyID) continue;
+          if(key.key() >= nKeys){
+            throw cet::exception("ShowerAssociationView") << "Association key " << key.key() << " out of range " << nKeys << std::endl;
+          }
+          ++offsets[key.key() + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        //Fill the Ptrs and their keys in place
+        ptrs.resize(offsets.back());
+        keys.resize(offsets.back());
+        std::vector<size_t> cursors(offsets.begin(), offsets.end() - 1);
+        for(auto const& assn: assns){
+          auto const& key = keyPtr(assn);
+          if(key.id() != keyID) continue;
+          const size_t entry = cursors[key.key()]++;
+          ptrs[entry] = valuePtr(assn);
+          keys[entry] = ptrs[entry].key();
+        }
+      }
+
+    void CheckKey(const size_t key) const {
+      if(key >= size()){
+        throw cet::exception("ShowerAssociationView") << "Key " << key << " out of range " << size() << std::endl;
+      }
+    }
+
+    //Start of the entries of each key, with the total at the end.
+    std::vector<size_t> offsets;
+
+    //Associated Ptrs and their keys, grouped by key.
+    std::vector<art::Ptr<T> > ptrs;
+    std::vector<size_t> keys;
+};
+
+#endif
@@ -0,0 +1,115 @@
+//###################################################################
+//### Name:        ShowerCalorimetryContext                       ###
+//### Description: Per event detector data used by the shower     ###
+//###              energy and dEdx tools. Built once per event by ###
+//###              the ShowerElementHolder and shared between the ###
+//###              showers so the tools do not each ask the       ###
+//###              services again. Used in LArPandoraModularShower###
+//###              and the corresponding tools.                   ###
+//###################################################################
+
+#ifndef ShowerCalorimetryContext_HH
+#define ShowerCalorimetryContext_HH
+
+//Framework includes
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "canvas/Persistency/Common/Ptr.h"
+
+//LArSoft Includes
+#include "lardata/DetectorInfoServices/DetectorClocksService.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "lardataalg/DetectorInfo/DetectorClocksData.h"
+#include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
+#include "lardataobj/RecoBase/Hit.h"
+
+//C++ Inlcudes
+#include <cmath>
+#include <vector>
+
+namespace reco::shower {
+  class ShowerCalorimetryContext;
+}
+
+class reco::shower::ShowerCalorimetryContext {
+
+  public:
+
+    explicit ShowerCalorimetryContext(const art::Event& evt):
+      clockData(art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(evt)),
+      detProp(art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(evt, clockData)),
+      samplingRate(sampling_rate(clockData)),
+      lifetime(detProp.ElectronLifetime() * 1e3),
+      driftVelocity(detProp.DriftVelocity(detProp.Efield(), detProp.Temperature())),
+      tickPeriod(sampling_rate(clockData) * 1.e-3),
+      triggerOffset(trigger_offset(clockData)),
+      lifetimeMicroseconds(detProp.ElectronLifetime()){
+      }
+
+    ShowerCalorimetryContext(const ShowerCalorimetryContext&) = delete;
+    ShowerCalorimetryContext& operator=(const ShowerCalorimetryContext&) = delete;
+
+    const detinfo::DetectorClocksData& GetClockData() const {
+      return clockData;
+    }
+
+    const detinfo::DetectorPropertiesData& GetDetProp() const {
+      return detProp;
+    }
+
+    //Drift velocity at the nominal field and temperature.
+    double GetDriftVelocity() const {
+      return driftVelocity;
+    }
+
+    //Lifetime correction for a hit at the given peak time, exp(sampling rate * time / lifetime).
+    //Same expression as used inline in the tools so the values do not change.
+    double LifetimeCorrection(const double time) const {
+      return std::exp((samplingRate * time) / lifetime);
+    }
+
+    //Lifetime correction for a hit at the given peak time, counting the time from the trigger. Same steps as the
+    //exponential form of calo::CalorimetryAlg::LifetimeCorrection with no T0, so the values do not change.
+    double TriggerTimeLifetimeCorrection(const double time) const {
+      float ticks = time;
+      ticks -= triggerOffset;
+      return std::exp((ticks * tickPeriod) / lifetimeMicroseconds);
+    }
+
+    //Sum of the lifetime corrected integrals of the hits.
+    double LifetimeCorrectedCharge(const std::vector<art::Ptr<recob::Hit> >& hits) const {
+      return CorrectedCharge(hits, [this](const double time){ return LifetimeCorrection(time); });
+    }
+
+    //Sum of the integrals of the hits corrected for the lifetime from the trigger time.
+    double TriggerTimeLifetimeCorrectedCharge(const std::vector<art::Ptr<recob::Hit> >& hits) const {
+      return CorrectedCharge(hits, [this](const double time){ return TriggerTimeLifetimeCorrection(time); });
+    }
+
+    //Sum of the integrals of the hits, each scaled by the given correction of its peak time.
+    template <class Correction>
+      double CorrectedCharge(const std::vector<art::Ptr<recob::Hit> >& hits, Correction&& correction) const {
+        double totalCharge = 0;
+        for(const art::Ptr<recob::Hit>& hit: hits){
+          totalCharge += hit->Integral() * correction(hit->PeakTime());
+        }
+        return totalCharge;
+      }
+
+  private:
+
+    const detinfo::DetectorClocksData     clockData;
+    const detinfo::DetectorPropertiesData detProp;
+
+    //Constants of the lifetime correction and drift.
+    const double samplingRate;
+    const double lifetime;
+    const double driftVelocity;
+
+    //Constants of the lifetime correction from the trigger time, in microseconds.
+    const double tickPeriod;
+    const double triggerOffset;
+    const double lifetimeMicroseconds;
+};
+
+#endif
@@ -11,10 +11,16 @@
 #define ShowerElementHolder_HH
 
 //Framework includes
+#include "art/Framework/Principal/Handle.h"
 #include "canvas/Persistency/Common/FindOneP.h"
 #include "canvas/Persistency/Common/FindManyP.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+//LArSoft Includes
+#include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerAssociationView.hh"
+#include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerCalorimetryContext.hh"
+#include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerSpacePointTable.hh"
+
 //C++ Inlcudes
 #include <iostream>
 #include <map>
@@ -469,6 +475,8 @@ class reco::shower::ShowerElementHolder{
       for(auto const& eventdataproduct: eventdataproducts){
         (eventdataproduct.second)->Clear();
       }
+      calorimetrycontext.reset();
+      associationviews.clear();
     }
     //Clear all the shower properties. This does not delete the element.
     void ClearAll(){
@@ -638,6 +646,58 @@ class reco::shower::ShowerElementHolder{
         }
       }
 
+    //Get the view of the T1 objects associated to each element of the collection in handle. Made on the first
+    //call in the event and shared by the module and all the tools. Unlike GetFindManyP the lookups return spans
+    //into the view rather than vectors.
+    template <class T1, class T2>
+      const reco::shower::ShowerAssociationView<T1>& GetAssociationView(const art::ValidHandle<std::vector<T2> >& handle,
+          const art::Event& evt, const art::InputTag& moduleTag){
+
+        const std::string name("AV_" + moduleTag.label() + "_" + getType<T1>() + "_" + getType<T2>());
+
+        auto associationViewsIt = associationviews.find(name);
+        if (associationViewsIt == associationviews.end()){
+          //Use the association in whichever direction it was stored
+          art::Handle<art::Assns<T2,T1> > assnsHandle;
+          std::unique_ptr<reco::shower::ShowerAssociationView<T1> > view;
+          if (evt.getByLabel(moduleTag, assnsHandle)){
+            view = std::make_unique<reco::shower::ShowerAssociationView<T1> >(handle->size(), handle.id(), *assnsHandle);
+          } else {
+            auto const& assns = *evt.getValidHandle<art::Assns<T1,T2> >(moduleTag);
+            view = std::make_unique<reco::shower::ShowerAssociationView<T1> >(handle->size(), handle.id(), assns,
+                typename reco::shower::ShowerAssociationView<T1>::Reversed());
+          }
+          associationViewsIt = associationviews.emplace(name, std::move(view)).first;
+        }
+        return static_cast<const reco::shower::ShowerAssociationView<T1>&>(*associationViewsIt->second);
+      }
+
+    //Get the spacepoint feature table for the event. The first tool that asks for it fills it and the following
+    //calls return the same table, so events and configurations that never read it do not build it.
+    const reco::shower::ShowerSpacePointTable& GetSpacePointTable(const art::ValidHandle<std::vector<recob::SpacePoint> >& handle,
+        const art::Event& evt, const art::InputTag& moduleTag,
+        const detinfo::DetectorClocksData& clockData, const detinfo::DetectorPropertiesData& detProp){
+
+      const std::string name("SPT_" + moduleTag.label());
+
+      if (CheckEventElement(name)){
+        return GetEventElement<reco::shower::ShowerSpacePointTable>(name);
+      }
+
+      const reco::shower::ShowerAssociationView<recob::Hit>& spHits = GetAssociationView<recob::Hit>(handle, evt, moduleTag);
+      reco::shower::ShowerSpacePointTable spacePointTable(*handle, spHits, clockData, detProp);
+      SetEventElement(spacePointTable, name);
+      return GetEventElement<reco::shower::ShowerSpacePointTable>(name);
+    }
+
+    //Get the detector data for the calorimetry of this event. Made on the first call and shared by all the showers.
+    const reco::shower::ShowerCalorimetryContext& GetCalorimetryContext(const art::Event& evt){
+      if (!calorimetrycontext){
+        calorimetrycontext = std::make_unique<reco::shower::ShowerCalorimetryContext>(evt);
+      }
+      return *calorimetrycontext;
+    }
+
   private:
 
     //Storage for all the shower properties.
@@ -649,6 +709,12 @@ class reco::shower::ShowerElementHolder{
     //Storage for all the data products
     std::map<std::string,std::unique_ptr<reco::shower::ShowerElementBase> > eventdataproducts;
 
+    //Detector data for the calorimetry of the event.
+    std::unique_ptr<reco::shower::ShowerCalorimetryContext> calorimetrycontext;
+
+    //Association views of the event.
+    std::map<std::string,std::unique_ptr<reco::shower::ShowerAssociationViewBase> > associationviews;
+
     //Shower ID number. Use this to set ptr makers.
     int showernumber;
 
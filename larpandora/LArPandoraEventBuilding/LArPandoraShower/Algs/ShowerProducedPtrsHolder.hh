@@ -13,14 +13,19 @@
 
 //Framework includes
 #include "art/Framework/Principal/Event.h"
+#include "art/Persistency/Common/PtrMaker.h"
 #include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerElementHolder.hh"
 
+//C++ Inlcudes
+#include <optional>
+
 namespace reco::shower {
   class ShowerUniqueProduerPtrBase;
   template <class T> class ShowerUniqueProductPtr;
   template <class T> class ShowerUniqueAssnPtr;
   class ShowerPtrMakerBase;
   template <class T> class ShowerPtrMaker;
+  template <class T> class ShowerProducedPtrHandle;
   class ShowerProducedPtrsHolder;
 }
 
@@ -45,6 +50,8 @@ class reco::shower::ShowerUniqueProduerPtrBase {
 
     virtual void reset() = 0;
 
+    virtual void reserve(const size_t n) {}
+
     virtual void AddDataProduct(const reco::shower::ShowerElementHolder& selement_holder, const std::string& Name) = 0;
 
     virtual void MoveToEvent(art::Event& evt) = 0;
@@ -55,7 +62,7 @@ class reco::shower::ShowerUniqueProduerPtrBase {
     virtual int GetVectorPtrSize() const {return -1;}
 };
 
-//Class that holds a unique ptr for the product. This is what is stored in the map. The product is put into
+//Class that holds a unique ptr for the product. This is what is stored in the holder. The product is put into
 //the event as a vector so the this holder maintains this unique ptr and the actions to manipulate it.
 template <class T>
 class reco::shower::ShowerUniqueProductPtr<std::vector<T> >: public reco::shower::ShowerUniqueProduerPtrBase{
@@ -66,10 +73,11 @@ class reco::shower::ShowerUniqueProductPtr<std::vector<T> >: public reco::shower
       ptr = 1;
       showeruniqueptr = std::make_unique<std::vector<T> >();
       InstanceName = Instancename;
+      reservedSize = 0;
     }
 
     //Get the unique ptr for the data product.
-    std::unique_ptr<T>& GetPtr() {
+    std::unique_ptr<std::vector<T> >& GetPtr() {
       if(ptr){
         return showeruniqueptr;
       }
@@ -78,8 +86,16 @@ class reco::shower::ShowerUniqueProductPtr<std::vector<T> >: public reco::shower
       }
     }
 
+    //The product was moved into the event, start the next one with the same capacity.
     void reset() override {
-      showeruniqueptr.reset(new std::vector<T>());
+      showeruniqueptr = std::make_unique<std::vector<T> >();
+      showeruniqueptr->reserve(reservedSize);
+    }
+
+    //Reserve space for n showers.
+    void reserve(const size_t n) override {
+      reservedSize = n;
+      showeruniqueptr->reserve(n);
     }
 
     //Add a data product on to the vector that will be added to the event.
@@ -95,11 +111,11 @@ class reco::shower::ShowerUniqueProductPtr<std::vector<T> >: public reco::shower
         mf::LogError("ShowerProducedPtrsHolder") << "Trying to add data product: " << Name << ". This element does not exist in the element holder" << std::endl;
         return;
       }
-      showeruniqueptr->push_back(product);
+      showeruniqueptr->push_back(std::move(product));
       return;
     }
 
-    //Final thing to do move to the event.
+    //Final thing to do move to the event. Only the unique ptr is moved, the product is not copied.
     void MoveToEvent(art::Event& evt) override {
       evt.put(std::move(showeruniqueptr),InstanceName);
     }
@@ -130,10 +146,13 @@ class reco::shower::ShowerUniqueProductPtr<std::vector<T> >: public reco::shower
 
     //Name when saved into the the event default is ""
     std::string InstanceName;
+
+    //Capacity to reserve each event.
+    size_t reservedSize;
 };
 
 
-//Class that holds a unique ptr for the association. This is what is stored in the map. The association is put into
+//Class that holds a unique ptr for the association. This is what is stored in the holder. The association is put into
 //the event as a vector so the this holder maintains this unique ptr and the actions to manipulate it.
 //I guess if the product if a product is unique to the event then this holder will deal with it.
 //I have tried to be smart and I don't think it not being an association is a problem as
@@ -160,7 +179,7 @@ class reco::shower::ShowerUniqueAssnPtr: public reco::shower::ShowerUniqueProdue
     }
 
     void reset() override {
-      showeruniqueptr.reset(new T());
+      showeruniqueptr = std::make_unique<T>();
     }
 
     //place the association to the event.
@@ -223,65 +242,72 @@ class reco::shower::ShowerPtrMaker : public ShowerPtrMakerBase{
 
 
     ShowerPtrMaker(const std::string& Instancename){
-      ptrmaker = nullptr;
-      ptr = 0;
       InstanceName = Instancename;
     }
 
     //Check the ptr maker is ready to be used.
     bool CheckPtrMaker() const override {
-      if(ptr){
-        return true;
-      }
-      return false;
+      return ptrmaker.has_value();
     }
 
     //Return the ptr maker. Probably never needed.
     art::PtrMaker<T>& GetPtrMaker(){
-      if(ptr){
-        if(ptrmaker == nullptr){
-          throw cet::exception("ShowerPtrMaker") << "Ptr maker ptr is null" << std::endl;
-        }
-        return *ptrmaker;
+      if(!ptrmaker){
+        throw cet::exception("ShowerPtrMaker") << "Trying to get a  ptrmaker that does not exists" << std::endl;
       }
-      throw cet::exception("ShowerPtrMaker") << "Trying to get a  ptrmaker that does not exists" << std::endl;
+      return *ptrmaker;
     }
 
     //Return the art ptr that the module produces corresponding the index iter
     art::Ptr<T> GetArtPtr(int iter) const {
-      if(ptr){
-        if(ptrmaker == nullptr){
-          throw cet::exception("ShowerPtrMaker") << "Ptr maker ptr is null" << std::endl;
-        }
-        return (*ptrmaker)(iter);
+      if(!ptrmaker){
+        throw cet::exception("ShowerPtrMaker") << "Trying to get a  ptrmaker that does not exists" << std::endl;
       }
-      throw cet::exception("ShowerPtrMaker") << "Trying to get a  ptrmaker that does not exists" << std::endl;
+      return (*ptrmaker)(iter);
     }
 
-    //Set the ptr maker this is reset at the start of the event.
+    //Set the ptr maker this is reset at the start of the event. It is made in place.
     void SetPtrMaker(art::Event& evt) override {
-      ptrmaker.reset(new art::PtrMaker<T>(evt,InstanceName));
-      ptr = 1;
+      ptrmaker.emplace(evt,InstanceName);
     }
 
     void Reset() override {
-      if(!ptr){
+      if(!ptrmaker){
         throw cet::exception("ShowerPtrMaker") << "Trying to reset ptr but it has not been set in the first place. Please contatc Dom Barker" << std::endl;
       }
-      ptrmaker.reset(nullptr);
-      ptr = 0;
+      ptrmaker.reset();
     }
 
   private:
 
-    //The ptr maker itself. Used to make art::Ptrs to make assns.
-    std::unique_ptr<art::PtrMaker<T> > ptrmaker;
+    //The ptr maker itself. Used to make art::Ptrs to make assns. Empty until the event is set.
+    std::optional<art::PtrMaker<T> > ptrmaker;
 
     //The name of the data product which will be saved in the event. The ptr maker requires this.
     std::string InstanceName;
+};
 
-    //bool to tell if the ptr maker is ready to use or not.
-    int ptr;
+//Handle to a product or association in the ShowerProducedPtrsHolder. It is resolved from the name once, when
+//the producers are initialised, and then gives access to the product without a name lookup or a cast.
+template <class T>
+class reco::shower::ShowerProducedPtrHandle {
+
+  public:
+
+    ShowerProducedPtrHandle() = default;
+
+    bool IsValid() const {
+      return index >= 0;
+    }
+
+  private:
+
+    friend class reco::shower::ShowerProducedPtrsHolder;
+
+    explicit ShowerProducedPtrHandle(int Index): index(Index) {}
+
+    //Position of the product in the holder.
+    int index = -1;
 };
 
 //Class that holds all the unique ptrs and the ptr makers. It is what the tools and module use
@@ -291,14 +317,14 @@ class reco::shower::ShowerProducedPtrsHolder {
 
   public:
 
-    //Initialise the a unique ptr in the map. This will be added to the event.
+    //Initialise the a unique ptr in the holder. This will be added to the event. Returns the handle used to access it.
     template <class T>
-      int SetShowerUniqueProduerPtr(type<T>, const std::string& Name, const std::string& Instance=""){
+      ShowerProducedPtrHandle<T> SetShowerUniqueProduerPtr(type<T>, const std::string& Name, const std::string& Instance=""){
 
         //Add to the assns
-        if(showerassnPtrs.find(Name) != showerassnPtrs.end()){
+        if(showerassnIndices.find(Name) != showerassnIndices.end()){
           mf::LogWarning("ShowerProducedPtrsHolder") << "Trying to set Element: " << Name << ". This element has already been set. Please check." << std::endl;
-          return 1;
+          return GetHandle(type<T>(), Name);
         }
 
         //Check the same type has not already been set.
@@ -306,18 +332,19 @@ class reco::shower::ShowerProducedPtrsHolder {
           throw cet::exception("ShowerProducedPtrsHolder") << "Trying to set multiple objects with same type with no instance name or same instance name" << std::endl;
         }
 
-        showerassnPtrs[Name] = std::make_unique<ShowerUniqueAssnPtr<T> >(Instance);
-        return 0;
+        showerassnIndices[Name] = showerassnPtrs.size();
+        showerassnPtrs.push_back(std::make_unique<ShowerUniqueAssnPtr<T> >(Instance));
+        return ShowerProducedPtrHandle<T>(showerassnIndices[Name]);
       }
 
-    //Set the unique ptr. The unique ptr will be filled into the event.
+    //Set the unique ptr. The unique ptr will be filled into the event. Returns the handle used to access it.
     template <class T>
-      int SetShowerUniqueProduerPtr(type<std::vector<T> >, const std::string& Name, const std::string& Instance=""){
+      ShowerProducedPtrHandle<std::vector<T> > SetShowerUniqueProduerPtr(type<std::vector<T> >, const std::string& Name, const std::string& Instance=""){
 
         //Then add the products
-        if(showerproductPtrs.find(Name) != showerproductPtrs.end()){
+        if(showerproductIndices.find(Name) != showerproductIndices.end()){
           mf::LogWarning("ShowerProducedPtrsHolder") << "Trying to set Element: " << Name << ". This element has already been set. Please check." << std::endl;
-          return 1;
+          return GetHandle(type<std::vector<T> >(), Name);
         }
 
         //Check the same type has not already been set.
@@ -325,21 +352,45 @@ class reco::shower::ShowerProducedPtrsHolder {
           throw cet::exception("ShowerProducedPtrsHolder") << "Trying to set multiple objects with same type with no instance name or same instance name" << std::endl;
         }
 
-        if(showerPtrMakers.find(Name) != showerPtrMakers.end()){
-          throw cet::exception("ShowerProducedPtrsHolder") << "PtrMaker already exist. It should not be set again" << std::endl;
+        showerproductIndices[Name] = showerproductPtrs.size();
+        showerproductNames.push_back(Name);
+        showerPtrMakers.push_back(std::make_unique<ShowerPtrMaker<T> >(Instance));
+        showerproductPtrs.push_back(std::make_unique<ShowerUniqueProductPtr<std::vector<T > > >(Instance));
+        return ShowerProducedPtrHandle<std::vector<T> >(showerproductIndices[Name]);
+      }
+
+    //Resolve the handle of an association that has already been set. The type is checked here, once.
+    template <class T>
+      ShowerProducedPtrHandle<T> GetHandle(type<T>, const std::string& Name) const {
+        auto const showerassnIndicesIt = showerassnIndices.find(Name);
+        if(showerassnIndicesIt == showerassnIndices.end()){
+          throw cet::exception("ShowerProducedPtrsHolder") << "Trying to get the association: " << Name << " Element does not exist" << std::endl;
+        }
+        if(dynamic_cast<reco::shower::ShowerUniqueAssnPtr<T> *>(showerassnPtrs[showerassnIndicesIt->second].get()) == nullptr){
+          throw cet::exception("ShowerProducedPtrsHolder") << "Failed to cast back. Maybe you got the type wrong or you are accidently accessing a differently named product" << std::endl;
         }
-        showerPtrMakers[Name]   = std::make_unique<ShowerPtrMaker<T> >(Instance);
-        showerproductPtrs[Name] = std::make_unique<ShowerUniqueProductPtr<std::vector<T > > >(Instance);
-        return 0;
+        return ShowerProducedPtrHandle<T>(showerassnIndicesIt->second);
       }
 
+    //Resolve the handle of a product that has already been set. The type is checked here, once.
+    template <class T>
+      ShowerProducedPtrHandle<std::vector<T> > GetHandle(type<std::vector<T> >, const std::string& Name) const {
+        auto const showerproductIndicesIt = showerproductIndices.find(Name);
+        if(showerproductIndicesIt == showerproductIndices.end()){
+          throw cet::exception("ShowerProducedPtrsHolder") << "Product: " << Name << " has not been set in the producers map" << std::endl;
+        }
+        if(dynamic_cast<reco::shower::ShowerUniqueProductPtr<std::vector<T> > *>(showerproductPtrs[showerproductIndicesIt->second].get()) == nullptr){
+          throw cet::exception("ShowerProducedPtrsHolder") << "Failed to cast back. Maybe you got the type wrong or you are accidently accessing a differently named product" << std::endl;
+        }
+        return ShowerProducedPtrHandle<std::vector<T> >(showerproductIndicesIt->second);
+      }
 
     //Checks if the ptr exists
     bool CheckUniqueProduerPtr(const std::string& Name) const {
-      if(showerproductPtrs.find(Name) != showerproductPtrs.end()){
+      if(showerproductIndices.find(Name) != showerproductIndices.end()){
         return true;
       }
-      if(showerassnPtrs.find(Name) != showerassnPtrs.end()){
+      if(showerassnIndices.find(Name) != showerassnIndices.end()){
         return true;
       }
       return false;
@@ -348,10 +399,17 @@ class reco::shower::ShowerProducedPtrsHolder {
     //Reset the ptrs;
     void reset(){
       for(auto const& showerptr: showerproductPtrs){
-        (showerptr.second)->reset();
+        showerptr->reset();
       }
       for(auto const& showerptr: showerassnPtrs){
-        (showerptr.second)->reset();
+        showerptr->reset();
+      }
+    }
+
+    //Reserve space in the products for n showers, e.g. the number of PFParticles in the event.
+    void reserve(const size_t n){
+      for(auto const& showerptr: showerproductPtrs){
+        showerptr->reserve(n);
       }
     }
 
@@ -359,26 +417,26 @@ class reco::shower::ShowerProducedPtrsHolder {
     //This is done by matching strings in the element holder and the ptr holder. Hence these
     //must match. This is a global command done in the module.
     void AddDataProducts(const reco::shower::ShowerElementHolder& selement_holder){
-      for(auto const& showerproductPtr: showerproductPtrs){
-        (showerproductPtr.second)->AddDataProduct(selement_holder, showerproductPtr.first);
+      for(size_t productIter = 0; productIter < showerproductPtrs.size(); ++productIter){
+        showerproductPtrs[productIter]->AddDataProduct(selement_holder, showerproductNames[productIter]);
       }
     }
 
     //Global command to move all products into the event. This is done in the module.
     void MoveAllToEvent(art::Event& evt){
       for(auto const& showerproductPtr: showerproductPtrs){
-        (showerproductPtr.second)->MoveToEvent(evt);
+        showerproductPtr->MoveToEvent(evt);
       }
       for(auto const& showerassnPtr: showerassnPtrs){
-        (showerassnPtr.second)->MoveToEvent(evt);
+        showerassnPtr->MoveToEvent(evt);
       }
     }
 
     bool CheckAllProducedElements(reco::shower::ShowerElementHolder& selement_holder) const {
       bool checked = true;
-      for(auto const& showerproductPtr: showerproductPtrs){
-        if(showerproductPtr.first == "shower"){continue;}
-        checked *= selement_holder.CheckElement(showerproductPtr.first);
+      for(auto const& showerproductName: showerproductNames){
+        if(showerproductName == "shower"){continue;}
+        checked *= selement_holder.CheckElement(showerproductName);
       }
       return checked;
     }
@@ -386,121 +444,113 @@ class reco::shower::ShowerProducedPtrsHolder {
 
     //This returns the unique ptr. This is a legacy code.
     template <class T>
-      T& GetPtr(const std::string& Name){
-        auto const showerproductPtrsIt = showerproductPtrs.find(Name);
-        if(showerproductPtrsIt != showerproductPtrs.end()){
-          reco::shower::ShowerUniqueProductPtr<T>* prod = dynamic_cast<reco::shower::ShowerUniqueProductPtr<T> *>(showerproductPtrsIt->second.get());
-          return prod->GetPtr();
+      std::unique_ptr<T>& GetPtr(const std::string& Name){
+        if(showerproductIndices.find(Name) != showerproductIndices.end()){
+          return GetPtr(GetHandle(type<T>(), Name));
         }
-
-        auto const showerassnPtrsIt = showerassnPtrs.find(Name);
-        if(showerassnPtrsIt != showerassnPtrs.end()){
-          reco::shower::ShowerUniqueAssnPtr<T>* assn = dynamic_cast<reco::shower::ShowerUniqueAssnPtr<T> *>(showerassnPtrsIt->second.get());
-          return assn->GetPtr();
+        if(showerassnIndices.find(Name) != showerassnIndices.end()){
+          return GetPtr(GetHandle(type<T>(), Name));
         }
-
         throw cet::exception("ShowerProducedPtrsHolder") << "Trying to get Ptr for: " << Name << " but Element does not exist" << std::endl;
       }
 
+    //Return the unique ptr of an association through its handle.
+    template <class T>
+      std::unique_ptr<T>& GetPtr(const ShowerProducedPtrHandle<T>& handle){
+        return static_cast<reco::shower::ShowerUniqueAssnPtr<T> *>(showerassnPtrs.at(handle.index).get())->GetPtr();
+      }
+
+    //Return the unique ptr of a product through its handle.
+    template <class T>
+      std::unique_ptr<std::vector<T> >& GetPtr(const ShowerProducedPtrHandle<std::vector<T> >& handle){
+        return static_cast<reco::shower::ShowerUniqueProductPtr<std::vector<T> > *>(showerproductPtrs.at(handle.index).get())->GetPtr();
+      }
+
     //Wrapper so that the use the addSingle command for the association. Add A and B to the association just
     //as if add single add.
     template <class T, class A, class B>
       void AddSingle(A& a, B& b, const std::string& Name){
-        auto const showerassnPtrsIt = showerassnPtrs.find(Name);
-        if(showerassnPtrsIt == showerassnPtrs.end()){
-          throw cet::exception("ShowerProducedPtrsHolder") << "Trying to get the association: " << Name << "Element does not exist" << std::endl;
-        }
         if(!is_assn<T>::value){
           throw cet::exception("ShowerProducedPtrsHolder") << "Element type  is not an assoication please only use this for assocations" << std::endl;
         }
-        reco::shower::ShowerUniqueAssnPtr<T>* assnptr = dynamic_cast<reco::shower::ShowerUniqueAssnPtr<T> *>(showerassnPtrsIt->second.get());
-        if(assnptr == nullptr){
-          throw cet::exception("ShowerProducedPtrsHolder") << "Failed to cast back. Maybe you got the type wrong or you are accidently accessing a differently named product" << std::endl;
-        }
-
-        T* assn = dynamic_cast<T*>(assnptr->GetPtr().get());
-        if(assn == nullptr){
-          throw cet::exception("ShowerProducedPtrsHolder")  << "Something went wrong trying to cast tothe assn. Maybe the name: " << Name << " exists but its not an assn" << std::endl;
-        }
+        AddSingle(GetHandle(type<T>(), Name), a, b);
+      }
 
-        assn->addSingle(a,b);
-        return;
+    //As above but through the handle, so there is no lookup or cast per shower.
+    template <class T, class A, class B>
+      void AddSingle(const ShowerProducedPtrHandle<T>& handle, A& a, B& b){
+        static_assert(is_assn<T>::value, "Element type is not an assoication please only use this for assocations");
+        GetPtr(handle)->addSingle(a,b);
       }
 
     //Initialise the ptr makers. This is done at the the start of the module.
     void SetPtrMakers(art::Event& evt){
-      for(auto const&  showerPtrMaker:  showerPtrMakers){
-        if(showerPtrMakers.find(showerPtrMaker.first) == showerPtrMakers.end()){
-          throw cet::exception("ShowerProducedPtrsHolder") << "PtrMaker was empty. This is concerning" << std::endl;
-        }
-        showerPtrMakers[showerPtrMaker.first]->SetPtrMaker(evt);
+      for(auto const& showerPtrMaker: showerPtrMakers){
+        showerPtrMaker->SetPtrMaker(evt);
       }
     }
 
     //Wrapper to access a particle PtrMaker. This is legacy as is not used.
     template <class T>
       art::PtrMaker<T>& GetPtrMaker(const std::string& Name){
-        auto const showerPtrMakersIt = showerPtrMakers.find(Name);
-        if(showerPtrMakersIt == showerPtrMakers.end()){
-          throw cet::exception("ShowerProducedPtrsHolder") << "PtrMaker does not exist" << std::endl;
-        }
-        else{
-          if(!showerPtrMakersIt->second->CheckPtrMaker()){
-            throw cet::exception("ShowerProducedPtrsHolder") << "PtrMaker is not set" << std::endl;
-          }
-          reco::shower::ShowerPtrMaker<T>* ptrmaker = dynamic_cast<reco::shower::ShowerPtrMaker<T> *>(showerassnPtrs[Name].get());
-          return ptrmaker->GetPtrMaker();
-        }
+        const ShowerProducedPtrHandle<std::vector<T> > handle = GetHandle(type<std::vector<T> >(), Name);
+        return GetShowerPtrMaker(handle).GetPtrMaker();
       }
 
     //Wrapper to return to the the user the art ptr corresponding the index iter
     template <class T>
       art::Ptr<T> GetArtPtr(const std::string& Name, const int& iter) const {
-        auto const showerPtrMakersIt = showerPtrMakers.find(Name);
-        if(showerPtrMakersIt == showerPtrMakers.end()){
+        if(showerproductIndices.find(Name) == showerproductIndices.end()){
           throw cet::exception("ShowerProducedPtrsHolder") << "PtrMaker does not exist for " << Name << " Did you initialise this? "  << std::endl;
         }
-        else{
-          if(!showerPtrMakersIt->second->CheckPtrMaker()){
-            throw cet::exception("ShowerProducedPtrsHolder") << "PtrMaker is not set. This is an issue for the devlopment team me. Contact Dom Barker" << std::endl;
-          }
-          reco::shower::ShowerPtrMaker<T>* ptrmaker = dynamic_cast<reco::shower::ShowerPtrMaker<T> *>(showerPtrMakersIt->second.get());
-          if(ptrmaker == nullptr){
-            throw cet::exception("ShowerProducedPtrsHolder") << "Failed to cast back. Maybe you got the type wrong or you are accidently accessing a differently named product" << std::endl;
-          }
-          return ptrmaker->GetArtPtr(iter);
+        return GetArtPtr(GetHandle(type<std::vector<T> >(), Name), iter);
+      }
+
+    //As above but through the handle.
+    template <class T>
+      art::Ptr<T> GetArtPtr(const ShowerProducedPtrHandle<std::vector<T> >& handle, const int& iter) const {
+        const reco::shower::ShowerPtrMaker<T>& ptrmaker = GetShowerPtrMaker(handle);
+        if(!ptrmaker.CheckPtrMaker()){
+          throw cet::exception("ShowerProducedPtrsHolder") << "PtrMaker is not set. This is an issue for the devlopment team me. Contact Dom Barker" << std::endl;
         }
+        return ptrmaker.GetArtPtr(iter);
       }
 
     //Legacy not used.
     void ResetPtrMakers(){
       for(auto const& showerPtrMaker: showerPtrMakers){
-        (showerPtrMaker.second)->Reset();
+        showerPtrMaker->Reset();
       }
     }
 
     //Return the size of the std::vector of the data object with the unique name string.
     int GetVectorPtrSize(const std::string& Name) const {
-      auto const showerproductPtrsIt = showerproductPtrs.find(Name);
-      if(showerproductPtrsIt != showerproductPtrs.end()){
-        return showerproductPtrsIt->second->GetVectorPtrSize();
+      auto const showerproductIndicesIt = showerproductIndices.find(Name);
+      if(showerproductIndicesIt != showerproductIndices.end()){
+        return showerproductPtrs[showerproductIndicesIt->second]->GetVectorPtrSize();
       }
       throw cet::exception("ShowerProducedPtrsHolder") << "Product: " << Name << " has not been set in the producers map" << std::endl;
     }
 
+    //As above but through the handle.
+    template <class T>
+      int GetVectorPtrSize(const ShowerProducedPtrHandle<std::vector<T> >& handle) const {
+        return showerproductPtrs.at(handle.index)->GetVectorPtrSize();
+      }
+
     //Print the type, the element name and the instance name
     void PrintPtr(const std::string& Name) const {
-      auto const showerproductPtrsIt = showerproductPtrs.find(Name);
-      if(showerproductPtrsIt != showerproductPtrs.end()){
-        const std::string Type     = showerproductPtrsIt->second->GetType();
-        const std::string InstanceName = showerproductPtrsIt->second->GetInstanceName();
+      auto const showerproductIndicesIt = showerproductIndices.find(Name);
+      if(showerproductIndicesIt != showerproductIndices.end()){
+        const std::string Type     = showerproductPtrs[showerproductIndicesIt->second]->GetType();
+        const std::string InstanceName = showerproductPtrs[showerproductIndicesIt->second]->GetInstanceName();
         std::cout << "Element Name: " << Name << " Instance Name: " << InstanceName <<  " Type: " << Type << std::endl;
         return;
       }
-      auto const showerassnPtrsIt = showerassnPtrs.find(Name);
-      if(showerassnPtrsIt != showerassnPtrs.end()){
-        const std::string Type      = showerassnPtrsIt->second->GetType();
-        const std::string InstanceName  = showerassnPtrsIt->second->GetInstanceName();
+      auto const showerassnIndicesIt = showerassnIndices.find(Name);
+      if(showerassnIndicesIt != showerassnIndices.end()){
+        const std::string Type      = showerassnPtrs[showerassnIndicesIt->second]->GetType();
+        const std::string InstanceName  = showerassnPtrs[showerassnIndicesIt->second]->GetInstanceName();
         std::cout << "Element Name: " << Name << " Instance Name: " << InstanceName <<  " Type: " << Type << std::endl;
         return;
       }
@@ -513,28 +563,28 @@ class reco::shower::ShowerProducedPtrsHolder {
     void PrintPtrs() const {
 
       unsigned int maxname = 0;
-      for(auto const& showerprodPtr: showerproductPtrs){
-        if(showerprodPtr.first.size() > maxname){
-          maxname = showerprodPtr.first.size();
+      for(auto const& showerprodIndex: showerproductIndices){
+        if(showerprodIndex.first.size() > maxname){
+          maxname = showerprodIndex.first.size();
         }
       }
-      for(auto const& showerassnPtr: showerassnPtrs){
-        if(showerassnPtr.first.size() > maxname){
-          maxname = showerassnPtr.first.size();
+      for(auto const& showerassnIndex: showerassnIndices){
+        if(showerassnIndex.first.size() > maxname){
+          maxname = showerassnIndex.first.size();
         }
       }
 
       std::map<std::string,std::pair<std::string,std::string> > Type_showerprodPtrs;
       std::map<std::string,std::pair<std::string,std::string> > Type_showerassnPtrs;
-      for(auto const& showerprodPtr: showerproductPtrs){
-        const std::string Type         = (showerprodPtr.second)->GetType();
-        const std::string InstanceName = (showerprodPtr.second)->GetInstanceName();
-        Type_showerprodPtrs[showerprodPtr.first] = std::make_pair(InstanceName,Type);
+      for(auto const& showerprodIndex: showerproductIndices){
+        const std::string Type         = showerproductPtrs[showerprodIndex.second]->GetType();
+        const std::string InstanceName = showerproductPtrs[showerprodIndex.second]->GetInstanceName();
+        Type_showerprodPtrs[showerprodIndex.first] = std::make_pair(InstanceName,Type);
       }
-      for(auto const& showerassnPtr: showerassnPtrs){
-        const std::string Type         = (showerassnPtr.second)->GetType();
-        const std::string InstanceName = (showerassnPtr.second)->GetInstanceName();
-        Type_showerassnPtrs[showerassnPtr.first] = std::make_pair(InstanceName,Type);
+      for(auto const& showerassnIndex: showerassnIndices){
+        const std::string Type         = showerassnPtrs[showerassnIndex.second]->GetType();
+        const std::string InstanceName = showerassnPtrs[showerassnIndex.second]->GetInstanceName();
+        Type_showerassnPtrs[showerassnIndex.first] = std::make_pair(InstanceName,Type);
       }
 
       unsigned int maxtype     = 0;
@@ -580,13 +630,19 @@ class reco::shower::ShowerProducedPtrsHolder {
 
   private:
 
+    //Get the ptr maker of a product. The handle guarantees the type.
+    template <class T>
+      reco::shower::ShowerPtrMaker<T>& GetShowerPtrMaker(const ShowerProducedPtrHandle<std::vector<T> >& handle) const {
+        return *static_cast<reco::shower::ShowerPtrMaker<T> *>(showerPtrMakers.at(handle.index).get());
+      }
+
     //Function to check that a data product does not already exist with the same instance name
     template <class T>
       bool CheckForMultipleTypes(type<T>, const std::string& Name, const std::string& Instance) const {
 
         //Check the a product of the same does not exist without a different instance name
         for(auto const& assn: showerassnPtrs){
-          reco::shower::ShowerUniqueAssnPtr<T>* assnptr = dynamic_cast<reco::shower::ShowerUniqueAssnPtr<T> *>(assn.second.get());
+          reco::shower::ShowerUniqueAssnPtr<T>* assnptr = dynamic_cast<reco::shower::ShowerUniqueAssnPtr<T> *>(assn.get());
           if(assnptr != nullptr){
             if(assnptr->GetInstanceName() == Instance){return false;}
           }
@@ -600,7 +656,7 @@ class reco::shower::ShowerProducedPtrsHolder {
 
         //Check the a product of the same does not exist without a different instance name
         for(auto const& product: showerproductPtrs){
-          reco::shower::ShowerUniqueProductPtr<std::vector<T > >* prod = dynamic_cast<reco::shower::ShowerUniqueProductPtr<std::vector<T> > *>(product.second.get());
+          reco::shower::ShowerUniqueProductPtr<std::vector<T > >* prod = dynamic_cast<reco::shower::ShowerUniqueProductPtr<std::vector<T> > *>(product.get());
           if(prod != nullptr){
             if(prod->GetInstanceName() == Instance){return false;}
           }
@@ -610,14 +666,21 @@ class reco::shower::ShowerProducedPtrsHolder {
 
 
 
-    //Holder of the data objects of type std::vector<T> that will be saved in the events.
-    std::map<std::string,std::unique_ptr<reco::shower::ShowerUniqueProduerPtrBase > > showerproductPtrs;
+    //Holder of the data objects of type std::vector<T> that will be saved in the events, indexed by handle.
+    std::vector<std::unique_ptr<reco::shower::ShowerUniqueProduerPtrBase > > showerproductPtrs;
+
+    //Names of the data objects above, these match the elements in the element holder.
+    std::vector<std::string> showerproductNames;
+
+    //Holder of the data objects of type T that will be saved into the events, indexed by handle. I think these will only be assns.
+    std::vector<std::unique_ptr<reco::shower::ShowerUniqueProduerPtrBase > > showerassnPtrs;
 
-    //Holder of the data objects of type T that will be saved into the events. I think these will only be assns.
-    std::map<std::string,std::unique_ptr<reco::shower::ShowerUniqueProduerPtrBase > > showerassnPtrs;
+    //Holder of the ptrMakers whcih make the art::Ptrs of the data objects that lie in showerproductPtrs, same index.
+    std::vector<std::unique_ptr<reco::shower::ShowerPtrMakerBase> > showerPtrMakers;
 
-    //Holder of the ptrMakers whcih make the art::Ptrs of the data objects that lie in showerproductPtrs.
-    std::map<std::string,std::unique_ptr<reco::shower::ShowerPtrMakerBase> > showerPtrMakers;
+    //Map from the name to the handle index, only used when the handles are resolved.
+    std::map<std::string,int> showerproductIndices;
+    std::map<std::string,int> showerassnIndices;
 };
 
 
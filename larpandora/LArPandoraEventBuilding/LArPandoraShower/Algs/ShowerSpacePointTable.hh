@@ -0,0 +1,187 @@
+//###################################################################
+//### Name:        ShowerSpacePointTable                          ###
+//### Description: Per event table of the spacepoint features     ###
+//###              used by the shower tools (position, charge,    ###
+//###              time, lifetime corrected charge and TPC).      ###
+//###              Filled once per event from the spacepoint to   ###
+//###              hit association and indexed by spacepoint key. ###
+//###              Used in LArPandoraModularShower and the        ###
+//###              corresponding tools.                           ###
+//###################################################################
+
+#ifndef ShowerSpacePointTable_HH
+#define ShowerSpacePointTable_HH
+
+//Framework includes
+#include "canvas/Persistency/Common/Ptr.h"
+
+//LArSoft Includes
+#include "lardataalg/DetectorInfo/DetectorClocksData.h"
+#include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/SpacePoint.h"
+#include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerAssociationView.hh"
+
+//C++ Inlcudes
+#include <cmath>
+#include <limits>
+#include <vector>
+
+//Root Includes
+#include "TVector3.h"
+
+namespace reco::shower {
+  class ShowerSpacePointTable;
+}
+
+class reco::shower::ShowerSpacePointTable {
+
+  public:
+
+    static constexpr unsigned int kInvalidTPC = std::numeric_limits<unsigned int>::max();
+
+    ShowerSpacePointTable() = default;
+
+    //Fill the table for every spacepoint in the collection. The columns are computed exactly as the
+    //per spacepoint functions in LArPandoraShowerAlg so the tools give the same answers either way.
+    ShowerSpacePointTable(const std::vector<recob::SpacePoint>& spacePoints,
+        const reco::shower::ShowerAssociationView<recob::Hit>& fmh,
+        const detinfo::DetectorClocksData& clockData,
+        const detinfo::DetectorPropertiesData& detProp){
+
+      const size_t nSpacePoints(spacePoints.size());
+
+      fX.resize(nSpacePoints);
+      fY.resize(nSpacePoints);
+      fZ.resize(nSpacePoints);
+      fCharge.resize(nSpacePoints);
+      fTime.resize(nSpacePoints);
+      fLifetimeCorrectedCharge.resize(nSpacePoints);
+      fCollectionCharge.resize(nSpacePoints);
+      fTruncatedCharge.resize(nSpacePoints);
+      fTPC.resize(nSpacePoints);
+
+      //The lifetime correction constants are the same for every hit in the event
+      const double samplingRate(sampling_rate(clockData));
+      const double lifetime(detProp.ElectronLifetime() * 1e3);
+
+      std::vector<double> correctedCharges;
+
+      for(size_t key = 0; key < nSpacePoints; ++key){
+
+        const Double32_t* sp_xyz = spacePoints[key].XYZ();
+        fX[key] = sp_xyz[0];
+        fY[key] = sp_xyz[1];
+        fZ[key] = sp_xyz[2];
+
+        auto const hits = fmh.at(key);
+
+        //Average the charge and time over the hits
+        double charge = 0;
+        double time   = 0;
+        for(auto const& hit: hits){
+          charge += hit->Integral();
+          time   += hit->PeakTime();
+        }
+        charge /= (float) hits.size();
+        time   /= (float) hits.size();
+
+        fCharge[key] = charge;
+        fTime[key]   = time;
+        fTPC[key]    = hits.empty() ? kInvalidTPC : hits.front()->WireID().TPC;
+
+        //Correct the averaged charge for the lifetime, ATTN the tools do this in single precision
+        float correctedCharge = charge;
+        float correctedTime   = time;
+        correctedCharge *= std::exp((samplingRate * correctedTime) / lifetime);
+        fLifetimeCorrectedCharge[key] = correctedCharge;
+
+        //Charge of the first collection hit and the two sigma truncated mean over all hits, as in ShowerCentre
+        float collectionCharge = 0;
+        float sumCharge        = 0;
+        float sumCharge2       = 0;
+        bool  foundCollection  = false;
+        correctedCharges.clear();
+        for(auto const& hit: hits){
+          const double Q = hit->Integral() * std::exp((samplingRate * hit->PeakTime()) / lifetime);
+          if(!foundCollection && hit->SignalType() == geo::kCollection){
+            collectionCharge = Q;
+            foundCollection  = true;
+          }
+          correctedCharges.push_back(Q);
+          sumCharge  += Q;
+          sumCharge2 += Q * Q;
+        }
+        fCollectionCharge[key] = collectionCharge;
+
+        float mean = sumCharge / ((float) hits.size());
+        float rms  = 1;
+        if(hits.size() > 1){
+          rms = std::sqrt((sumCharge2 - sumCharge * sumCharge) / ((float) (hits.size() - 1)));
+        }
+
+        float truncatedCharge = 0;
+        int n = 0;
+        for(double const Q: correctedCharges){
+          if(Q > (mean - 2 * rms) && Q < (mean + 2 * rms)){
+            truncatedCharge += Q;
+            ++n;
+          }
+        }
+        //ATTN n can be zero, giving NaN as before. ShowerCentre reports it for the spacepoints it uses.
+        truncatedCharge /= n;
+        fTruncatedCharge[key] = truncatedCharge;
+      }
+    }
+
+    size_t size() const {
+      return fX.size();
+    }
+
+    TVector3 GetPosition(const size_t key) const {
+      return TVector3{fX.at(key), fY.at(key), fZ.at(key)};
+    }
+
+    //Mean integral of the spacepoint hits in ADC.
+    double GetCharge(const size_t key) const {
+      return fCharge.at(key);
+    }
+
+    //Mean peak time of the spacepoint hits.
+    double GetTime(const size_t key) const {
+      return fTime.at(key);
+    }
+
+    //Mean charge corrected for the lifetime at the mean time.
+    float GetLifetimeCorrectedCharge(const size_t key) const {
+      return fLifetimeCorrectedCharge.at(key);
+    }
+
+    //Lifetime corrected charge of the first collection plane hit, zero if there is none.
+    float GetCollectionCharge(const size_t key) const {
+      return fCollectionCharge.at(key);
+    }
+
+    //Mean lifetime corrected charge of the hits within two sigma of the mean.
+    float GetTruncatedCharge(const size_t key) const {
+      return fTruncatedCharge.at(key);
+    }
+
+    unsigned int GetTPC(const size_t key) const {
+      return fTPC.at(key);
+    }
+
+  private:
+
+    std::vector<double> fX;
+    std::vector<double> fY;
+    std::vector<double> fZ;
+    std::vector<double> fCharge;
+    std::vector<double> fTime;
+    std::vector<float> fLifetimeCorrectedCharge;
+    std::vector<float> fCollectionCharge;
+    std::vector<float> fTruncatedCharge;
+    std::vector<unsigned int> fTPC;
+};
+
+#endif
@@ -0,0 +1,106 @@
+//###################################################################
+//### Name:        ShowerTrajPointIndex                           ###
+//### Description: Index of the trajectory points of a track by   ###
+//###              their projection along the track, to find the  ###
+//###              closest point to a position without testing    ###
+//###              every point. Gives the same point as a loop    ###
+//###              over the points in order. Used in              ###
+//###              ShowerTrajPointdEdx.                           ###
+//###################################################################
+
+#ifndef ShowerTrajPointIndex_HH
+#define ShowerTrajPointIndex_HH
+
+//C++ Inlcudes
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+//Root Includes
+#include "TVector3.h"
+
+namespace reco::shower {
+  class ShowerTrajPointIndex;
+}
+
+class reco::shower::ShowerTrajPointIndex {
+
+  public:
+
+    //Returned when no point is close enough, as the tools have always used.
+    static constexpr unsigned int kNoPoint = 999;
+
+    //Index the points flagged as valid. Any unit axis gives a lower bound on the distance, the
+    //direction from the first to the last valid point keeps the search short.
+    void Fill(const std::vector<TVector3>& positions, const std::vector<bool>& isValid){
+
+      fPositions = positions;
+      fAxis = TVector3(0, 0, 1);
+      fProjections.clear();
+
+      for(unsigned int traj = 0; traj < fPositions.size(); ++traj){
+        if(isValid[traj]){ fProjections.emplace_back(0, traj); }
+      }
+
+      if(!fProjections.empty()){
+        const TVector3 trackVector = fPositions[fProjections.back().second] - fPositions[fProjections.front().second];
+        if(trackVector.Mag() > 0){ fAxis = trackVector.Unit(); }
+      }
+
+      for(auto& [projection, traj]: fProjections){
+        projection = fPositions[traj].Dot(fAxis);
+      }
+      std::sort(fProjections.begin(), fProjections.end());
+    }
+
+    const TVector3& GetPosition(const unsigned int traj) const {
+      return fPositions.at(traj);
+    }
+
+    //The closest valid point closer than maxDist and 999 cm, the earliest point on a tie, kNoPoint if there is none.
+    unsigned int FindClosest(const TVector3& pos, const double maxDist) const {
+
+      unsigned int index = kNoPoint;
+      bool found = false;
+      double MinDist = 999;
+
+      //The projection difference can not be larger than the distance, up to rounding.
+      auto searchLimit = [&](){ return std::min(MinDist, maxDist) + 1e-6; };
+
+      auto tryTrajPoint = [&](const unsigned int traj){
+        const double mag = (pos - fPositions[traj]).Mag();
+        if(mag >= maxDist){ return; }
+        if(mag < MinDist || (mag == MinDist && found && traj < index)){
+          MinDist = mag;
+          index = traj;
+          found = true;
+        }
+      };
+
+      const double posProjection = pos.Dot(fAxis);
+      const auto middle = std::lower_bound(fProjections.begin(), fProjections.end(), posProjection,
+          [](const std::pair<double, unsigned int>& trajProjection, const double projection){
+            return trajProjection.first < projection; });
+
+      for(auto iter = middle; iter != fProjections.end(); ++iter){
+        if(iter->first - posProjection > searchLimit()){ break; }
+        tryTrajPoint(iter->second);
+      }
+
+      for(auto iter = middle; iter != fProjections.begin();){
+        --iter;
+        if(posProjection - iter->first > searchLimit()){ break; }
+        tryTrajPoint(iter->second);
+      }
+
+      return index;
+    }
+
+  private:
+
+    std::vector<TVector3> fPositions;
+    std::vector<std::pair<double, unsigned int> > fProjections;
+    TVector3 fAxis;
+};
+
+#endif
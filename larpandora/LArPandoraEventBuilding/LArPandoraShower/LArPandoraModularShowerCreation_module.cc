@@ -38,13 +38,14 @@ public:
 private:
   void produce(art::Event& evt);
 
-  //This function returns the art::Ptr to the data object InstanceName.
+  //This function returns the art::Ptr to the data object with the given handle.
   //In the background it uses the PtrMaker which requires the element index of
   //the unique ptr (iter).
   template <class T>
-  art::Ptr<T> GetProducedElementPtr(const std::string& InstanceName,
-                                    const reco::shower::ShowerElementHolder& ShowerEleHolder,
-                                    const int& iter = -1);
+  art::Ptr<T> GetProducedElementPtr(
+    const reco::shower::ShowerProducedPtrHandle<std::vector<T>>& handle,
+    const reco::shower::ShowerElementHolder& ShowerEleHolder,
+    const int& iter = -1);
 
   //fcl object names
   unsigned int fNumPlanes;
@@ -69,29 +70,32 @@ private:
   //map to the unique ptrs to
   reco::shower::ShowerProducedPtrsHolder uniqueproducerPtrs;
 
+  //Handles to the shower and its associations in the unique ptrs
+  reco::shower::ShowerProducedPtrHandle<std::vector<recob::Shower>> fShowerHandle;
+  reco::shower::ShowerProducedPtrHandle<art::Assns<recob::Shower, recob::Cluster>>
+    fClusterAssnHandle;
+  reco::shower::ShowerProducedPtrHandle<art::Assns<recob::Shower, recob::Hit>> fHitAssnHandle;
+  reco::shower::ShowerProducedPtrHandle<art::Assns<recob::Shower, recob::SpacePoint>>
+    fSpacePointAssnHandle;
+  reco::shower::ShowerProducedPtrHandle<art::Assns<recob::Shower, recob::PFParticle>>
+    fPFParticleAssnHandle;
+
   // Required services
   art::ServiceHandle<geo::Geometry> fGeom;
 };
 
-//This function returns the art::Ptr to the data object InstanceName.
+//This function returns the art::Ptr to the data object with the given handle.
 //In the background it uses the PtrMaker which requires the element index of
 //the unique ptr (iter).
 template <class T>
 art::Ptr<T>
 reco::shower::LArPandoraModularShowerCreation::GetProducedElementPtr(
-  const std::string& InstanceName,
+  const reco::shower::ShowerProducedPtrHandle<std::vector<T>>& handle,
   const reco::shower::ShowerElementHolder& ShowerEleHolder,
   const int& iter)
 {
 
-  bool check_element = ShowerEleHolder.CheckElement(InstanceName);
-  if (!check_element) {
-    throw cet::exception("LArPandoraModularShowerCreation")
-      << "To get a element that does not exist" << std::endl;
-  }
-
-  bool check_ptr = uniqueproducerPtrs.CheckUniqueProduerPtr(InstanceName);
-  if (!check_ptr) {
+  if (!handle.IsValid()) {
     throw cet::exception("LArPandoraModularShowerCreation")
       << "Tried to get a ptr that does not exist" << std::endl;
   }
@@ -104,7 +108,7 @@ reco::shower::LArPandoraModularShowerCreation::GetProducedElementPtr(
   }
 
   //Make the ptr
-  art::Ptr<T> artptr = uniqueproducerPtrs.GetArtPtr<T>(InstanceName, index);
+  art::Ptr<T> artptr = uniqueproducerPtrs.GetArtPtr(handle, index);
   return artptr;
 }
 
@@ -163,6 +167,27 @@ reco::shower::LArPandoraModularShowerCreation::LArPandoraModularShowerCreation(
     fNumPlanes = fGeom->Nplanes();
   }
 
+  //Initialise the other paramters.
+
+  produces<std::vector<recob::Shower>>();
+  produces<art::Assns<recob::Shower, recob::Hit>>();
+  produces<art::Assns<recob::Shower, recob::Cluster>>();
+  produces<art::Assns<recob::Shower, recob::SpacePoint>>();
+  produces<art::Assns<recob::Shower, recob::PFParticle>>();
+
+  // Output -- showers and associations with hits and clusters. These are set before the tools
+  // are initialised so the tools can get the handle to the shower.
+  fShowerHandle =
+    uniqueproducerPtrs.SetShowerUniqueProduerPtr(type<std::vector<recob::Shower>>(), "shower");
+  fClusterAssnHandle = uniqueproducerPtrs.SetShowerUniqueProduerPtr(
+    type<art::Assns<recob::Shower, recob::Cluster>>(), "clusterAssociationsbase");
+  fHitAssnHandle = uniqueproducerPtrs.SetShowerUniqueProduerPtr(
+    type<art::Assns<recob::Shower, recob::Hit>>(), "hitAssociationsbase");
+  fSpacePointAssnHandle = uniqueproducerPtrs.SetShowerUniqueProduerPtr(
+    type<art::Assns<recob::Shower, recob::SpacePoint>>(), "spShowerAssociationsbase");
+  fPFParticleAssnHandle = uniqueproducerPtrs.SetShowerUniqueProduerPtr(
+    type<art::Assns<recob::Shower, recob::PFParticle>>(), "pfShowerAssociationsbase");
+
   //  Initialise the EDProducer ptr in the tools
   std::vector<std::string> SetupTools;
   for (unsigned int i = 0; i < fShowerTools.size(); ++i) {
@@ -174,25 +199,6 @@ reco::shower::LArPandoraModularShowerCreation::LArPandoraModularShowerCreation(
     fShowerTools[i]->InitialiseProducers();
   }
 
-  //Initialise the other paramters.
-
-  produces<std::vector<recob::Shower>>();
-  produces<art::Assns<recob::Shower, recob::Hit>>();
-  produces<art::Assns<recob::Shower, recob::Cluster>>();
-  produces<art::Assns<recob::Shower, recob::SpacePoint>>();
-  produces<art::Assns<recob::Shower, recob::PFParticle>>();
-
-  // Output -- showers and associations with hits and clusters
-  uniqueproducerPtrs.SetShowerUniqueProduerPtr(type<std::vector<recob::Shower>>(), "shower");
-  uniqueproducerPtrs.SetShowerUniqueProduerPtr(type<art::Assns<recob::Shower, recob::Cluster>>(),
-                                               "clusterAssociationsbase");
-  uniqueproducerPtrs.SetShowerUniqueProduerPtr(type<art::Assns<recob::Shower, recob::Hit>>(),
-                                               "hitAssociationsbase");
-  uniqueproducerPtrs.SetShowerUniqueProduerPtr(type<art::Assns<recob::Shower, recob::SpacePoint>>(),
-                                               "spShowerAssociationsbase");
-  uniqueproducerPtrs.SetShowerUniqueProduerPtr(type<art::Assns<recob::Shower, recob::PFParticle>>(),
-                                               "pfShowerAssociationsbase");
-
   uniqueproducerPtrs.PrintPtrs();
 }
 
@@ -209,16 +215,19 @@ reco::shower::LArPandoraModularShowerCreation::produce(art::Event& evt)
   std::vector<art::Ptr<recob::PFParticle>> pfps;
   art::fill_ptr_vector(pfps, pfpHandle);
 
+  //There is at most one shower per PFParticle
+  uniqueproducerPtrs.reserve(pfps.size());
+
   //Handle to access the pandora hits assans
   auto const clusterHandle = evt.getValidHandle<std::vector<recob::Cluster>>(fPFParticleLabel);
 
-  //Get the assoications to hits, clusters and spacespoints
-  const art::FindManyP<recob::Hit>& fmh =
-    showerEleHolder.GetFindManyP<recob::Hit>(clusterHandle, evt, fPFParticleLabel);
-  const art::FindManyP<recob::Cluster>& fmcp =
-    showerEleHolder.GetFindManyP<recob::Cluster>(pfpHandle, evt, fPFParticleLabel);
-  const art::FindManyP<recob::SpacePoint>& fmspp =
-    showerEleHolder.GetFindManyP<recob::SpacePoint>(pfpHandle, evt, fPFParticleLabel);
+  //Get the assoications to hits, clusters and spacespoints. These are shared with the tools.
+  const reco::shower::ShowerAssociationView<recob::Hit>& fmh =
+    showerEleHolder.GetAssociationView<recob::Hit>(clusterHandle, evt, fPFParticleLabel);
+  const reco::shower::ShowerAssociationView<recob::Cluster>& fmcp =
+    showerEleHolder.GetAssociationView<recob::Cluster>(pfpHandle, evt, fPFParticleLabel);
+  const reco::shower::ShowerAssociationView<recob::SpacePoint>& fmspp =
+    showerEleHolder.GetAssociationView<recob::SpacePoint>(pfpHandle, evt, fPFParticleLabel);
 
   //Holder to pass to the functions, contains the 6 properties of the shower
   // - Start Poistion
@@ -241,8 +250,8 @@ reco::shower::LArPandoraModularShowerCreation::produce(art::Event& evt)
     if (!fUseAllParticles && pfp->PdgCode() != 11 && pfp->PdgCode() != 22) continue;
 
     //Get the associated hits,clusters and spacepoints
-    const std::vector<art::Ptr<recob::Cluster>> showerClusters = fmcp.at(pfp.key());
-    const std::vector<art::Ptr<recob::SpacePoint>> showerSpacePoints = fmspp.at(pfp.key());
+    const auto showerClusters = fmcp.at(pfp.key());
+    const auto showerSpacePoints = fmspp.at(pfp.key());
 
     // Check the pfp has at least 1 cluster (i.e. not a pfp neutrino)
     if (!showerClusters.size()) continue;
@@ -430,32 +439,27 @@ reco::shower::LArPandoraModularShowerCreation::produce(art::Event& evt)
                          ShowerOpeningAngle);
     showerEleHolder.SetElement(shower, "shower");
     ++shower_iter;
-    art::Ptr<recob::Shower> ShowerPtr =
-      this->GetProducedElementPtr<recob::Shower>("shower", showerEleHolder);
+    art::Ptr<recob::Shower> ShowerPtr = this->GetProducedElementPtr(fShowerHandle, showerEleHolder);
 
     //Associate the pfparticle
-    uniqueproducerPtrs.AddSingle<art::Assns<recob::Shower, recob::PFParticle>>(
-      ShowerPtr, pfp, "pfShowerAssociationsbase");
+    uniqueproducerPtrs.AddSingle(fPFParticleAssnHandle, ShowerPtr, pfp);
 
     //Add the hits for each "cluster"
     for (auto const& cluster : showerClusters) {
 
       //Associate the clusters
-      std::vector<art::Ptr<recob::Hit>> ClusterHits = fmh.at(cluster.key());
-      uniqueproducerPtrs.AddSingle<art::Assns<recob::Shower, recob::Cluster>>(
-        ShowerPtr, cluster, "clusterAssociationsbase");
+      const auto ClusterHits = fmh.at(cluster.key());
+      uniqueproducerPtrs.AddSingle(fClusterAssnHandle, ShowerPtr, cluster);
 
       //Associate the hits
       for (auto const& hit : ClusterHits) {
-        uniqueproducerPtrs.AddSingle<art::Assns<recob::Shower, recob::Hit>>(
-          ShowerPtr, hit, "hitAssociationsbase");
+        uniqueproducerPtrs.AddSingle(fHitAssnHandle, ShowerPtr, hit);
       }
     }
 
     //Associate the spacepoints
     for (auto const& sp : showerSpacePoints) {
-      uniqueproducerPtrs.AddSingle<art::Assns<recob::Shower, recob::SpacePoint>>(
-        ShowerPtr, sp, "spShowerAssociationsbase");
+      uniqueproducerPtrs.AddSingle(fSpacePointAssnHandle, ShowerPtr, sp);
     }
 
     //Loop over the tool data products and add them.
@@ -17,7 +17,10 @@
 
 #include "larpandoracontent/LArObjects/LArPfoObjects.h"
 
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
 #include <memory>
+#include <optional>
 
 namespace lar_pandora {
 
@@ -33,6 +36,34 @@ namespace lar_pandora {
     void produce(art::Event& evt) override;
 
   private:
+    /**
+     *  @brief  The inputs to the shower fit of one pfparticle, collected before any fit is run
+     */
+    struct ShowerCandidate {
+      art::Ptr<recob::PFParticle> m_pPFParticle; ///< The pfparticle
+      const ClusterVector* m_pClusters;          ///< The clusters of the pfparticle
+      pandora::CartesianPointVector m_points;    ///< The spacepoint positions of the pfparticle
+      pandora::CartesianVector m_vertex;         ///< The pfparticle vertex position
+    };
+
+    /**
+     *  @brief  The result of the shower fit of one pfparticle
+     */
+    struct ShowerFit {
+      lar_content::LArShowerPCA m_larShowerPCA; ///< The pca, primary axis pointing away from the vertex
+      pandora::CartesianVector m_vertex;        ///< The vertex projected onto the primary axis
+    };
+
+    /**
+     *  @brief  Run the pandora "fast" shower fit for a candidate. Uses no state but its arguments,
+     *          so the candidates of an event can be fitted concurrently
+     *
+     *  @param  candidate the shower candidate
+     *
+     *  @return the fit, empty if the pca could not be extracted
+     */
+    static std::optional<ShowerFit> FitShower(const ShowerCandidate& candidate);
+
     /**
      *  @brief  Build a recob::Shower object
      *
@@ -68,12 +99,14 @@ namespace lar_pandora {
 
 #include "art/Persistency/Common/PtrMaker.h"
 
+#include "canvas/Persistency/Common/FindManyP.h"
 #include "canvas/Utilities/InputTag.h"
 
 #include "larcore/Geometry/Geometry.h"
 
 #include "lardata/Utilities/AssociationUtil.h"
 
+#include "lardataobj/RecoBase/Cluster.h"
 #include "lardataobj/RecoBase/PCAxis.h"
 #include "lardataobj/RecoBase/PFParticle.h"
 #include "lardataobj/RecoBase/Shower.h"
@@ -84,7 +117,8 @@ namespace lar_pandora {
 
 #include "larpandoracontent/LArHelpers/LArPfoHelper.h"
 
-#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 
 #include <iostream>
 
@@ -137,6 +171,10 @@ namespace lar_pandora {
     PFParticlesToVertices pfParticlesToVertices;
     LArPandoraHelper::CollectVertices(evt, m_pfParticleLabel, vertexVector, pfParticlesToVertices);
 
+    // Collect the inputs of every shower fit, in the order the showers are made
+    std::vector<ShowerCandidate> showerCandidates;
+    showerCandidates.reserve(pfParticleVector.size());
+
     for (const art::Ptr<recob::PFParticle> pPFParticle : pfParticleVector) {
       // Select shower-like pfparticles
       if (!m_useAllParticles && !LArPandoraHelper::IsShower(pPFParticle)) continue;
@@ -171,67 +209,69 @@ namespace lar_pandora {
 
       // Copy information into expected pandora form
       pandora::CartesianPointVector cartesianPointVector;
-      for (const art::Ptr<recob::SpacePoint> spacePoint : particleToSpacePointIter->second)
+      cartesianPointVector.reserve(particleToSpacePointIter->second.size());
+      for (const art::Ptr<recob::SpacePoint>& spacePoint : particleToSpacePointIter->second)
         cartesianPointVector.emplace_back(pandora::CartesianVector(
           spacePoint->XYZ()[0], spacePoint->XYZ()[1], spacePoint->XYZ()[2]));
 
       double vertexXYZ[3] = {0., 0., 0.};
       particleToVertexIter->second.front()->XYZ(vertexXYZ);
-      const pandora::CartesianVector vertexPosition(vertexXYZ[0], vertexXYZ[1], vertexXYZ[2]);
-
-      // Call pandora "fast" shower fitter
-      try {
-        // Access centroid of shower via this method
-        const lar_content::LArShowerPCA initialLArShowerPCA(
-          lar_content::LArPfoHelper::GetPrincipalComponents(cartesianPointVector, vertexPosition));
-
-        // Ensure successful creation of all structures before placing results in output containers, remaking LArShowerPCA with updated vertex
-        const pandora::CartesianVector& centroid(initialLArShowerPCA.GetCentroid());
-        const pandora::CartesianVector& primaryAxis(initialLArShowerPCA.GetPrimaryAxis());
-        const pandora::CartesianVector& secondaryAxis(initialLArShowerPCA.GetSecondaryAxis());
-        const pandora::CartesianVector& tertiaryAxis(initialLArShowerPCA.GetTertiaryAxis());
-        const pandora::CartesianVector& eigenvalues(initialLArShowerPCA.GetEigenValues());
-
-        // Project the PFParticle vertex onto the PCA axis
-        const pandora::CartesianVector projectedVertexPosition(
-          centroid -
-          primaryAxis.GetUnitVector() * (centroid - vertexPosition).GetDotProduct(primaryAxis));
-
-        // By convention, principal axis should always point away from vertex
-        const float testProjection(primaryAxis.GetDotProduct(projectedVertexPosition - centroid));
-        const float directionScaleFactor(
-          (testProjection > std::numeric_limits<float>::epsilon()) ? -1.f : 1.f);
-
-        const lar_content::LArShowerPCA larShowerPCA(centroid,
-                                                     primaryAxis * directionScaleFactor,
-                                                     secondaryAxis * directionScaleFactor,
-                                                     tertiaryAxis * directionScaleFactor,
-                                                     eigenvalues);
-        const recob::Shower shower(LArPandoraShowerCreation::BuildShower(
-          showerCounter++, larShowerPCA, projectedVertexPosition));
-        const recob::PCAxis pcAxis(LArPandoraShowerCreation::BuildPCAxis(larShowerPCA));
-        outputShowers->emplace_back(shower);
-        outputPCAxes->emplace_back(pcAxis);
-      }
-      catch (const pandora::StatusCodeException&) {
+
+      showerCandidates.push_back(
+        ShowerCandidate{pPFParticle,
+                        &particleToClustersIter->second,
+                        std::move(cartesianPointVector),
+                        pandora::CartesianVector(vertexXYZ[0], vertexXYZ[1], vertexXYZ[2])});
+    }
+
+    // Fit the showers concurrently, each fit only reads its own candidate and writes its own result
+    std::vector<std::optional<ShowerFit>> showerFits(showerCandidates.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, showerCandidates.size()),
+                      [&showerCandidates, &showerFits](const tbb::blocked_range<size_t>& range) {
+                        for (size_t i = range.begin(); i != range.end(); ++i)
+                          showerFits[i] = FitShower(showerCandidates[i]);
+                      });
+
+    // Fill the outputs in candidate order, so the showers, ids and associations match a serial fit
+    outputShowers->reserve(showerCandidates.size());
+    outputPCAxes->reserve(showerCandidates.size());
+
+    // Cluster to hit index, shared by all the showers and only built once there is a shower to output
+    std::optional<art::FindManyP<recob::Hit>> clustersToHits;
+
+    for (size_t i = 0; i < showerCandidates.size(); ++i) {
+      const ShowerCandidate& candidate(showerCandidates[i]);
+      const std::optional<ShowerFit>& showerFit(showerFits[i]);
+
+      if (!showerFit) {
         mf::LogDebug("LArPandoraShowerCreation") << "Unable to extract shower pca";
         continue;
       }
 
-      // Output objects
-      art::Ptr<recob::Shower> pShower(makeShowerPtr(outputShowers->size() - 1));
-      art::Ptr<recob::PCAxis> pPCAxis(makePCAxisPtr(outputPCAxes->size() - 1));
+      outputShowers->emplace_back(LArPandoraShowerCreation::BuildShower(
+        showerCounter++, showerFit->m_larShowerPCA, showerFit->m_vertex));
+      outputPCAxes->emplace_back(LArPandoraShowerCreation::BuildPCAxis(showerFit->m_larShowerPCA));
 
-      HitVector hitsInParticle;
-      LArPandoraHelper::GetAssociatedHits(
-        evt, m_pfParticleLabel, particleToClustersIter->second, hitsInParticle);
+      // Output objects
+      const art::Ptr<recob::Shower> pShower(makeShowerPtr(outputShowers->size() - 1));
+      const art::Ptr<recob::PCAxis> pPCAxis(makePCAxisPtr(outputPCAxes->size() - 1));
 
       // Output associations, after output objects are in place
-      util::CreateAssn(*this, evt, pShower, pPFParticle, *(outputParticlesToShowers.get()));
-      util::CreateAssn(*this, evt, pPCAxis, pPFParticle, *(outputParticlesToPCAxes.get()));
-      util::CreateAssn(
-        *this, evt, *(outputShowers.get()), hitsInParticle, *(outputShowersToHits.get()));
-      util::CreateAssn(*this, evt, pPCAxis, pShower, *(outputShowersToPCAxes.get()));
+      outputParticlesToShowers->addSingle(candidate.m_pPFParticle, pShower);
+      outputParticlesToPCAxes->addSingle(candidate.m_pPFParticle, pPCAxis);
+
+      if (!clustersToHits) {
+        art::Handle<std::vector<recob::Cluster>> clusterHandle;
+        evt.getByLabel(m_pfParticleLabel, clusterHandle);
+        clustersToHits.emplace(clusterHandle, evt, m_pfParticleLabel);
+      }
+
+      for (const art::Ptr<recob::Cluster>& pCluster : *candidate.m_pClusters) {
+        for (const art::Ptr<recob::Hit>& pHit : clustersToHits->at(pCluster.key()))
+          outputShowersToHits->addSingle(pShower, pHit);
+      }
+
+      outputShowersToPCAxes->addSingle(pShower, pPCAxis);
     }
 
     mf::LogDebug("LArPandora") << "   Number of new showers: " << outputShowers->size()
@@ -248,6 +288,49 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  std::optional<LArPandoraShowerCreation::ShowerFit>
+  LArPandoraShowerCreation::FitShower(const ShowerCandidate& candidate)
+  {
+    const pandora::CartesianVector& vertexPosition(candidate.m_vertex);
+
+    // Call pandora "fast" shower fitter
+    try {
+      // Access centroid of shower via this method
+      const lar_content::LArShowerPCA initialLArShowerPCA(
+        lar_content::LArPfoHelper::GetPrincipalComponents(candidate.m_points, vertexPosition));
+
+      // Ensure successful creation of all structures before placing results in output containers, remaking LArShowerPCA with updated vertex
+      const pandora::CartesianVector& centroid(initialLArShowerPCA.GetCentroid());
+      const pandora::CartesianVector& primaryAxis(initialLArShowerPCA.GetPrimaryAxis());
+      const pandora::CartesianVector& secondaryAxis(initialLArShowerPCA.GetSecondaryAxis());
+      const pandora::CartesianVector& tertiaryAxis(initialLArShowerPCA.GetTertiaryAxis());
+      const pandora::CartesianVector& eigenvalues(initialLArShowerPCA.GetEigenValues());
+
+      // Project the PFParticle vertex onto the PCA axis
+      const pandora::CartesianVector projectedVertexPosition(
+        centroid -
+        primaryAxis.GetUnitVector() * (centroid - vertexPosition).GetDotProduct(primaryAxis));
+
+      // By convention, principal axis should always point away from vertex
+      const float testProjection(primaryAxis.GetDotProduct(projectedVertexPosition - centroid));
+      const float directionScaleFactor(
+        (testProjection > std::numeric_limits<float>::epsilon()) ? -1.f : 1.f);
+
+      const lar_content::LArShowerPCA larShowerPCA(centroid,
+                                                   primaryAxis * directionScaleFactor,
+                                                   secondaryAxis * directionScaleFactor,
+                                                   tertiaryAxis * directionScaleFactor,
+                                                   eigenvalues);
+
+      return ShowerFit{larShowerPCA, projectedVertexPosition};
+    }
+    catch (const pandora::StatusCodeException&) {
+      return std::nullopt;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   recob::Shower
   LArPandoraShowerCreation::BuildShower(const int id,
                                         const lar_content::LArShowerPCA& larShowerPCA,
@@ -137,20 +137,48 @@ namespace ShowerRecoTools {
       return UniquePtrs->GetArtPtr<T>(Name, index);
     }
 
+    //As above but through the handle returned by InitialiseProduct or GetProductHandle.
+    template <class T>
+    art::Ptr<T>
+    GetProducedElementPtr(const reco::shower::ShowerProducedPtrHandle<std::vector<T>>& handle,
+                          reco::shower::ShowerElementHolder& ShowerEleHolder,
+                          int iter = -1)
+    {
+
+      //Check if the user has defined an index if not just use the current shower index/
+      int index;
+      if (iter != -1) { index = iter; }
+      else {
+        index = ShowerEleHolder.GetShowerNumber();
+      }
+
+      //Make the ptr
+      return UniquePtrs->GetArtPtr(handle, index);
+    }
+
     //Function so that the user can add products to the art event. This will set up the unique ptrs and the ptr makers required.
+    //The returned handle gives access to the product without looking it up by name for each shower.
     //Example: InitialiseProduct<std::vector<recob<vertex>>("MyVertex")
     template <class T>
-    void
+    reco::shower::ShowerProducedPtrHandle<T>
     InitialiseProduct(std::string Name, std::string InstanceName = "")
     {
 
       if (collectorPtr == nullptr) {
         mf::LogWarning("IShowerTool") << "The art::ProducesCollector ptr has not been set";
-        return;
+        return reco::shower::ShowerProducedPtrHandle<T>();
       }
 
       collectorPtr->produces<T>(InstanceName);
-      UniquePtrs->SetShowerUniqueProduerPtr(type<T>(), Name, InstanceName);
+      return UniquePtrs->SetShowerUniqueProduerPtr(type<T>(), Name, InstanceName);
+    }
+
+    //Get the handle of a product or association set by the module or another tool, e.g. the "shower".
+    template <class T>
+    reco::shower::ShowerProducedPtrHandle<T>
+    GetProductHandle(std::string Name) const
+    {
+      return UniquePtrs->GetHandle(type<T>(), Name);
     }
 
     //Function so that the user can add assocations to the event.
@@ -162,6 +190,14 @@ namespace ShowerRecoTools {
       UniquePtrs->AddSingle<T>(a, b, Name);
     }
 
+    //As above but through the handle returned by InitialiseProduct.
+    template <class T, class A, class B>
+    void
+    AddSingle(const reco::shower::ShowerProducedPtrHandle<T>& handle, A& a, B& b)
+    {
+      UniquePtrs->AddSingle(handle, a, b);
+    }
+
     //Function to get the size of the vector, for the event,  that is held in the unique producer ptr that will be put in the event.
     int
     GetVectorPtrSize(std::string Name)
@@ -169,6 +205,13 @@ namespace ShowerRecoTools {
       return UniquePtrs->GetVectorPtrSize(Name);
     }
 
+    template <class T>
+    int
+    GetVectorPtrSize(const reco::shower::ShowerProducedPtrHandle<std::vector<T>>& handle)
+    {
+      return UniquePtrs->GetVectorPtrSize(handle);
+    }
+
     void
     PrintPtrs()
     {
@@ -31,12 +31,26 @@ namespace ShowerRecoTools {
       const detinfo::DetectorPropertiesData& detProp,
       std::vector<art::Ptr<recob::Hit>>& hits);
 
+    //Running sums for a weighted regression fit, filled as the hits are selected.
+    struct WeightedFitSums {
+      Double_t sumx = 0.;
+      Double_t sumx2 = 0.;
+      Double_t sumy = 0.;
+      Double_t sumy2 = 0.;
+      Double_t sumxy = 0.;
+      Double_t sumw = 0.;
+      Int_t n = 0;
+
+      void Add(const Double_t x, const Double_t y, const Double_t w);
+    };
+
     //Function to perform a weighted regression fit.
-    Int_t WeightedFit(const Int_t n,
-                      const Double_t* x,
-                      const Double_t* y,
-                      const Double_t* w,
-                      Double_t* parm);
+    Int_t WeightedFit(const WeightedFitSums& sums, Double_t* parm);
+
+    //Hit coordinates and fit weights of the plane being fitted. Kept to reuse the memory.
+    std::vector<double> fWireCoords;
+    std::vector<double> fTimeCoords;
+    std::vector<double> fWeights;
 
     //fcl parameters
     unsigned int fNfitpass; //Number of time to fit the straight
@@ -111,9 +125,9 @@ namespace ShowerRecoTools {
     //Get the clusters
     auto const clusHandle = Event.getValidHandle<std::vector<recob::Cluster>>(fPFParticleLabel);
 
-    const art::FindManyP<recob::Cluster>& fmc =
-      ShowerEleHolder.GetFindManyP<recob::Cluster>(pfpHandle, Event, fPFParticleLabel);
-    std::vector<art::Ptr<recob::Cluster>> clusters = fmc.at(pfparticle.key());
+    const reco::shower::ShowerAssociationView<recob::Cluster>& fmc =
+      ShowerEleHolder.GetAssociationView<recob::Cluster>(pfpHandle, Event, fPFParticleLabel);
+    const auto clusters = fmc.at(pfparticle.key());
 
     if (clusters.size() < 2) {
       if (fVerbose)
@@ -123,20 +137,15 @@ namespace ShowerRecoTools {
     }
 
     //Get the hit association
-    const art::FindManyP<recob::Hit>& fmhc =
-      ShowerEleHolder.GetFindManyP<recob::Hit>(clusHandle, Event, fPFParticleLabel);
-    std::map<geo::PlaneID, std::vector<art::Ptr<recob::Hit>>> plane_clusters;
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmhc =
+      ShowerEleHolder.GetAssociationView<recob::Hit>(clusHandle, Event, fPFParticleLabel);
+    std::vector<art::Ptr<recob::Hit>> plane_clusters;
     //Loop over the clusters in the plane and get the hits
     for (auto const& cluster : clusters) {
 
       //Get the hits
-      std::vector<art::Ptr<recob::Hit>> hits = fmhc.at(cluster.key());
-
-      for (auto hit : hits) {
-        geo::WireID wire = hit->WireID();
-        geo::PlaneID plane = wire.asPlaneID();
-        plane_clusters[plane].push_back(hit);
-      }
+      const auto hits = fmhc.at(cluster.key());
+      plane_clusters.insert(plane_clusters.end(), hits.begin(), hits.end());
 
       // Was having issues with clusters having hits in multiple planes breaking PMA
       // So switched to the method above. May want to switch back when using PandoraTrack
@@ -148,12 +157,25 @@ namespace ShowerRecoTools {
     auto const detProp =
       art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(Event, clockData);
 
+    //Group the hits by plane, keeping the cluster order within each plane
+    std::stable_sort(plane_clusters.begin(),
+                     plane_clusters.end(),
+                     [](const art::Ptr<recob::Hit>& hitA, const art::Ptr<recob::Hit>& hitB) {
+                       return hitA->WireID().asPlaneID() < hitB->WireID().asPlaneID();
+                     });
+
     std::vector<art::Ptr<recob::Hit>> InitialTrackHits;
     //Loop over the clusters and order the hits and get the initial track hits in that plane
-    for (auto const& cluster : plane_clusters) {
+    for (auto planeBegin = plane_clusters.begin(); planeBegin != plane_clusters.end();) {
+
+      const geo::PlaneID plane = (*planeBegin)->WireID().asPlaneID();
+      auto planeEnd = std::find_if(planeBegin, plane_clusters.end(), [&plane](auto const& hit) {
+        return hit->WireID().asPlaneID() != plane;
+      });
 
       //Get the hits
-      std::vector<art::Ptr<recob::Hit>> hits = cluster.second;
+      std::vector<art::Ptr<recob::Hit>> hits(planeBegin, planeEnd);
+      planeBegin = planeEnd;
 
       //Order the hits
       IShowerTool::GetLArPandoraShowerAlg().OrderShowerHits(
@@ -173,13 +195,13 @@ namespace ShowerRecoTools {
     auto const hitHandle = Event.getValidHandle<std::vector<recob::Hit>>(fHitLabel);
 
     //get the sp<->hit association
-    const art::FindManyP<recob::SpacePoint>& fmsp =
-      ShowerEleHolder.GetFindManyP<recob::SpacePoint>(hitHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::SpacePoint>& fmsp =
+      ShowerEleHolder.GetAssociationView<recob::SpacePoint>(hitHandle, Event, fPFParticleLabel);
 
     //Get the spacepoints associated to the track hit
     std::vector<art::Ptr<recob::SpacePoint>> intitaltrack_sp;
     for (auto const& hit : InitialTrackHits) {
-      std::vector<art::Ptr<recob::SpacePoint>> sps = fmsp.at(hit.key());
+      const auto sps = fmsp.at(hit.key());
       for (auto const sp : sps) {
         intitaltrack_sp.push_back(sp);
       }
@@ -197,65 +219,76 @@ namespace ShowerRecoTools {
 
     std::vector<art::Ptr<recob::Hit>> trackHits;
 
+    //Not sure I am a fan of doing things in wire tick space. What if id doesn't not iterate properly or the
+    //two planes in each TPC are not symmetric.
+    //The coordinates do not change between the passes so get them once.
+    const size_t nPlaneHits = hits.size();
+    fWireCoords.resize(nPlaneHits);
+    fTimeCoords.resize(nPlaneHits);
+    fWeights.resize(nPlaneHits);
+    for (size_t hitIter = 0; hitIter < nPlaneHits; ++hitIter) {
+      const art::Ptr<recob::Hit>& hit = hits[hitIter];
+      const TVector2 coord = IShowerTool::GetLArPandoraShowerAlg().HitCoordinates(detProp, hit);
+      fWireCoords[hitIter] = coord.X();
+      fTimeCoords[hitIter] = coord.Y();
+      fWeights[hitIter] = fApplyChargeWeight ? hit->Integral() : 1.;
+    }
+
     double parm[2];
     int fitok = 0;
-    std::vector<double> wfit;
-    std::vector<double> tfit;
-    std::vector<double> cfit;
 
     for (size_t i = 0; i < fNfitpass; ++i) {
 
+      //Each pass only masks the hits away from the previous line, so accumulate the fit as we go
+      const bool useAllHits = (i == 0 || fitok == 1);
+      const double cosAngle = useAllHits ? 1. : std::cos(std::atan(parm[1]));
+      WeightedFitSums sums;
+
       // Fit a straight line through hits
       unsigned int nhits = 0;
-      for (auto& hit : hits) {
+      for (size_t hitIter = 0; hitIter < nPlaneHits; ++hitIter) {
 
-        //Not sure I am a fan of doing things in wire tick space. What if id doesn't not iterate properly or the
-        //two planes in each TPC are not symmetric.
-        TVector2 coord = IShowerTool::GetLArPandoraShowerAlg().HitCoordinates(detProp, hit);
+        const double wire = fWireCoords[hitIter];
+        const double time = fTimeCoords[hitIter];
 
-        if (i == 0 ||
-            (std::abs((coord.Y() - (parm[0] + coord.X() * parm[1])) *
-                      std::cos(std::atan(parm[1]))) < fToler[i - 1]) ||
-            fitok == 1) {
+        if (useAllHits ||
+            (std::abs((time - (parm[0] + wire * parm[1])) * cosAngle) < fToler[i - 1])) {
           ++nhits;
           if (nhits == fNfithits[i] + 1) break;
-          wfit.push_back(coord.X());
-          tfit.push_back(coord.Y());
-
-          if (fApplyChargeWeight) { cfit.push_back(hit->Integral()); }
-          else {
-            cfit.push_back(1.);
-          };
-          if (i == fNfitpass - 1) { trackHits.push_back(hit); }
+          sums.Add(wire, time, fWeights[hitIter]);
+          if (i == fNfitpass - 1) { trackHits.push_back(hits[hitIter]); }
         }
       }
 
-      if (i < fNfitpass - 1 && wfit.size()) {
-        fitok = WeightedFit(wfit.size(), &wfit[0], &tfit[0], &cfit[0], &parm[0]);
-      }
-
-      wfit.clear();
-      tfit.clear();
-      cfit.clear();
+      if (i < fNfitpass - 1 && sums.n) { fitok = WeightedFit(sums, &parm[0]); }
     }
     return trackHits;
   }
 
+  void
+  Shower2DLinearRegressionTrackHitFinder::WeightedFitSums::Add(const Double_t x,
+                                                               const Double_t y,
+                                                               const Double_t w)
+  {
+    sumx += x * w;
+    sumx2 += x * x * w;
+    sumy += y * w;
+    sumy2 += y * y * w;
+    sumxy += x * y * w;
+    sumw += w;
+    ++n;
+  }
+
   //Stolen from EMShowerAlg, a linear regression fitting function
   Int_t
-  Shower2DLinearRegressionTrackHitFinder::WeightedFit(const Int_t n,
-                                                      const Double_t* x,
-                                                      const Double_t* y,
-                                                      const Double_t* w,
-                                                      Double_t* parm)
+  Shower2DLinearRegressionTrackHitFinder::WeightedFit(const WeightedFitSums& sums, Double_t* parm)
   {
 
-    Double_t sumx = 0.;
-    Double_t sumx2 = 0.;
-    Double_t sumy = 0.;
-    Double_t sumy2 = 0.;
-    Double_t sumxy = 0.;
-    Double_t sumw = 0.;
+    const Double_t sumx = sums.sumx;
+    const Double_t sumx2 = sums.sumx2;
+    const Double_t sumy = sums.sumy;
+    const Double_t sumxy = sums.sumxy;
+    const Double_t sumw = sums.sumw;
     Double_t eparm[2];
 
     parm[0] = 0.;
@@ -263,15 +296,6 @@ namespace ShowerRecoTools {
     eparm[0] = 0.;
     eparm[1] = 0.;
 
-    for (Int_t i = 0; i < n; i++) {
-      sumx += x[i] * w[i];
-      sumx2 += x[i] * x[i] * w[i];
-      sumy += y[i] * w[i];
-      sumy2 += y[i] * y[i] * w[i];
-      sumxy += x[i] * y[i] * w[i];
-      sumw += w[i];
-    }
-
     if (sumx2 * sumw - sumx * sumx == 0.) return 1;
     if (sumx2 - sumx * sumx / sumw == 0.) return 1;
 
@@ -14,6 +14,10 @@
 #include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/LArPandoraShowerAlg.h"
 #include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Tools/IShowerTool.h"
 
+//C++ Includes
+#include <cmath>
+#include <limits>
+
 namespace ShowerRecoTools {
 
   class Shower3DCylinderTrackHitFinder : IShowerTool {
@@ -31,11 +35,21 @@ namespace ShowerRecoTools {
       TVector3& showerStartPosition,
       TVector3& showerDirection);
 
+    //Smallest squared distance whose square root is not below the given distance.
+    static double SquaredDistanceThreshold(const double dist);
+
     //Fcl paramters
     float fMaxProjectionDist;    //Maximum projection along shower direction.
     float fMaxPerpendicularDist; //Maximum perpendicular distance, radius of cylinder
     bool fForwardHitsOnly;       //Only take hits downstream of shower vertex
     //(projection>0)
+    bool fStopAtMaxProjection; //Stop at the first ordered spacepoint beyond the max projection
+
+    //Squared perpendicular distance cut, equivalent to the perpendicular distance cut.
+    double fMaxPerpendicularDist2;
+
+    //Reused spacepoint coordinates relative to the shower start, x,y,z per spacepoint.
+    std::vector<double> fSpacePointXYZ;
 
     art::InputTag fPFParticleLabel;
     int fVerbose;
@@ -51,6 +65,7 @@ namespace ShowerRecoTools {
     , fMaxProjectionDist(pset.get<float>("MaxProjectionDist"))
     , fMaxPerpendicularDist(pset.get<float>("MaxPerpendicularDist"))
     , fForwardHitsOnly(pset.get<bool>("ForwardHitsOnly"))
+    , fStopAtMaxProjection(pset.get<bool>("StopAtMaxProjection", false))
     , fPFParticleLabel(pset.get<art::InputTag>("PFParticleLabel"))
     , fVerbose(pset.get<int>("Verbose"))
     , fShowerStartPositionInputLabel(pset.get<std::string>("ShowerStartPositionInputLabel"))
@@ -58,7 +73,9 @@ namespace ShowerRecoTools {
     , fInitialTrackSpacePointsOutputLabel(
         pset.get<std::string>("InitialTrackSpacePointsOutputLabel"))
     , fShowerDirectionInputLabel(pset.get<std::string>("ShowerDirectionInputLabel"))
-  {}
+  {
+    fMaxPerpendicularDist2 = SquaredDistanceThreshold(fMaxPerpendicularDist);
+  }
 
   int
   Shower3DCylinderTrackHitFinder::CalculateElement(
@@ -91,18 +108,14 @@ namespace ShowerRecoTools {
     auto const pfpHandle = Event.getValidHandle<std::vector<recob::PFParticle>>(fPFParticleLabel);
 
     // Get the spacepoint - PFParticle assn
-    const art::FindManyP<recob::SpacePoint>& fmspp =
-      ShowerEleHolder.GetFindManyP<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::SpacePoint>& fmspp =
+      ShowerEleHolder.GetAssociationView<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
 
     // Get the spacepoints
     auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
 
-    // Get the hits associated with the space points
-    const art::FindManyP<recob::Hit>& fmhsp =
-      ShowerEleHolder.GetFindManyP<recob::Hit>(spHandle, Event, fPFParticleLabel);
-
     // Get the SpacePoints
-    std::vector<art::Ptr<recob::SpacePoint>> spacePoints = fmspp.at(pfparticle.key());
+    std::vector<art::Ptr<recob::SpacePoint>> spacePoints = fmspp.at(pfparticle.key()).ToVector();
 
     //We cannot progress with no spacepoints.
     if (spacePoints.empty()) {
@@ -120,12 +133,17 @@ namespace ShowerRecoTools {
     std::vector<art::Ptr<recob::SpacePoint>> trackSpacePoints;
     trackSpacePoints = FindTrackSpacePoints(spacePoints, ShowerStartPosition, ShowerDirection);
 
-    // Get the hits associated to the space points and seperate them by planes
+    // Get the hits associated with the space points
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmhsp =
+      ShowerEleHolder.GetAssociationView<recob::Hit>(spHandle, Event, fPFParticleLabel);
+
+    // Keep the first hit of each spacepoint
     std::vector<art::Ptr<recob::Hit>> trackHits;
+    trackHits.reserve(trackSpacePoints.size());
     for (auto const& spacePoint : trackSpacePoints) {
-      const art::Ptr<recob::Hit> hit = fmhsp.at(spacePoint.key()).front();
-      // const art::Ptr<recob::Hit> hit = fohsp.at(spacePoint.key());
-      trackHits.push_back(hit);
+      const auto hits = fmhsp.at(spacePoint.key());
+      if (hits.empty()) continue;
+      trackHits.push_back(hits.front());
     }
 
     ShowerEleHolder.SetElement(trackHits, fInitialTrackHitsOutputLabel);
@@ -144,22 +162,65 @@ namespace ShowerRecoTools {
     // Make a vector to hold the output space points
     std::vector<art::Ptr<recob::SpacePoint>> trackSpacePoints;
 
-    for (const auto& spacePoint : spacePoints) {
-      // Calculate the projection along direction and perpendicular distance
-      // from "axis" of shower TODO: change alg to return a pair for efficiency
-      double proj = IShowerTool::GetLArPandoraShowerAlg().SpacePointProjection(
-        spacePoint, showerStartPosition, showerDirection);
-      double perp = IShowerTool::GetLArPandoraShowerAlg().SpacePointPerpendicular(
-        spacePoint, showerStartPosition, showerDirection, proj);
+    const size_t nSpacePoints(spacePoints.size());
+
+    // Copy the positions relative to the shower start into one contiguous array
+    fSpacePointXYZ.resize(3 * nSpacePoints);
+    for (size_t spIter = 0; spIter < nSpacePoints; ++spIter) {
+      const Double32_t* sp_xyz = spacePoints[spIter]->XYZ();
+      fSpacePointXYZ[3 * spIter] = sp_xyz[0] - showerStartPosition.X();
+      fSpacePointXYZ[3 * spIter + 1] = sp_xyz[1] - showerStartPosition.Y();
+      fSpacePointXYZ[3 * spIter + 2] = sp_xyz[2] - showerStartPosition.Z();
+    }
+
+    const double dirX(showerDirection.X());
+    const double dirY(showerDirection.Y());
+    const double dirZ(showerDirection.Z());
+
+    for (size_t spIter = 0; spIter < nSpacePoints; ++spIter) {
+      const double* pos = &fSpacePointXYZ[3 * spIter];
+
+      // Calculate the projection along direction, in the same order as SpacePointProjection
+      const double proj = pos[0] * dirX + pos[1] * dirY + pos[2] * dirZ;
 
       if (fForwardHitsOnly && proj < 0) continue;
 
-      if (std::abs(proj) < fMaxProjectionDist && std::abs(perp) < fMaxPerpendicularDist)
-        trackSpacePoints.push_back(spacePoint);
+      // The spacepoints are ordered by projection so none of the rest can pass
+      if (fStopAtMaxProjection && proj >= fMaxProjectionDist) break;
+
+      if (!(std::abs(proj) < fMaxProjectionDist)) continue;
+
+      // Perpendicular distance from the "axis" of the shower, squared to avoid the square root
+      const double perpX = pos[0] - proj * dirX;
+      const double perpY = pos[1] - proj * dirY;
+      const double perpZ = pos[2] - proj * dirZ;
+      const double perp2 = perpX * perpX + perpY * perpY + perpZ * perpZ;
+
+      if (perp2 < fMaxPerpendicularDist2) trackSpacePoints.push_back(spacePoints[spIter]);
     }
     return trackSpacePoints;
   }
 
+  double
+  Shower3DCylinderTrackHitFinder::SquaredDistanceThreshold(const double dist)
+  {
+
+    // No distance passes a cut at or below zero
+    if (dist <= 0) return 0;
+
+    // Step dist*dist to the smallest value with sqrt(value) >= dist so that
+    // perp2 < threshold selects exactly the points with sqrt(perp2) < dist
+    double threshold = dist * dist;
+    while (std::sqrt(threshold) < dist)
+      threshold = std::nextafter(threshold, std::numeric_limits<double>::max());
+    double lower = std::nextafter(threshold, 0.);
+    while (std::sqrt(lower) >= dist) {
+      threshold = lower;
+      lower = std::nextafter(threshold, 0.);
+    }
+    return threshold;
+  }
+
 }
 
 DEFINE_ART_CLASS_TOOL(ShowerRecoTools::Shower3DCylinderTrackHitFinder)
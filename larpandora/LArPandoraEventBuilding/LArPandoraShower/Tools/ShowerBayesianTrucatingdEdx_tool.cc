@@ -32,12 +32,24 @@ namespace ShowerRecoTools {
                          reco::shower::ShowerElementHolder& ShowerEleHolder) override;
 
   private:
-    double CalculatePosterior(std::string priorname,
-                              std::vector<double>& values,
+    //The prior histogram bin contents, read once when the tool is made. Bin 0 is the underflow.
+    struct PriorTable {
+      TAxis axis;
+      std::vector<double> binContents;
+    };
+
+    PriorTable& GetPrior(const std::string& priorname);
+    PriorTable& GetOtherPrior(const std::string& priorname);
+
+    double CalculatePosterior(PriorTable& prior,
+                              PriorTable& other,
+                              const std::vector<double>& values,
                               int& minprob,
                               float& mean,
                               float& likelihood);
-    double CalculatePosterior(std::string priorname, std::vector<double>& values);
+    double CalculatePosterior(PriorTable& prior,
+                              PriorTable& other,
+                              const std::vector<double>& values);
 
     bool
     isProbabilityGood(float& old_prob, float& new_prob)
@@ -51,29 +63,28 @@ namespace ShowerRecoTools {
       return (old_posteior - prob) < fPostiorCut;
     }
 
-    bool CheckPoint(std::string priorname, double& value);
+    bool CheckPoint(PriorTable& prior, const double value);
 
     std::vector<double> GetLikelihooddEdxVec(double& electronprob,
                                              double& photonprob,
                                              std::string prior,
-                                             std::vector<double>& dEdxVec);
+                                             const std::vector<double>& dEdxVec);
 
-    std::vector<double> MakeSeed(std::vector<double>& dEdxVec);
+    std::vector<double> MakeSeed(const std::vector<double>& dEdxVec, size_t& dEdxIter);
 
     void ForceSeedToFit(std::vector<double>& SeedTrack,
-                        std::string& prior,
+                        PriorTable& prior,
+                        PriorTable& other,
                         float& mean,
                         double& posterior);
 
-    void RecurivelyAddHit(std::vector<double>& SeedTrack,
-                          std::vector<double>& dEdxVec,
-                          std::string& prior,
-                          int& SkippedHitsNum,
-                          float& old_mean,
-                          double& old_posteior);
+    void AddHits(std::vector<double>& SeedTrack,
+                 const std::vector<double>& dEdxVec,
+                 size_t dEdxIter,
+                 PriorTable& prior);
 
-    TH1F* electronpriorHist;
-    TH1F* photonpriorHist;
+    PriorTable fElectronPrior;
+    PriorTable fPhotonPrior;
 
     //fcl params
     int fVerbose;
@@ -118,11 +129,11 @@ namespace ShowerRecoTools {
     }
 
     //Get the histograms.
-    electronpriorHist = dynamic_cast<TH1F*>(fin.Get(electron_histoname.c_str()));
+    TH1F* electronpriorHist = dynamic_cast<TH1F*>(fin.Get(electron_histoname.c_str()));
     if (!electronpriorHist) {
       throw cet::exception("ShowerBayesianTrucatingdEdx") << "Could not read the electron hist";
     }
-    photonpriorHist = dynamic_cast<TH1F*>(fin.Get(photon_histoname.c_str()));
+    TH1F* photonpriorHist = dynamic_cast<TH1F*>(fin.Get(photon_histoname.c_str()));
     if (!photonpriorHist) {
       throw cet::exception("ShowerBayesianTrucatingdEdx") << "Could not read the photon hist ";
     }
@@ -134,6 +145,17 @@ namespace ShowerRecoTools {
     //Normalise the histograms.
     electronpriorHist->Scale(1 / electronpriorHist->Integral());
     photonpriorHist->Scale(1 / photonpriorHist->Integral());
+
+    //Tabulate the priors, including the under and overflow, as the histograms go with the file.
+    auto tabulatePrior = [](TH1F* hist, PriorTable& table) {
+      table.axis = *hist->GetXaxis();
+      table.binContents.resize(hist->GetNbinsX() + 2);
+      for (int bin = 0; bin < hist->GetNbinsX() + 2; ++bin) {
+        table.binContents[bin] = hist->GetBinContent(bin);
+      }
+    };
+    tabulatePrior(electronpriorHist, fElectronPrior);
+    tabulatePrior(photonpriorHist, fPhotonPrior);
   }
 
   int
@@ -170,7 +192,7 @@ namespace ShowerRecoTools {
         continue;
       }
 
-      std::vector<double> dEdx_vec = dEdx_vec_plane.second;
+      const std::vector<double>& dEdx_vec = dEdx_vec_plane.second;
 
       double electronprob_eprior = 0;
       double photonprob_eprior = 0;
@@ -230,19 +252,35 @@ namespace ShowerRecoTools {
     return 0;
   }
 
+  ShowerBayesianTrucatingdEdx::PriorTable&
+  ShowerBayesianTrucatingdEdx::GetPrior(const std::string& priorname)
+  {
+    if (priorname == "electron") { return fElectronPrior; }
+    if (priorname == "photon") { return fPhotonPrior; }
+    throw cet::exception("ShowerBayesianTrucatingdEdx") << "Unknown prior: " << priorname;
+  }
+
+  ShowerBayesianTrucatingdEdx::PriorTable&
+  ShowerBayesianTrucatingdEdx::GetOtherPrior(const std::string& priorname)
+  {
+    return GetPrior(priorname == "electron" ? "photon" : "electron");
+  }
+
   double
-  ShowerBayesianTrucatingdEdx::CalculatePosterior(std::string priorname,
-                                                  std::vector<double>& values)
+  ShowerBayesianTrucatingdEdx::CalculatePosterior(PriorTable& prior,
+                                                  PriorTable& other,
+                                                  const std::vector<double>& values)
   {
     int minprob_iter = -999;
     float mean = -999;
     float likelihood = -999;
-    return CalculatePosterior(priorname, values, minprob_iter, mean, likelihood);
+    return CalculatePosterior(prior, other, values, minprob_iter, mean, likelihood);
   }
 
   double
-  ShowerBayesianTrucatingdEdx::CalculatePosterior(std::string priorname,
-                                                  std::vector<double>& values,
+  ShowerBayesianTrucatingdEdx::CalculatePosterior(PriorTable& prior,
+                                                  PriorTable& other,
+                                                  const std::vector<double>& values,
                                                   int& minprob_iter,
                                                   float& mean,
                                                   float& likelihood)
@@ -258,34 +296,22 @@ namespace ShowerRecoTools {
     float minprob_temp = 9999;
     minprob_iter = 0;
 
-    TH1F* prior_hist = nullptr;
-    TH1F* other_hist = nullptr;
-
-    if (priorname == "electron") {
-      prior_hist = electronpriorHist;
-      other_hist = photonpriorHist;
-    }
-    if (priorname == "photon") {
-      prior_hist = photonpriorHist;
-      other_hist = electronpriorHist;
-    }
-
-    TAxis* xaxis = prior_hist->GetXaxis();
+    TAxis& xaxis = prior.axis;
 
     //Loop over the hits and calculate the probability
     for (int i = 0; i < (int)values.size(); ++i) {
 
       float value = values[i];
 
-      Int_t bin = xaxis->FindBin(value);
+      Int_t bin = xaxis.FindBin(value);
 
       float prob = -9999;
       float other_prob = -9999;
 
-      if (bin != xaxis->GetNbins() || bin == 0) {
+      if (bin != xaxis.GetNbins() || bin == 0) {
         //Calculate the likelihood
-        prob = prior_hist->GetBinContent(bin);
-        other_prob = other_hist->GetBinContent(bin);
+        prob = prior.binContents[bin];
+        other_prob = other.binContents[bin];
       }
       else {
         prob = 0;
@@ -300,7 +326,7 @@ namespace ShowerRecoTools {
       if (prob == 0 && other_prob == 0) { continue; }
 
       //Calculate the posterior the mean probability and liklihood
-      meanprob += prior_hist->GetBinContent(bin);
+      meanprob += prior.binContents[bin];
       likelihood *= prob;
       likelihood_other *= other_prob;
     }
@@ -313,23 +339,18 @@ namespace ShowerRecoTools {
   }
 
   bool
-  ShowerBayesianTrucatingdEdx::CheckPoint(std::string priorname, double& value)
+  ShowerBayesianTrucatingdEdx::CheckPoint(PriorTable& prior, const double value)
   {
 
-    TH1F* prior_hist = nullptr;
-
-    if (priorname == "electron") { prior_hist = electronpriorHist; }
-    if (priorname == "photon") { prior_hist = photonpriorHist; }
-
-    TAxis* xaxis = prior_hist->GetXaxis();
+    TAxis& xaxis = prior.axis;
 
-    Int_t bin = xaxis->FindBin(value);
+    Int_t bin = xaxis.FindBin(value);
 
     float prob = -9999;
 
-    if (bin != xaxis->GetNbins() + 1 || bin == 0) {
+    if (bin != xaxis.GetNbins() + 1 || bin == 0) {
       //Calculate the likelihood
-      prob = prior_hist->GetBinContent(bin);
+      prob = prior.binContents[bin];
     }
     else {
       prob = 0;
@@ -342,127 +363,96 @@ namespace ShowerRecoTools {
   std::vector<double>
   ShowerBayesianTrucatingdEdx::GetLikelihooddEdxVec(double& electronprob,
                                                     double& photonprob,
-                                                    std::string prior,
-                                                    std::vector<double>& dEdxVec)
+                                                    std::string priorname,
+                                                    const std::vector<double>& dEdxVec)
   {
 
-    //have a pool
-    std::vector<double> dEdxVec_temp = dEdxVec;
+    PriorTable& prior = GetPrior(priorname);
+    PriorTable& other = GetOtherPrior(priorname);
 
-    //Get The seed track.
-    std::vector<double> SeedTrack = MakeSeed(dEdxVec_temp);
-    //    if(SeedTrack.size() < 1){
-    //  return SeedTrack;
-    // }
+    //Get The seed track. The cursor points to the first value not in the seed.
+    size_t dEdxIter = 0;
+    std::vector<double> SeedTrack = MakeSeed(dEdxVec, dEdxIter);
 
     //Force the seed the be a good likelihood.
     float mean = 999;
     double posterior = 999;
-    ForceSeedToFit(SeedTrack, prior, mean, posterior);
+    ForceSeedToFit(SeedTrack, prior, other, mean, posterior);
 
-    //Recursively add dEdx
-    int SkippedHitsNum = 0;
-    RecurivelyAddHit(SeedTrack, dEdxVec_temp, prior, SkippedHitsNum, mean, posterior);
+    //Add the rest of the dEdx values
+    AddHits(SeedTrack, dEdxVec, dEdxIter, prior);
 
     //Calculate the likelihood of the vector  with the photon and electron priors.
-    electronprob = CalculatePosterior("electron", SeedTrack);
-    photonprob = CalculatePosterior("photon", SeedTrack);
+    electronprob = CalculatePosterior(fElectronPrior, fPhotonPrior, SeedTrack);
+    photonprob = CalculatePosterior(fPhotonPrior, fElectronPrior, SeedTrack);
 
     return SeedTrack;
   }
 
   std::vector<double>
-  ShowerBayesianTrucatingdEdx::MakeSeed(std::vector<double>& dEdxVec)
+  ShowerBayesianTrucatingdEdx::MakeSeed(const std::vector<double>& dEdxVec, size_t& dEdxIter)
   {
 
-    std::vector<double> seed_vector;
-
     //Add the first hits to the seed
     int MaxHit = fNumSeedHits;
     if (fNumSeedHits > (int)dEdxVec.size()) { MaxHit = (int)dEdxVec.size(); }
+    if (MaxHit < 0) { MaxHit = 0; }
 
-    //    if(MaxHit == 0){
-    //  mf::LogError("ShowerBayesianTrucatingdEdx") << "Size of the vector is 0 cannot perform the dEdx cutting "<< std::endl;
-    //}
-
-    for (int hit_iter = 0; hit_iter < MaxHit; ++hit_iter) {
-      seed_vector.push_back(dEdxVec[0]);
-      dEdxVec.erase(dEdxVec.begin());
-    }
-
-    return seed_vector;
+    dEdxIter = MaxHit;
+    return std::vector<double>(dEdxVec.begin(), dEdxVec.begin() + MaxHit);
   }
 
+  //The seed is at most NumSeedHits long, so the posterior is recalculated from scratch after each removal.
+  //This keeps the products in the same order, and so the same rounding, as before.
   void
   ShowerBayesianTrucatingdEdx::ForceSeedToFit(std::vector<double>& SeedTrack,
-                                              std::string& prior,
+                                              PriorTable& prior,
+                                              PriorTable& other,
                                               float& mean,
                                               double& posterior)
   {
 
     int minprob_iter = 999;
     float likelihood = -999;
-    float prob = CalculatePosterior(prior, SeedTrack, minprob_iter, mean, likelihood);
+    float prob = CalculatePosterior(prior, other, SeedTrack, minprob_iter, mean, likelihood);
     while ((mean < fProbSeedCut || prob <= 0) && SeedTrack.size() > 1) {
 
       //Remove the the worse point.
-      // std::cout << "removing hit with dEdx: " << SeedTrack.at(minprob_iter) << std::endl;
       SeedTrack.erase(SeedTrack.begin() + minprob_iter);
       minprob_iter = 999;
 
       //Recalculate
-      prob = CalculatePosterior(prior, SeedTrack, minprob_iter, mean, likelihood);
+      prob = CalculatePosterior(prior, other, SeedTrack, minprob_iter, mean, likelihood);
     }
     posterior = prob;
-    // std::cout << "seed has been fit with size: " << SeedTrack.size() << std::endl;
     return;
   }
 
   void
-  ShowerBayesianTrucatingdEdx::RecurivelyAddHit(std::vector<double>& SeedTrack,
-                                                std::vector<double>& dEdxVec,
-                                                std::string& prior,
-                                                int& SkippedHitsNum,
-                                                float& old_mean,
-                                                double& old_posteior)
+  ShowerBayesianTrucatingdEdx::AddHits(std::vector<double>& SeedTrack,
+                                       const std::vector<double>& dEdxVec,
+                                       size_t dEdxIter,
+                                       PriorTable& prior)
   {
 
-    //If we have no more hits to add then lets finish.
-    if (dEdxVec.size() < 1) { return; }
-
-    bool ok = CheckPoint(prior, dEdxVec[0]);
-    // int minprob_iter=999;
-    // float mean = -999;
-    // float likelihood =999;
-    // if(ok){std::cout << "passed first cut" << std::endl;}
-    // else{std::cout << "failed first cut" << std::endl;}
-    // double prob = CalculatePosterior(prior,SeedTrack,minprob_iter,mean,likelihood);
-    // ok *= isProbabilityGood(mean,old_mean);
-    // if(ok){std::cout << "passed second cut" << std::endl;}
-    // else{std::cout << "failed second cut" << std::endl;}
-    // ok *= isPosteriorProbabilityGood(prob,old_posteior);
-    // if(ok){std::cout << "passed this cut" << std::endl;}
-    // else{std::cout << "failed third cut" << std::endl;}
-
-    //If we failed lets try the next hits
-    if (!ok) {
-      // std::cout << "failed the pass point: " << dEdxVec[0] << " trying another hit" << SkippedHitsNum << std::endl;
-      //if(SeedTrack.size() > 1){SeedTrack.pop_back();}
-      ++SkippedHitsNum;
-      if (SkippedHitsNum > fnSkipHits) { return; }
-    }
-    else {
-      //Add the next point in question.
-      // std::cout << "adding value: " << dEdxVec[0] << std::endl;
-      //Reset the skip number
-      SkippedHitsNum = 0;
-      SeedTrack.push_back(dEdxVec[0]);
-    }
+    int SkippedHitsNum = 0;
 
-    //We have analysed this hit now lets remove it.
-    dEdxVec.erase(dEdxVec.begin());
+    //Keep adding hits until we run out or too many in a row fail.
+    for (; dEdxIter < dEdxVec.size(); ++dEdxIter) {
 
-    RecurivelyAddHit(SeedTrack, dEdxVec, prior, SkippedHitsNum, old_mean, old_posteior);
+      bool ok = CheckPoint(prior, dEdxVec[dEdxIter]);
+
+      //If we failed lets try the next hits
+      if (!ok) {
+        ++SkippedHitsNum;
+        if (SkippedHitsNum > fnSkipHits) { return; }
+      }
+      else {
+        //Reset the skip number and add the point in question.
+        SkippedHitsNum = 0;
+        SeedTrack.push_back(dEdxVec[dEdxIter]);
+      }
+    }
 
     return;
   }
@@ -37,6 +37,12 @@ namespace ShowerRecoTools {
     //prehaps you want a fcl parameter.
     art::InputTag fPFParticleLabel;
     int fVerbose;
+
+    //Handles to the products, set when the producers are initialised.
+    reco::shower::ShowerProducedPtrHandle<std::vector<recob::Shower>> fShowerHandle;
+    reco::shower::ShowerProducedPtrHandle<std::vector<recob::Vertex>> fVertexHandle;
+    reco::shower::ShowerProducedPtrHandle<art::Assns<recob::Shower, recob::Vertex>>
+      fShowerVertexAssnHandle;
   };
 
   ShowerExampleTool::ShowerExampleTool(const fhicl::ParameterSet& pset)
@@ -50,10 +56,15 @@ namespace ShowerRecoTools {
   ShowerExampleTool::InitialiseProducers()
   {
     //Do you create something and you want to save it the event. Initialsie here. For every event with have a vector of showers so each one has a vertex. This is what we are saving. Make sure to use the name "myvertex" later down the line.
-    InitialiseProduct<std::vector<recob::Vertex>>("myvertex");
+    //Keep the handle that is returned so the product can be accessed quickly for each shower.
+    fVertexHandle = InitialiseProduct<std::vector<recob::Vertex>>("myvertex");
 
     //We can also do associations
-    InitialiseProduct<art::Assns<recob::Shower, recob::Vertex>>("myvertexassan");
+    fShowerVertexAssnHandle =
+      InitialiseProduct<art::Assns<recob::Shower, recob::Vertex>>("myvertexassan");
+
+    //The module's products can be accessed in the same way
+    fShowerHandle = GetProductHandle<std::vector<recob::Shower>>("shower");
   }
 
   int
@@ -147,13 +158,13 @@ namespace ShowerRecoTools {
     }
 
     //Then you can get the size of the vector which the unique ptr hold so that you can do associations. If you are comfortable in the fact that your element will always be made when a shower is made you don't need to to do this you can just get the art ptr as:      const art::Ptr<recob::Vertex> vertexptr = GetProducedElementPtr<recob::Vertex>("myvertex", ShowerEleHolder);. Note doing this when you allow partial showers to be set can screw up the assocation for the partial shower.
-    int ptrsize = GetVectorPtrSize("myvertex");
+    //The names can be used instead of the handles, e.g. GetVectorPtrSize("myvertex"), but these are looked up each time.
+    int ptrsize = GetVectorPtrSize(fVertexHandle);
 
     const art::Ptr<recob::Vertex> vertexptr =
-      GetProducedElementPtr<recob::Vertex>("myvertex", ShowerEleHolder, ptrsize);
-    const art::Ptr<recob::Shower> showerptr =
-      GetProducedElementPtr<recob::Shower>("shower", ShowerEleHolder);
-    AddSingle<art::Assns<recob::Shower, recob::Vertex>>(showerptr, vertexptr, "myvertexassan");
+      GetProducedElementPtr(fVertexHandle, ShowerEleHolder, ptrsize);
+    const art::Ptr<recob::Shower> showerptr = GetProducedElementPtr(fShowerHandle, ShowerEleHolder);
+    AddSingle(fShowerVertexAssnHandle, showerptr, vertexptr);
 
     return 0;
   }
@@ -14,7 +14,6 @@
 
 //Root Includes
 #include "TGraph2D.h"
-#include "TPrincipal.h"
 
 namespace ShowerRecoTools {
 
@@ -32,7 +31,7 @@ namespace ShowerRecoTools {
     std::vector<art::Ptr<recob::SpacePoint>> RunIncrementalSpacePointFinder(
       const art::Event& Event,
       std::vector<art::Ptr<recob::SpacePoint>> const& sps,
-      const art::FindManyP<recob::Hit>& fmh);
+      const reco::shower::ShowerAssociationView<recob::Hit>& fmh);
 
     void PruneFrontOfSPSPool(std::vector<art::Ptr<recob::SpacePoint>>& sps_pool,
                              std::vector<art::Ptr<recob::SpacePoint>> const& initial_track);
@@ -49,26 +48,28 @@ namespace ShowerRecoTools {
                                  const detinfo::DetectorPropertiesData& detProp,
                                  std::vector<art::Ptr<recob::SpacePoint>>& segment,
                                  std::vector<art::Ptr<recob::SpacePoint>>& sps_pool,
-                                 const art::FindManyP<recob::Hit>& fmh,
+                                 const reco::shower::ShowerAssociationView<recob::Hit>& fmh,
                                  double current_residual);
 
-    double FitSegmentAndCalculateResidual(const detinfo::DetectorClocksData& clockData,
-                                          const detinfo::DetectorPropertiesData& detProp,
-                                          std::vector<art::Ptr<recob::SpacePoint>>& segment,
-                                          const art::FindManyP<recob::Hit>& fmh);
+    double FitSegmentAndCalculateResidual(
+      const detinfo::DetectorClocksData& clockData,
+      const detinfo::DetectorPropertiesData& detProp,
+      std::vector<art::Ptr<recob::SpacePoint>>& segment,
+      const reco::shower::ShowerAssociationView<recob::Hit>& fmh);
 
-    double FitSegmentAndCalculateResidual(const detinfo::DetectorClocksData& clockData,
-                                          const detinfo::DetectorPropertiesData& detProp,
-                                          std::vector<art::Ptr<recob::SpacePoint>>& segment,
-                                          const art::FindManyP<recob::Hit>& fmh,
-                                          int& max_residual_point);
+    double FitSegmentAndCalculateResidual(
+      const detinfo::DetectorClocksData& clockData,
+      const detinfo::DetectorPropertiesData& detProp,
+      std::vector<art::Ptr<recob::SpacePoint>>& segment,
+      const reco::shower::ShowerAssociationView<recob::Hit>& fmh,
+      int& max_residual_point);
 
     bool RecursivelyReplaceLastSpacePointAndRefit(
       const detinfo::DetectorClocksData& clockData,
       const detinfo::DetectorPropertiesData& detProp,
       std::vector<art::Ptr<recob::SpacePoint>>& segment,
       std::vector<art::Ptr<recob::SpacePoint>>& reduced_sps_pool,
-      const art::FindManyP<recob::Hit>& fmh,
+      const reco::shower::ShowerAssociationView<recob::Hit>& fmh,
       double current_residual);
 
     bool
@@ -103,20 +104,21 @@ namespace ShowerRecoTools {
     TVector3 ShowerPCAVector(const detinfo::DetectorClocksData& clockData,
                              const detinfo::DetectorPropertiesData& detProp,
                              const std::vector<art::Ptr<recob::SpacePoint>>& sps,
-                             const art::FindManyP<recob::Hit>& fmh);
+                             const reco::shower::ShowerAssociationView<recob::Hit>& fmh);
 
     std::vector<art::Ptr<recob::SpacePoint>> CreateFakeShowerTrajectory(TVector3 start_position,
                                                                         TVector3 start_direction);
     std::vector<art::Ptr<recob::SpacePoint>> CreateFakeSPLine(TVector3 start_position,
                                                               TVector3 start_direction,
                                                               int npoints);
-    void RunTestOfIncrementalSpacePointFinder(const art::Event& Event,
-                                              const art::FindManyP<recob::Hit>& dud_fmh);
+    void RunTestOfIncrementalSpacePointFinder(
+      const art::Event& Event,
+      const reco::shower::ShowerAssociationView<recob::Hit>& dud_fmh);
 
     void MakeTrackSeed(const detinfo::DetectorClocksData& clockData,
                        const detinfo::DetectorPropertiesData& detProp,
                        std::vector<art::Ptr<recob::SpacePoint>>& segment,
-                       const art::FindManyP<recob::Hit>& fmh);
+                       const reco::shower::ShowerAssociationView<recob::Hit>& fmh);
 
     //Services
     art::InputTag fPFParticleLabel;
@@ -189,18 +191,18 @@ namespace ShowerRecoTools {
     auto const pfpHandle = Event.getValidHandle<std::vector<recob::PFParticle>>(fPFParticleLabel);
 
     // Get the spacepoint - PFParticle assn
-    const art::FindManyP<recob::SpacePoint>& fmspp =
-      ShowerEleHolder.GetFindManyP<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::SpacePoint>& fmspp =
+      ShowerEleHolder.GetAssociationView<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
 
     // Get the spacepoints
     auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
 
     // Get the hits associated with the space points
-    const art::FindManyP<recob::Hit>& fmh =
-      ShowerEleHolder.GetFindManyP<recob::Hit>(spHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmh =
+      ShowerEleHolder.GetAssociationView<recob::Hit>(spHandle, Event, fPFParticleLabel);
 
     // Get the SpacePoints
-    std::vector<art::Ptr<recob::SpacePoint>> spacePoints = fmspp.at(pfparticle.key());
+    std::vector<art::Ptr<recob::SpacePoint>> spacePoints = fmspp.at(pfparticle.key()).ToVector();
 
     //We cannot progress with no spacepoints.
     if (spacePoints.empty()) {
@@ -286,8 +288,7 @@ namespace ShowerRecoTools {
     // Get the hits associated to the space points and seperate them by planes
     std::vector<art::Ptr<recob::Hit>> trackHits;
     for (auto const& spacePoint : track_sps) {
-      std::vector<art::Ptr<recob::Hit>> hits = fmh.at(spacePoint.key());
-      for (auto const& hit : hits) {
+      for (auto const& hit : fmh.at(spacePoint.key())) {
         trackHits.push_back(hit);
       }
     }
@@ -304,33 +305,21 @@ namespace ShowerRecoTools {
   {
 
     //Initialise the the PCA.
-    TPrincipal* pca = new TPrincipal(3, "");
+    shower::LArPandoraShowerAlg::PCAAccumulator pcaAccumulator;
 
     //Normalise the spacepoints, charge weight and add to the PCA.
     for (auto& sp : sps) {
 
       TVector3 sp_position = IShowerTool::GetLArPandoraShowerAlg().SpacePointPosition(sp);
 
-      double sp_coord[3];
-      sp_coord[0] = sp_position.X();
-      sp_coord[1] = sp_position.Y();
-      sp_coord[2] = sp_position.Z();
-
       //Add to the PCA
-      pca->AddRow(sp_coord);
+      pcaAccumulator.Add(sp_position);
     }
 
-    //Evaluate the PCA
-    pca->MakePrincipals();
-
-    //Get the Eigenvectors.
-    const TMatrixD* Eigenvectors = pca->GetEigenVectors();
-
-    TVector3 Eigenvector = {(*Eigenvectors)[0][0], (*Eigenvectors)[1][0], (*Eigenvectors)[2][0]};
-
-    delete pca;
-
-    return Eigenvector;
+    //Evaluate the PCA and get the primary eigenvector.
+    return IShowerTool::GetLArPandoraShowerAlg()
+      .PrincipalComponents(pcaAccumulator)
+      .eigenVectors[0];
   }
 
   //Function to calculate the shower direction using a charge weight 3D PCA calculation.
@@ -339,11 +328,11 @@ namespace ShowerRecoTools {
     const detinfo::DetectorClocksData& clockData,
     const detinfo::DetectorPropertiesData& detProp,
     const std::vector<art::Ptr<recob::SpacePoint>>& sps,
-    const art::FindManyP<recob::Hit>& fmh)
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmh)
   {
 
     //Initialise the the PCA.
-    TPrincipal* pca = new TPrincipal(3, "");
+    shower::LArPandoraShowerAlg::PCAAccumulator pcaAccumulator;
 
     float TotalCharge = 0;
 
@@ -371,35 +360,24 @@ namespace ShowerRecoTools {
         wht *= std::sqrt(Charge / TotalCharge);
       }
 
-      double sp_coord[3];
-      sp_coord[0] = sp_position.X() * wht;
-      sp_coord[1] = sp_position.Y() * wht;
-      sp_coord[2] = sp_position.Z() * wht;
-
       //Add to the PCA
-      pca->AddRow(sp_coord);
+      pcaAccumulator.Add(sp_position.X() * wht, sp_position.Y() * wht, sp_position.Z() * wht);
     }
 
-    //Evaluate the PCA
-    pca->MakePrincipals();
-
-    //Get the Eigenvectors.
-    const TMatrixD* Eigenvectors = pca->GetEigenVectors();
-
-    TVector3 Eigenvector = {(*Eigenvectors)[0][0], (*Eigenvectors)[1][0], (*Eigenvectors)[2][0]};
-
-    delete pca;
-
-    return Eigenvector;
+    //Evaluate the PCA and get the primary eigenvector.
+    return IShowerTool::GetLArPandoraShowerAlg()
+      .PrincipalComponents(pcaAccumulator)
+      .eigenVectors[0];
   }
 
   //Function to remove the spacepoint with the highest residual until we have a track which matches the
   //residual criteria.
   void
-  ShowerIncrementalTrackHitFinder::MakeTrackSeed(const detinfo::DetectorClocksData& clockData,
-                                                 const detinfo::DetectorPropertiesData& detProp,
-                                                 std::vector<art::Ptr<recob::SpacePoint>>& segment,
-                                                 const art::FindManyP<recob::Hit>& fmh)
+  ShowerIncrementalTrackHitFinder::MakeTrackSeed(
+    const detinfo::DetectorClocksData& clockData,
+    const detinfo::DetectorPropertiesData& detProp,
+    std::vector<art::Ptr<recob::SpacePoint>>& segment,
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmh)
   {
 
     bool ok = true;
@@ -437,7 +415,7 @@ namespace ShowerRecoTools {
   ShowerIncrementalTrackHitFinder::RunIncrementalSpacePointFinder(
     const art::Event& Event,
     std::vector<art::Ptr<recob::SpacePoint>> const& sps,
-    const art::FindManyP<recob::Hit>& fmh)
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmh)
   {
 
     auto const clockData =
@@ -570,7 +548,7 @@ namespace ShowerRecoTools {
     const detinfo::DetectorPropertiesData& detProp,
     std::vector<art::Ptr<recob::SpacePoint>>& segment,
     std::vector<art::Ptr<recob::SpacePoint>>& sps_pool,
-    const art::FindManyP<recob::Hit>& fmh,
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmh,
     double current_residual)
   {
 
@@ -636,7 +614,7 @@ namespace ShowerRecoTools {
     const detinfo::DetectorClocksData& clockData,
     const detinfo::DetectorPropertiesData& detProp,
     std::vector<art::Ptr<recob::SpacePoint>>& segment,
-    const art::FindManyP<recob::Hit>& fmh)
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmh)
   {
 
     TVector3 primary_axis;
@@ -662,7 +640,7 @@ namespace ShowerRecoTools {
     const detinfo::DetectorClocksData& clockData,
     const detinfo::DetectorPropertiesData& detProp,
     std::vector<art::Ptr<recob::SpacePoint>>& segment,
-    const art::FindManyP<recob::Hit>& fmh,
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmh,
     int& max_residual_point)
   {
 
@@ -690,7 +668,7 @@ namespace ShowerRecoTools {
     const detinfo::DetectorPropertiesData& detProp,
     std::vector<art::Ptr<recob::SpacePoint>>& segment,
     std::vector<art::Ptr<recob::SpacePoint>>& reduced_sps_pool,
-    const art::FindManyP<recob::Hit>& fmh,
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmh,
     double current_residual)
   {
 
@@ -827,7 +805,7 @@ namespace ShowerRecoTools {
   void
   ShowerIncrementalTrackHitFinder::RunTestOfIncrementalSpacePointFinder(
     const art::Event& Event,
-    const art::FindManyP<recob::Hit>& dud_fmh)
+    const reco::shower::ShowerAssociationView<recob::Hit>& dud_fmh)
   {
     TVector3 start_position(50, 50, 50);
     TVector3 start_direction(0, 0, 1);
@@ -66,11 +66,11 @@ namespace ShowerRecoTools {
     auto const pfpHandle = Event.getValidHandle<std::vector<recob::PFParticle>>(fPFParticleLabel);
 
     // Get the spacepoint - PFParticle assn
-    const art::FindManyP<recob::SpacePoint>& fmspp =
-      ShowerEleHolder.GetFindManyP<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::SpacePoint>& fmspp =
+      ShowerEleHolder.GetAssociationView<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
 
     // Get the SpacePoints
-    std::vector<art::Ptr<recob::SpacePoint>> spacePoints = fmspp.at(pfparticle.key());
+    std::vector<art::Ptr<recob::SpacePoint>> spacePoints = fmspp.at(pfparticle.key()).ToVector();
     if (spacePoints.empty()) {
       if (fVerbose)
         mf::LogError("ShowerLengthPercentile") << "No Spacepoints, returning" << std::endl;
@@ -27,8 +27,7 @@ namespace ShowerRecoTools {
                          reco::shower::ShowerElementHolder& ShowerElementHolder) override;
 
   private:
-    double CalculateEnergy(const detinfo::DetectorClocksData& clockData,
-                           const detinfo::DetectorPropertiesData& detProp,
+    double CalculateEnergy(const reco::shower::ShowerCalorimetryContext& caloContext,
                            const std::vector<art::Ptr<recob::Hit>>& hits,
                            const geo::PlaneID::PlaneID_t plane) const;
 
@@ -77,15 +76,13 @@ namespace ShowerRecoTools {
     //Get the clusters
     auto const clusHandle = Event.getValidHandle<std::vector<recob::Cluster>>(fPFParticleLabel);
 
-    const art::FindManyP<recob::Cluster>& fmc =
-      ShowerEleHolder.GetFindManyP<recob::Cluster>(pfpHandle, Event, fPFParticleLabel);
-    // art::FindManyP<recob::Cluster> fmc(pfpHandle, Event, fPFParticleLabel);
-    std::vector<art::Ptr<recob::Cluster>> clusters = fmc.at(pfparticle.key());
+    const reco::shower::ShowerAssociationView<recob::Cluster>& fmc =
+      ShowerEleHolder.GetAssociationView<recob::Cluster>(pfpHandle, Event, fPFParticleLabel);
+    const auto clusters = fmc.at(pfparticle.key());
 
     //Get the hit association
-    const art::FindManyP<recob::Hit>& fmhc =
-      ShowerEleHolder.GetFindManyP<recob::Hit>(clusHandle, Event, fPFParticleLabel);
-    // art::FindManyP<recob::Hit> fmhc(clusHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmhc =
+      ShowerEleHolder.GetAssociationView<recob::Hit>(clusHandle, Event, fPFParticleLabel);
 
     std::map<geo::PlaneID::PlaneID_t, std::vector<art::Ptr<recob::Hit>>> planeHits;
 
@@ -93,7 +90,7 @@ namespace ShowerRecoTools {
     for (auto const& cluster : clusters) {
 
       //Get the hits
-      std::vector<art::Ptr<recob::Hit>> hits = fmhc.at(cluster.key());
+      const auto hits = fmhc.at(cluster.key());
 
       //Get the plane.
       const geo::PlaneID::PlaneID_t plane(cluster->Plane().Plane);
@@ -109,17 +106,15 @@ namespace ShowerRecoTools {
     std::vector<double> energyVec(fNumPlanes, -999.);
     std::vector<double> energyError(fNumPlanes, -999.);
 
-    auto const clockData =
-      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(Event);
-    auto const detProp =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(Event, clockData);
+    const reco::shower::ShowerCalorimetryContext& caloContext =
+      ShowerEleHolder.GetCalorimetryContext(Event);
 
     for (auto const& [plane, hits] : planeHits) {
 
       unsigned int planeNumHits = hits.size();
 
       //Calculate the Energy for
-      double Energy = CalculateEnergy(clockData, detProp, hits, plane);
+      double Energy = CalculateEnergy(caloContext, hits, plane);
       // If the energy is negative, leave it at -999
       if (Energy > 0) energyVec.at(plane) = Energy;
 
@@ -144,18 +139,14 @@ namespace ShowerRecoTools {
   //Function to calculate the energy of a shower in a plane. Using a linear map between charge and Energy.
   //Exactly the same method as the ShowerEnergyAlg.cxx. Thanks Mike.
   double
-  ShowerLinearEnergy::CalculateEnergy(const detinfo::DetectorClocksData& clockData,
-                                      const detinfo::DetectorPropertiesData& detProp,
+  ShowerLinearEnergy::CalculateEnergy(const reco::shower::ShowerCalorimetryContext& caloContext,
                                       const std::vector<art::Ptr<recob::Hit>>& hits,
                                       const geo::PlaneID::PlaneID_t plane) const
   {
 
     double totalCharge = 0, totalEnergy = 0;
 
-    for (auto const& hit : hits) {
-      totalCharge += (hit->Integral() * std::exp((sampling_rate(clockData) * hit->PeakTime()) /
-                                                 (detProp.ElectronLifetime() * 1e3)));
-    }
+    totalCharge = caloContext.LifetimeCorrectedCharge(hits);
 
     totalEnergy = (totalCharge * fGradients.at(plane)) + fIntercepts.at(plane);
 
@@ -33,8 +33,7 @@ namespace ShowerRecoTools {
                          reco::shower::ShowerElementHolder& ShowerElementHolder) override;
 
   private:
-    double CalculateEnergy(const detinfo::DetectorClocksData& clockData,
-                           const detinfo::DetectorPropertiesData& detProp,
+    double CalculateEnergy(const reco::shower::ShowerCalorimetryContext& caloContext,
                            const std::vector<art::Ptr<recob::Hit>>& hits,
                            const geo::PlaneID::PlaneID_t plane) const;
 
@@ -47,6 +46,7 @@ namespace ShowerRecoTools {
     //Services
     art::ServiceHandle<geo::Geometry> fGeom;
     calo::CalorimetryAlg fCalorimetryAlg;
+    bool fExponentialLifetime; //The CalorimetryAlg uses the exponential lifetime form the context caches
 
     // Declare stuff
     double fRecombinationFactor;
@@ -59,6 +59,8 @@ namespace ShowerRecoTools {
     , fShowerEnergyOutputLabel(pset.get<std::string>("ShowerEnergyOutputLabel"))
     , fShowerBestPlaneOutputLabel(pset.get<std::string>("ShowerBestPlaneOutputLabel"))
     , fCalorimetryAlg(pset.get<fhicl::ParameterSet>("CalorimetryAlg"))
+    , fExponentialLifetime(
+        pset.get<fhicl::ParameterSet>("CalorimetryAlg").get<int>("CaloLifeTimeForm", 0) == 0)
     , fRecombinationFactor(pset.get<double>("RecombinationFactor"))
   {}
 
@@ -79,15 +81,13 @@ namespace ShowerRecoTools {
     //Get the clusters
     auto const clusHandle = Event.getValidHandle<std::vector<recob::Cluster>>(fPFParticleLabel);
 
-    const art::FindManyP<recob::Cluster>& fmc =
-      ShowerEleHolder.GetFindManyP<recob::Cluster>(pfpHandle, Event, fPFParticleLabel);
-    // art::FindManyP<recob::Cluster> fmc(pfpHandle, Event, fPFParticleLabel);
-    std::vector<art::Ptr<recob::Cluster>> clusters = fmc.at(pfparticle.key());
+    const reco::shower::ShowerAssociationView<recob::Cluster>& fmc =
+      ShowerEleHolder.GetAssociationView<recob::Cluster>(pfpHandle, Event, fPFParticleLabel);
+    const auto clusters = fmc.at(pfparticle.key());
 
     //Get the hit association
-    const art::FindManyP<recob::Hit>& fmhc =
-      ShowerEleHolder.GetFindManyP<recob::Hit>(clusHandle, Event, fPFParticleLabel);
-    // art::FindManyP<recob::Hit> fmhc(clusHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmhc =
+      ShowerEleHolder.GetAssociationView<recob::Hit>(clusHandle, Event, fPFParticleLabel);
 
     std::map<geo::PlaneID::PlaneID_t, std::vector<art::Ptr<recob::Hit>>> planeHits;
 
@@ -95,7 +95,7 @@ namespace ShowerRecoTools {
     for (auto const& cluster : clusters) {
 
       //Get the hits
-      std::vector<art::Ptr<recob::Hit>> hits = fmhc.at(cluster.key());
+      const auto hits = fmhc.at(cluster.key());
 
       //Get the plane.
       const geo::PlaneID::PlaneID_t plane(cluster->Plane().Plane);
@@ -111,17 +111,15 @@ namespace ShowerRecoTools {
     std::vector<double> energyVec(fGeom->Nplanes(), -999.);
     std::vector<double> energyError(fGeom->Nplanes(), -999.);
 
-    auto const clockData =
-      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(Event);
-    auto const detProp =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(Event, clockData);
+    const reco::shower::ShowerCalorimetryContext& caloContext =
+      ShowerEleHolder.GetCalorimetryContext(Event);
 
     for (auto const& [plane, hits] : planeHits) {
 
       unsigned int planeNumHits = hits.size();
 
       //Calculate the Energy for
-      double Energy = CalculateEnergy(clockData, detProp, hits, plane);
+      double Energy = CalculateEnergy(caloContext, hits, plane);
       // If the energy is negative, leave it at -999
       if (Energy > 0) energyVec.at(plane) = Energy;
 
@@ -145,10 +143,10 @@ namespace ShowerRecoTools {
 
   // function to calculate the reco energy
   double
-  ShowerNumElectronsEnergy::CalculateEnergy(const detinfo::DetectorClocksData& clockData,
-                                            const detinfo::DetectorPropertiesData& detProp,
-                                            const std::vector<art::Ptr<recob::Hit>>& hits,
-                                            const geo::PlaneID::PlaneID_t plane) const
+  ShowerNumElectronsEnergy::CalculateEnergy(
+    const reco::shower::ShowerCalorimetryContext& caloContext,
+    const std::vector<art::Ptr<recob::Hit>>& hits,
+    const geo::PlaneID::PlaneID_t plane) const
   {
 
     double totalCharge = 0;
@@ -156,11 +154,14 @@ namespace ShowerRecoTools {
     double correctedtotalCharge = 0;
     double nElectrons = 0;
 
-    for (auto const& hit : hits) {
-      totalCharge +=
-        hit->Integral() *
-        fCalorimetryAlg.LifetimeCorrection(
-          clockData, detProp, hit->PeakTime()); // obtain charge and correct for lifetime
+    // obtain charge and correct for lifetime, with the detector constants cached per event unless the
+    // CalorimetryAlg needs its other lifetime forms
+    if (fExponentialLifetime) { totalCharge = caloContext.TriggerTimeLifetimeCorrectedCharge(hits); }
+    else {
+      totalCharge = caloContext.CorrectedCharge(hits, [&](const double time) {
+        return fCalorimetryAlg.LifetimeCorrection(
+          caloContext.GetClockData(), caloContext.GetDetProp(), time);
+      });
     }
 
     // correct charge due to recombination
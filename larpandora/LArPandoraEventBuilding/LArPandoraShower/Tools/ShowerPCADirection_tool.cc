@@ -14,9 +14,6 @@
 #include "lardataobj/RecoBase/Shower.h"
 #include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Tools/IShowerTool.h"
 
-//C++ Includes
-#include <Eigen/Dense>
-
 namespace ShowerRecoTools {
 
   class ShowerPCADirection : public IShowerTool {
@@ -39,10 +36,8 @@ namespace ShowerRecoTools {
 
     // Define standard art tool interface
     recob::PCAxis CalculateShowerPCA(
-      const detinfo::DetectorClocksData& clockData,
-      const detinfo::DetectorPropertiesData& detProp,
       const std::vector<art::Ptr<recob::SpacePoint>>& spacePoints_pfp,
-      const art::FindManyP<recob::Hit>& fmh,
+      const reco::shower::ShowerSpacePointTable& spacePointTable,
       TVector3& ShowerCentre);
 
     TVector3 GetPCAxisVector(recob::PCAxis& PCAxis);
@@ -60,6 +55,14 @@ namespace ShowerRecoTools {
     std::string fShowerDirectionOutputLabel;
     std::string fShowerCentreOutputLabel;
     std::string fShowerPCAOutputLabel;
+
+    //Handles to the products
+    reco::shower::ShowerProducedPtrHandle<std::vector<recob::Shower>> fShowerHandle;
+    reco::shower::ShowerProducedPtrHandle<std::vector<recob::PCAxis>> fPCAHandle;
+    reco::shower::ShowerProducedPtrHandle<art::Assns<recob::Shower, recob::PCAxis>>
+      fShowerPCAAssnHandle;
+    reco::shower::ShowerProducedPtrHandle<art::Assns<recob::PFParticle, recob::PCAxis>>
+      fPFParticlePCAAssnHandle;
   };
 
   ShowerPCADirection::ShowerPCADirection(const fhicl::ParameterSet& pset)
@@ -78,9 +81,12 @@ namespace ShowerRecoTools {
   void
   ShowerPCADirection::InitialiseProducers()
   {
-    InitialiseProduct<std::vector<recob::PCAxis>>(fShowerPCAOutputLabel);
-    InitialiseProduct<art::Assns<recob::Shower, recob::PCAxis>>("ShowerPCAxisAssn");
-    InitialiseProduct<art::Assns<recob::PFParticle, recob::PCAxis>>("PFParticlePCAxisAssn");
+    fPCAHandle = InitialiseProduct<std::vector<recob::PCAxis>>(fShowerPCAOutputLabel);
+    fShowerPCAAssnHandle =
+      InitialiseProduct<art::Assns<recob::Shower, recob::PCAxis>>("ShowerPCAxisAssn");
+    fPFParticlePCAAssnHandle =
+      InitialiseProduct<art::Assns<recob::PFParticle, recob::PCAxis>>("PFParticlePCAxisAssn");
+    fShowerHandle = GetProductHandle<std::vector<recob::Shower>>("shower");
   }
 
   int
@@ -92,17 +98,12 @@ namespace ShowerRecoTools {
     // Get the assocated pfParicle vertex PFParticles
     auto const pfpHandle = Event.getValidHandle<std::vector<recob::PFParticle>>(fPFParticleLabel);
 
-    const art::FindManyP<recob::SpacePoint>& fmspp =
-      ShowerEleHolder.GetFindManyP<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
-
-    //Get the spacepoints handle and the hit assoication
-    auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
-
-    const art::FindManyP<recob::Hit>& fmh =
-      ShowerEleHolder.GetFindManyP<recob::Hit>(spHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::SpacePoint>& fmspp =
+      ShowerEleHolder.GetAssociationView<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
 
     //Spacepoints
-    std::vector<art::Ptr<recob::SpacePoint>> spacePoints_pfp = fmspp.at(pfparticle.key());
+    std::vector<art::Ptr<recob::SpacePoint>> spacePoints_pfp =
+      fmspp.at(pfparticle.key()).ToVector();
 
     //We cannot progress with no spacepoints.
     if (spacePoints_pfp.size() < 3) {
@@ -117,9 +118,15 @@ namespace ShowerRecoTools {
     auto const detProp =
       art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(Event, clockData);
 
+    //Get the spacepoints handle and the per event spacepoint charges and times
+    auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
+
+    const reco::shower::ShowerSpacePointTable& spacePointTable =
+      ShowerEleHolder.GetSpacePointTable(spHandle, Event, fPFParticleLabel, clockData, detProp);
+
     //Find the PCA vector
     TVector3 ShowerCentre;
-    recob::PCAxis PCA = CalculateShowerPCA(clockData, detProp, spacePoints_pfp, fmh, ShowerCentre);
+    recob::PCAxis PCA = CalculateShowerPCA(spacePoints_pfp, spacePointTable, ShowerCentre);
     TVector3 PCADirection = GetPCAxisVector(PCA);
 
     //Save the shower the center for downstream tools
@@ -179,26 +186,21 @@ namespace ShowerRecoTools {
 
   //Function to calculate the shower direction using a charge weight 3D PCA calculation.
   recob::PCAxis
-  ShowerPCADirection::CalculateShowerPCA(const detinfo::DetectorClocksData& clockData,
-                                         const detinfo::DetectorPropertiesData& detProp,
-                                         const std::vector<art::Ptr<recob::SpacePoint>>& sps,
-                                         const art::FindManyP<recob::Hit>& fmh,
-                                         TVector3& ShowerCentre)
+  ShowerPCADirection::CalculateShowerPCA(
+    const std::vector<art::Ptr<recob::SpacePoint>>& sps,
+    const reco::shower::ShowerSpacePointTable& spacePointTable,
+    TVector3& ShowerCentre)
   {
 
     float TotalCharge = 0;
-    float sumWeights = 0;
-    float xx = 0;
-    float yy = 0;
-    float zz = 0;
-    float xy = 0;
-    float xz = 0;
-    float yz = 0;
+
+    //Initialise the the PCA.
+    shower::LArPandoraShowerAlg::PCAAccumulator pcaAccumulator;
 
     //Get the Shower Centre
     if (fChargeWeighted) {
-      ShowerCentre = IShowerTool::GetLArPandoraShowerAlg().ShowerCentre(
-        clockData, detProp, sps, fmh, TotalCharge);
+      ShowerCentre =
+        IShowerTool::GetLArPandoraShowerAlg().ShowerCentre(spacePointTable, sps, TotalCharge);
     }
     else {
       ShowerCentre = IShowerTool::GetLArPandoraShowerAlg().ShowerCentre(sps);
@@ -207,7 +209,7 @@ namespace ShowerRecoTools {
     //Normalise the spacepoints, charge weight and add to the PCA.
     for (auto& sp : sps) {
 
-      TVector3 sp_position = IShowerTool::GetLArPandoraShowerAlg().SpacePointPosition(sp);
+      TVector3 sp_position = spacePointTable.GetPosition(sp.key());
 
       float wht = 1;
 
@@ -216,53 +218,31 @@ namespace ShowerRecoTools {
 
       if (fChargeWeighted) {
 
-        //Get the charge.
-        float Charge = IShowerTool::GetLArPandoraShowerAlg().SpacePointCharge(sp, fmh);
-
-        //Get the time of the spacepoint
-        float Time = IShowerTool::GetLArPandoraShowerAlg().SpacePointTime(sp, fmh);
-
-        //Correct for the lifetime at the moment.
-        Charge *= std::exp((sampling_rate(clockData) * Time) / (detProp.ElectronLifetime() * 1e3));
+        //Get the charge, corrected for the lifetime at the moment.
+        float Charge = spacePointTable.GetLifetimeCorrectedCharge(sp.key());
 
         //Charge Weight
         wht *= std::sqrt(Charge / TotalCharge);
       }
 
-      xx += sp_position.X() * sp_position.X() * wht;
-      yy += sp_position.Y() * sp_position.Y() * wht;
-      zz += sp_position.Z() * sp_position.Z() * wht;
-      xy += sp_position.X() * sp_position.Y() * wht;
-      xz += sp_position.X() * sp_position.Z() * wht;
-      yz += sp_position.Y() * sp_position.Z() * wht;
-      sumWeights += wht;
+      //Add to the PCA
+      pcaAccumulator.Add(sp_position, wht);
     }
 
-    // Using Eigen package
-    Eigen::Matrix3f matrix;
-
-    // Construct covariance matrix
-    matrix << xx, xy, xz, xy, yy, yz, xz, yz, zz;
-
-    // Normalise from the sum of weights
-    matrix /= sumWeights;
-
-    // Run the PCA
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> eigenMatrix(matrix);
-
-    Eigen::Vector3f eigenValuesVector = eigenMatrix.eigenvalues();
-    Eigen::Matrix3f eigenVectorsMatrix = eigenMatrix.eigenvectors();
+    // Run the PCA on the weighted second moments about the shower centre
+    const shower::LArPandoraShowerAlg::PCAResult pcaResult =
+      IShowerTool::GetLArPandoraShowerAlg().PrincipalComponents(pcaAccumulator, false);
 
     // Put in the required form for a recob::PCAxis
     const bool svdOk = true; //TODO: Should probably think about this a bit more
     const int nHits = sps.size();
-    // For some reason eigen sorts the eigenvalues from smallest to largest, reverse it
+    // The eigenvalues are sorted from largest to smallest
     const double eigenValues[3] = {
-      eigenValuesVector(2), eigenValuesVector(1), eigenValuesVector(0)};
-    std::vector<std::vector<double>> eigenVectors = {
-      {eigenVectorsMatrix(0, 2), eigenVectorsMatrix(1, 2), eigenVectorsMatrix(2, 2)},
-      {eigenVectorsMatrix(0, 1), eigenVectorsMatrix(1, 1), eigenVectorsMatrix(2, 1)},
-      {eigenVectorsMatrix(0, 0), eigenVectorsMatrix(1, 0), eigenVectorsMatrix(2, 0)}};
+      pcaResult.eigenValues[0], pcaResult.eigenValues[1], pcaResult.eigenValues[2]};
+    std::vector<std::vector<double>> eigenVectors;
+    for (TVector3 const& eigenVector : pcaResult.eigenVectors) {
+      eigenVectors.push_back({eigenVector.X(), eigenVector.Y(), eigenVector.Z()});
+    }
     const double avePos[3] = {ShowerCentre[0], ShowerCentre[1], ShowerCentre[2]};
 
     return recob::PCAxis(svdOk, nHits, eigenValues, eigenVectors, avePos);
@@ -290,15 +270,14 @@ namespace ShowerRecoTools {
       return 1;
     }
 
-    int ptrSize = GetVectorPtrSize(fShowerPCAOutputLabel);
+    int ptrSize = GetVectorPtrSize(fPCAHandle);
 
     const art::Ptr<recob::PCAxis> pcaPtr =
-      GetProducedElementPtr<recob::PCAxis>(fShowerPCAOutputLabel, ShowerEleHolder, ptrSize - 1);
-    const art::Ptr<recob::Shower> showerPtr =
-      GetProducedElementPtr<recob::Shower>("shower", ShowerEleHolder);
+      GetProducedElementPtr(fPCAHandle, ShowerEleHolder, ptrSize - 1);
+    const art::Ptr<recob::Shower> showerPtr = GetProducedElementPtr(fShowerHandle, ShowerEleHolder);
 
-    AddSingle<art::Assns<recob::Shower, recob::PCAxis>>(showerPtr, pcaPtr, "ShowerPCAxisAssn");
-    AddSingle<art::Assns<recob::PFParticle, recob::PCAxis>>(pfpPtr, pcaPtr, "PFParticlePCAxisAssn");
+    AddSingle(fShowerPCAAssnHandle, showerPtr, pcaPtr);
+    AddSingle(fPFParticlePCAAssnHandle, pfpPtr, pcaPtr);
 
     return 0;
   }
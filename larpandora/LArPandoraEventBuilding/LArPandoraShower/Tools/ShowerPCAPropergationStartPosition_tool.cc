@@ -77,24 +77,25 @@ namespace ShowerRecoTools {
       // Get the assocated pfParicle vertex PFParticles
       auto const pfpHandle = Event.getValidHandle<std::vector<recob::PFParticle>>(fPFParticleLabel);
 
-      const art::FindManyP<recob::SpacePoint>& fmspp =
-        ShowerEleHolder.GetFindManyP<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
+      const reco::shower::ShowerAssociationView<recob::SpacePoint>& fmspp =
+        ShowerEleHolder.GetAssociationView<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
 
-      //Get the spacepoints handle and the hit assoication
+      //Get the spacepoints handle and the per event spacepoint charges
       auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
 
-      const art::FindManyP<recob::Hit>& fmh =
-        ShowerEleHolder.GetFindManyP<recob::Hit>(spHandle, Event, fPFParticleLabel);
+      const reco::shower::ShowerSpacePointTable& spacePointTable =
+        ShowerEleHolder.GetSpacePointTable(spHandle, Event, fPFParticleLabel, clockData, detProp);
 
       //Spacepoints
-      std::vector<art::Ptr<recob::SpacePoint>> spacePoints_pfp = fmspp.at(pfparticle.key());
+      std::vector<art::Ptr<recob::SpacePoint>> spacePoints_pfp =
+        fmspp.at(pfparticle.key()).ToVector();
 
       //We cannot progress with no spacepoints.
       if (spacePoints_pfp.empty()) return 1;
 
       //Get the shower center
-      ShowerCentre = IShowerTool::GetLArPandoraShowerAlg().ShowerCentre(
-        clockData, detProp, spacePoints_pfp, fmh);
+      ShowerCentre =
+        IShowerTool::GetLArPandoraShowerAlg().ShowerCentre(spacePointTable, spacePoints_pfp);
     }
     else {
       ShowerEleHolder.GetElement(fShowerCentreInputLabel, ShowerCentre);
@@ -93,16 +93,12 @@ namespace ShowerRecoTools {
       TVector3 ShowerDirection = {-999, -999, -999};
       ShowerEleHolder.GetElement(fShowerDirectionInputLabel, ShowerDirection);
 
-      const art::FindManyP<recob::SpacePoint>& fmspp =
-        ShowerEleHolder.GetFindManyP<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
-
-      //Get the spacepoints handle and the hit assoication
-      auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
-      const art::FindManyP<recob::Hit>& fmh =
-        ShowerEleHolder.GetFindManyP<recob::Hit>(spHandle, Event, fPFParticleLabel);
+      const reco::shower::ShowerAssociationView<recob::SpacePoint>& fmspp =
+        ShowerEleHolder.GetAssociationView<recob::SpacePoint>(pfpHandle, Event, fPFParticleLabel);
 
       //Get the spacepoints
-      std::vector<art::Ptr<recob::SpacePoint>> spacePoints_pfp = fmspp.at(pfparticle.key());
+      std::vector<art::Ptr<recob::SpacePoint>> spacePoints_pfp =
+        fmspp.at(pfparticle.key()).ToVector();
 
       //Cannot continue if we have no spacepoints
       if (spacePoints_pfp.empty()) { return 0; }
@@ -113,8 +109,13 @@ namespace ShowerRecoTools {
       auto const detProp =
         art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(Event, clockData);
 
-      TVector3 ShowerCentre = IShowerTool::GetLArPandoraShowerAlg().ShowerCentre(
-        clockData, detProp, spacePoints_pfp, fmh);
+      //Get the spacepoints handle and the per event spacepoint charges
+      auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
+      const reco::shower::ShowerSpacePointTable& spacePointTable =
+        ShowerEleHolder.GetSpacePointTable(spHandle, Event, fPFParticleLabel, clockData, detProp);
+
+      TVector3 ShowerCentre =
+        IShowerTool::GetLArPandoraShowerAlg().ShowerCentre(spacePointTable, spacePoints_pfp);
 
       //Order the Hits from the shower centre. The most negative will be the start position.
       IShowerTool::GetLArPandoraShowerAlg().OrderShowerSpacePoints(
@@ -49,6 +49,14 @@ namespace ShowerRecoTools {
     std::string fShowerDirectionInputLabel;
     std::string fInitialTrackSpacePointsInputLabel;
     std::string fInitialTrackHitsInputLabel;
+
+    //Handles to the products
+    reco::shower::ShowerProducedPtrHandle<std::vector<recob::Shower>> fShowerHandle;
+    reco::shower::ShowerProducedPtrHandle<std::vector<recob::Track>> fTrackHandle;
+    reco::shower::ShowerProducedPtrHandle<art::Assns<recob::Shower, recob::Track>>
+      fShowerTrackAssnHandle;
+    reco::shower::ShowerProducedPtrHandle<art::Assns<recob::Track, recob::Hit>>
+      fTrackHitAssnHandle;
   };
 
   ShowerPandoraSlidingFitTrackFinder::ShowerPandoraSlidingFitTrackFinder(
@@ -69,9 +77,12 @@ namespace ShowerRecoTools {
   ShowerPandoraSlidingFitTrackFinder::InitialiseProducers()
   {
 
-    InitialiseProduct<std::vector<recob::Track>>(fInitialTrackOutputLabel);
-    InitialiseProduct<art::Assns<recob::Shower, recob::Track>>("ShowerTrackAssn");
-    InitialiseProduct<art::Assns<recob::Track, recob::Hit>>("ShowerTrackHitAssn");
+    fTrackHandle = InitialiseProduct<std::vector<recob::Track>>(fInitialTrackOutputLabel);
+    fShowerTrackAssnHandle =
+      InitialiseProduct<art::Assns<recob::Shower, recob::Track>>("ShowerTrackAssn");
+    fTrackHitAssnHandle =
+      InitialiseProduct<art::Assns<recob::Track, recob::Hit>>("ShowerTrackHitAssn");
+    fShowerHandle = GetProductHandle<std::vector<recob::Shower>>("shower");
   }
 
   //This whole idea is stolen from PandoraTrackCreationModule so credit goes to the Pandora guys.
@@ -221,20 +232,19 @@ namespace ShowerRecoTools {
     }
 
     //Get the size of the ptr as it is.
-    int trackptrsize = GetVectorPtrSize(fInitialTrackOutputLabel);
+    int trackptrsize = GetVectorPtrSize(fTrackHandle);
 
-    const art::Ptr<recob::Track> trackptr = GetProducedElementPtr<recob::Track>(
-      fInitialTrackOutputLabel, ShowerEleHolder, trackptrsize - 1);
-    const art::Ptr<recob::Shower> showerptr =
-      GetProducedElementPtr<recob::Shower>("shower", ShowerEleHolder);
+    const art::Ptr<recob::Track> trackptr =
+      GetProducedElementPtr(fTrackHandle, ShowerEleHolder, trackptrsize - 1);
+    const art::Ptr<recob::Shower> showerptr = GetProducedElementPtr(fShowerHandle, ShowerEleHolder);
 
-    AddSingle<art::Assns<recob::Shower, recob::Track>>(showerptr, trackptr, "ShowerTrackAssn");
+    AddSingle(fShowerTrackAssnHandle, showerptr, trackptr);
 
     std::vector<art::Ptr<recob::Hit>> TrackHits;
     ShowerEleHolder.GetElement(fInitialTrackHitsInputLabel, TrackHits);
 
     for (auto const& TrackHit : TrackHits) {
-      AddSingle<art::Assns<recob::Track, recob::Hit>>(trackptr, TrackHit, "ShowerTrackHitAssn");
+      AddSingle(fTrackHitAssnHandle, trackptr, TrackHit);
     }
 
     return 0;
@@ -93,8 +93,8 @@ namespace ShowerRecoTools {
     auto const hitHandle = Event.getValidHandle<std::vector<recob::Hit>>(fHitModuleLabel);
 
     //Get the spacepoint handle. We need to do this in 3D.
-    const art::FindManyP<recob::SpacePoint>& fmsp =
-      ShowerEleHolder.GetFindManyP<recob::SpacePoint>(hitHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::SpacePoint>& fmsp =
+      ShowerEleHolder.GetAssociationView<recob::SpacePoint>(hitHandle, Event, fPFParticleLabel);
 
     //Get the initial track hits.
     std::vector<art::Ptr<recob::Hit>> InitialTrackHits;
@@ -108,7 +108,7 @@ namespace ShowerRecoTools {
     //Get the spacepoints associated to the track hit
     std::vector<art::Ptr<recob::SpacePoint>> intitaltrack_sp;
     for (auto const hit : InitialTrackHits) {
-      std::vector<art::Ptr<recob::SpacePoint>> sps = fmsp.at(hit.key());
+      const auto sps = fmsp.at(hit.key());
       for (auto const sp : sps) {
         intitaltrack_sp.push_back(sp);
 
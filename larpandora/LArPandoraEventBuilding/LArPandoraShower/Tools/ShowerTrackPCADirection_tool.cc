@@ -12,9 +12,6 @@
 //LArSoft Includes
 #include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Tools/IShowerTool.h"
 
-//Root Includes
-#include "TPrincipal.h"
-
 namespace ShowerRecoTools {
 
   class ShowerTrackPCADirection : IShowerTool {
@@ -28,10 +25,8 @@ namespace ShowerRecoTools {
                          reco::shower::ShowerElementHolder& ShowerEleHolder) override;
 
   private:
-    TVector3 ShowerPCAVector(const detinfo::DetectorClocksData& clockData,
-                             const detinfo::DetectorPropertiesData& detProp,
-                             std::vector<art::Ptr<recob::SpacePoint>>& spacePoints_pfp,
-                             const art::FindManyP<recob::Hit>& fmh,
+    TVector3 ShowerPCAVector(std::vector<art::Ptr<recob::SpacePoint>>& spacePoints_pfp,
+                             const reco::shower::ShowerSpacePointTable& spacePointTable,
                              TVector3& ShowerCentre);
 
     //fcl
@@ -76,12 +71,6 @@ namespace ShowerRecoTools {
       return 1;
     }
 
-    //Get the spacepoints handle and the hit assoication
-    auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
-
-    const art::FindManyP<recob::Hit>& fmh =
-      ShowerEleHolder.GetFindManyP<recob::Hit>(spHandle, Event, fPFParticleLabel);
-
     std::vector<art::Ptr<recob::SpacePoint>> trackSpacePoints;
     ShowerEleHolder.GetElement(fInitialTrackSpacePointsInputLabel, trackSpacePoints);
 
@@ -97,9 +86,15 @@ namespace ShowerRecoTools {
     auto const detProp =
       art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(Event, clockData);
 
+    //Get the spacepoints handle and the per event spacepoint charges and times
+    auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
+
+    const reco::shower::ShowerSpacePointTable& spacePointTable =
+      ShowerEleHolder.GetSpacePointTable(spHandle, Event, fPFParticleLabel, clockData, detProp);
+
     //Find the PCA vector
     TVector3 trackCentre;
-    TVector3 Eigenvector = ShowerPCAVector(clockData, detProp, trackSpacePoints, fmh, trackCentre);
+    TVector3 Eigenvector = ShowerPCAVector(trackSpacePoints, spacePointTable, trackCentre);
 
     //Get the General direction as the vector between the start position and the centre
     TVector3 StartPositionVec = {-999, -999, -999};
@@ -125,26 +120,25 @@ namespace ShowerRecoTools {
 
   //Function to calculate the shower direction using a charge weight 3D PCA calculation.
   TVector3
-  ShowerTrackPCADirection::ShowerPCAVector(const detinfo::DetectorClocksData& clockData,
-                                           const detinfo::DetectorPropertiesData& detProp,
-                                           std::vector<art::Ptr<recob::SpacePoint>>& sps,
-                                           const art::FindManyP<recob::Hit>& fmh,
-                                           TVector3& ShowerCentre)
+  ShowerTrackPCADirection::ShowerPCAVector(
+    std::vector<art::Ptr<recob::SpacePoint>>& sps,
+    const reco::shower::ShowerSpacePointTable& spacePointTable,
+    TVector3& ShowerCentre)
   {
 
     //Initialise the the PCA.
-    TPrincipal* pca = new TPrincipal(3, "");
+    shower::LArPandoraShowerAlg::PCAAccumulator pcaAccumulator;
 
     float TotalCharge = 0;
 
     //Get the Shower Centre
     ShowerCentre =
-      IShowerTool::GetLArPandoraShowerAlg().ShowerCentre(clockData, detProp, sps, fmh, TotalCharge);
+      IShowerTool::GetLArPandoraShowerAlg().ShowerCentre(spacePointTable, sps, TotalCharge);
 
     //Normalise the spacepoints, charge weight and add to the PCA.
     for (auto& sp : sps) {
 
-      TVector3 sp_position = IShowerTool::GetLArPandoraShowerAlg().SpacePointPosition(sp);
+      TVector3 sp_position = spacePointTable.GetPosition(sp.key());
 
       float wht = 1;
 
@@ -153,39 +147,21 @@ namespace ShowerRecoTools {
 
       if (fChargeWeighted) {
 
-        //Get the charge.
-        float Charge = IShowerTool::GetLArPandoraShowerAlg().SpacePointCharge(sp, fmh);
-
-        //Get the time of the spacepoint
-        float Time = IShowerTool::GetLArPandoraShowerAlg().SpacePointTime(sp, fmh);
-
-        //Correct for the lifetime at the moment.
-        Charge *= std::exp((sampling_rate(clockData) * Time) / (detProp.ElectronLifetime() * 1e3));
+        //Get the charge, corrected for the lifetime at the moment.
+        float Charge = spacePointTable.GetLifetimeCorrectedCharge(sp.key());
 
         //Charge Weight
         wht *= std::sqrt(Charge / TotalCharge);
       }
 
-      double sp_coord[3];
-      sp_coord[0] = sp_position.X() * wht;
-      sp_coord[1] = sp_position.Y() * wht;
-      sp_coord[2] = sp_position.Z() * wht;
-
       //Add to the PCA
-      pca->AddRow(sp_coord);
+      pcaAccumulator.Add(sp_position.X() * wht, sp_position.Y() * wht, sp_position.Z() * wht);
     }
 
-    //Evaluate the PCA
-    pca->MakePrincipals();
-
-    //Get the Eigenvectors.
-    const TMatrixD* Eigenvectors = pca->GetEigenVectors();
-
-    TVector3 Eigenvector = {(*Eigenvectors)[0][0], (*Eigenvectors)[1][0], (*Eigenvectors)[2][0]};
-
-    delete pca;
-
-    return Eigenvector;
+    //Evaluate the PCA and get the primary eigenvector.
+    return IShowerTool::GetLArPandoraShowerAlg()
+      .PrincipalComponents(pcaAccumulator)
+      .eigenVectors[0];
   }
 }
 
@@ -136,15 +136,19 @@ namespace ShowerRecoTools {
     auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
 
     // Get the hits associated with the space points
-    const art::FindOneP<recob::Hit>& fohsp =
-      ShowerEleHolder.GetFindOneP<recob::Hit>(spHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmhsp =
+      ShowerEleHolder.GetAssociationView<recob::Hit>(spHandle, Event, fPFParticleLabel);
 
     //Save the corresponding hits
     std::vector<art::Ptr<recob::Hit>> trackHits;
     for (auto const& spacePoint : new_intitaltrack_sp) {
-      //Get the hits
-      const art::Ptr<recob::Hit> hit = fohsp.at(spacePoint.key());
-      trackHits.push_back(hit);
+      //Get the hit, there is at most one per spacepoint as art::FindOneP required
+      const auto hits = fmhsp.at(spacePoint.key());
+      if (hits.size() > 1) {
+        throw cet::exception("ShowerTrackTrajToSpacePoint")
+          << "More than one hit associated to spacepoint " << spacePoint.key();
+      }
+      trackHits.push_back(hits.empty() ? art::Ptr<recob::Hit>() : hits.front());
     }
 
     //Save the spacepoints.
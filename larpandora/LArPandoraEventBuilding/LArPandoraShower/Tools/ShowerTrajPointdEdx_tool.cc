@@ -15,6 +15,7 @@
 //LArSoft Includes
 #include "lardataobj/AnalysisBase/T0.h"
 #include "lardataobj/RecoBase/Track.h"
+#include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerTrajPointIndex.hh"
 #include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Tools/IShowerTool.h"
 #include "larreco/Calorimetry/CalorimetryAlg.h"
 
@@ -33,9 +34,16 @@ namespace ShowerRecoTools {
     void FinddEdxLength(std::vector<double>& dEdx_vec, std::vector<double>& dEdx_val);
 
   private:
+    //Index the trajectory points of the initial track by their projection along the track.
+    void IndexTrajectoryPoints(const recob::Track& InitialTrack);
+
     //Servcies and Algorithms
     art::ServiceHandle<geo::Geometry> fGeom;
     calo::CalorimetryAlg fCalorimetryAlg;
+    const unsigned int fNumPlanes;
+
+    //Trajectory points of the current initial track, indexed by their projection along it.
+    reco::shower::ShowerTrajPointIndex fTrajPointIndex;
 
     //fcl parameters
     float fMinAngleToWire; //Minimum angle between the wire direction and the shower
@@ -75,6 +83,7 @@ namespace ShowerRecoTools {
   ShowerTrajPointdEdx::ShowerTrajPointdEdx(const fhicl::ParameterSet& pset)
     : IShowerTool(pset.get<fhicl::ParameterSet>("BaseTools"))
     , fCalorimetryAlg(pset.get<fhicl::ParameterSet>("CalorimetryAlg"))
+    , fNumPlanes(fGeom->MaxPlanes())
     , fMinAngleToWire(pset.get<float>("MinAngleToWire"))
     , fShapingTime(pset.get<float>("ShapingTime"))
     , fMinDistCutOff(pset.get<float>("MinDistCutOff"))
@@ -142,8 +151,8 @@ namespace ShowerRecoTools {
     auto const spHandle = Event.getValidHandle<std::vector<recob::SpacePoint>>(fPFParticleLabel);
 
     // Get the hits associated with the space points
-    const art::FindManyP<recob::Hit>& fmsp =
-      ShowerEleHolder.GetFindManyP<recob::Hit>(spHandle, Event, fPFParticleLabel);
+    const reco::shower::ShowerAssociationView<recob::Hit>& fmsp =
+      ShowerEleHolder.GetAssociationView<recob::Hit>(spHandle, Event, fPFParticleLabel);
 
     //Only consider hits in the same tpcs as the vertex.
     TVector3 ShowerStartPosition = {-999, -999, -999};
@@ -163,27 +172,41 @@ namespace ShowerRecoTools {
       if (pfpT0Vec.size() == 1) { pfpT0Time = pfpT0Vec.front()->Time(); }
     }
 
-    //Don't care that I could use a vector.
-    std::map<int, std::vector<double>> dEdx_vec;
-    std::map<int, std::vector<double>> dEdx_vecErr;
-    std::map<int, int> num_hits;
-
-    for (geo::PlaneID plane_id : fGeom->IteratePlaneIDs()) {
-      dEdx_vec[plane_id.Plane] = {};
-      dEdx_vecErr[plane_id.Plane] = {};
-      num_hits[plane_id.Plane] = 0;
+    //Plane numbers run over every plane of every TPC so index the planes directly.
+    std::vector<std::vector<double>> dEdx_vec(fNumPlanes);
+    std::vector<int> num_hits(fNumPlanes, 0);
+
+    //Only the planes of the vertex TPC are used, so get their pitch and wire direction once.
+    std::vector<double> planePitch(fNumPlanes, 0);
+    std::vector<TVector3> planeDirection(fNumPlanes);
+    if (vtxTPC.isValid) {
+      for (unsigned int plane = 0; plane < fNumPlanes; ++plane) {
+        const geo::PlaneID planeid(vtxTPC, plane);
+        if (!fGeom->HasPlane(planeid)) { continue; }
+        planePitch[plane] = fGeom->WirePitch(planeid);
+        planeDirection[plane] = fGeom->Plane(planeid).GetIncreasingWireDirection();
+      }
     }
 
-    auto const clockData =
-      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(Event);
-    auto const detProp =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(Event, clockData);
+    const reco::shower::ShowerCalorimetryContext& caloContext =
+      ShowerEleHolder.GetCalorimetryContext(Event);
+    auto const& clockData = caloContext.GetClockData();
+    auto const& detProp = caloContext.GetDetProp();
+
+    const double velocity = caloContext.GetDriftVelocity();
+
+    //Index the trajectory points once for all the spacepoints
+    IndexTrajectoryPoints(InitialTrack);
+
+    geo::Point_t TrajPositionStartPoint = InitialTrack.LocationAtPoint(0);
+    TVector3 TrajPositionStart = {
+      TrajPositionStartPoint.X(), TrajPositionStartPoint.Y(), TrajPositionStartPoint.Z()};
 
     //Loop over the spacepoints
     for (auto const sp : tracksps) {
 
       //Get the associated hit
-      std::vector<art::Ptr<recob::Hit>> hits = fmsp.at(sp.key());
+      const auto hits = fmsp.at(sp.key());
       if (hits.empty()) {
         if (fVerbose)
           mf::LogWarning("ShowerTrajPointdEdx")
@@ -191,13 +214,15 @@ namespace ShowerRecoTools {
         continue;
       }
       const art::Ptr<recob::Hit> hit = hits[0];
-      double wirepitch = fGeom->WirePitch((geo::PlaneID)hit->WireID());
 
       //Only consider hits in the same tpc
       geo::PlaneID planeid = hit->WireID();
       geo::TPCID TPC = planeid.asTPCID();
       if (TPC != vtxTPC) { continue; }
 
+      const double wirepitch = planePitch[planeid.Plane];
+      const TVector3& PlaneDirection = planeDirection[planeid.Plane];
+
       //Ignore spacepoints within a few wires of the vertex.
       const TVector3 pos = IShowerTool::GetLArPandoraShowerAlg().SpacePointPosition(sp);
       double dist_from_start = (pos - ShowerStartPosition).Mag();
@@ -209,35 +234,12 @@ namespace ShowerRecoTools {
       }
 
       //Find the closest trajectory point of the track. These should be in order if the user has used ShowerTrackTrajToSpacePoint_tool but the sake of gernicness I'll get the cloest sp.
-      unsigned int index = 999;
-      double MinDist = 999;
-      for (unsigned int traj = 0; traj < InitialTrack.NumberTrajectoryPoints(); ++traj) {
-
-        geo::Point_t TrajPositionPoint = InitialTrack.LocationAtPoint(traj);
-        TVector3 TrajPosition = {
-          TrajPositionPoint.X(), TrajPositionPoint.Y(), TrajPositionPoint.Z()};
-
-        //ignore bogus info.
-        auto flags = InitialTrack.FlagsAtPoint(traj);
-        if (flags.isSet(recob::TrajectoryPointFlagTraits::NoPoint)) { continue; }
-
-        const TVector3 dist = pos - TrajPosition;
-
-        if (dist.Mag() < MinDist && dist.Mag() < MaxDist * wirepitch) {
-          MinDist = dist.Mag();
-          index = traj;
-        }
-      }
+      unsigned int index = fTrajPointIndex.FindClosest(pos, MaxDist * wirepitch);
 
       //If there is no matching trajectory point then bail.
-      if (index == 999) { continue; }
-
-      geo::Point_t TrajPositionPoint = InitialTrack.LocationAtPoint(index);
-      TVector3 TrajPosition = {TrajPositionPoint.X(), TrajPositionPoint.Y(), TrajPositionPoint.Z()};
+      if (index == reco::shower::ShowerTrajPointIndex::kNoPoint) { continue; }
 
-      geo::Point_t TrajPositionStartPoint = InitialTrack.LocationAtPoint(0);
-      TVector3 TrajPositionStart = {
-        TrajPositionStartPoint.X(), TrajPositionStartPoint.Y(), TrajPositionStartPoint.Z()};
+      const TVector3& TrajPosition = fTrajPointIndex.GetPosition(index);
 
       //Ignore values with 0 mag from the start position
       if ((TrajPosition - TrajPositionStart).Mag() == 0) { continue; }
@@ -254,7 +256,6 @@ namespace ShowerRecoTools {
       // Note that we project in the YZ plane to make sure we are not cutting on
       // the angle into the wire planes, that should be done by the shaping time cut
       TVector3 TrajDirectionYZ = {0, TrajDirection_vec.Y(), TrajDirection_vec.Z()};
-      TVector3 PlaneDirection = fGeom->Plane(planeid).GetIncreasingWireDirection();
 
       if (std::abs((TMath::Pi() / 2 - TrajDirectionYZ.Angle(PlaneDirection))) < fMinAngleToWire) {
         if (fVerbose) mf::LogWarning("ShowerTrajPointdEdx") << "remove from angle cut" << std::endl;
@@ -262,7 +263,6 @@ namespace ShowerRecoTools {
       }
 
       //If the direction is too much into the wire plane then the shaping amplifer cuts the charge. Lets remove these events.
-      double velocity = detProp.DriftVelocity(detProp.Efield(), detProp.Temperature());
       double distance_in_x = TrajDirection.X() * (wirepitch / TrajDirection.Dot(PlaneDirection));
       double time_taken = std::abs(distance_in_x / velocity);
 
@@ -303,7 +303,8 @@ namespace ShowerRecoTools {
     //Choose max hits based on hitnum
     int max_hits = 0;
     int best_plane = -std::numeric_limits<int>::max();
-    for (auto const& [plane, numHits] : num_hits) {
+    for (unsigned int plane = 0; plane < fNumPlanes; ++plane) {
+      const int numHits = num_hits[plane];
       if (fVerbose > 2) std::cout << "Plane: " << plane << " with size: " << numHits << std::endl;
       if (numHits > max_hits) {
         best_plane = plane;
@@ -323,12 +324,8 @@ namespace ShowerRecoTools {
     //If there is very large dEdx we have either calculated it wrong (probably) or the Electron is coming to end.
     //Assumes hits are ordered!
     std::map<int, std::vector<double>> dEdx_vec_cut;
-    for (geo::PlaneID plane_id : fGeom->IteratePlaneIDs()) {
-      dEdx_vec_cut[plane_id.Plane] = {};
-    }
-
-    for (auto& dEdx_plane : dEdx_vec) {
-      FinddEdxLength(dEdx_plane.second, dEdx_vec_cut[dEdx_plane.first]);
+    for (unsigned int plane = 0; plane < fNumPlanes; ++plane) {
+      FinddEdxLength(dEdx_vec[plane], dEdx_vec_cut[plane]);
     }
 
     //Never have the stats to do a landau fit and get the most probable value. User decides if they want the median value or the mean.
@@ -472,6 +469,25 @@ namespace ShowerRecoTools {
     return;
   }
 
+  void
+  ShowerTrajPointdEdx::IndexTrajectoryPoints(const recob::Track& InitialTrack)
+  {
+
+    const unsigned int numTrajPoints = InitialTrack.NumberTrajectoryPoints();
+
+    std::vector<TVector3> positions(numTrajPoints);
+    std::vector<bool> isValid(numTrajPoints);
+    for (unsigned int traj = 0; traj < numTrajPoints; ++traj) {
+      geo::Point_t TrajPositionPoint = InitialTrack.LocationAtPoint(traj);
+      positions[traj] = {TrajPositionPoint.X(), TrajPositionPoint.Y(), TrajPositionPoint.Z()};
+
+      //ignore bogus info.
+      isValid[traj] = !InitialTrack.FlagsAtPoint(traj).isSet(recob::TrajectoryPointFlagTraits::NoPoint);
+    }
+
+    fTrajPointIndex.Fill(positions, isValid);
+  }
+
 }
 
 DEFINE_ART_CLASS_TOOL(ShowerRecoTools::ShowerTrajPointdEdx)
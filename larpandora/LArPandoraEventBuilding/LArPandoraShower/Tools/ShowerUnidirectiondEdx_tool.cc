@@ -123,10 +123,10 @@ namespace ShowerRecoTools {
     int bestPlane = -999;
     double minPitch = 999;
 
-    auto const clockData =
-      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(Event);
-    auto const detProp =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(Event, clockData);
+    const reco::shower::ShowerCalorimetryContext& caloContext =
+      ShowerEleHolder.GetCalorimetryContext(Event);
+    auto const& clockData = caloContext.GetClockData();
+    auto const& detProp = caloContext.GetDetProp();
 
     for (unsigned int plane = 0; plane < numPlanes; ++plane) {
       std::vector<art::Ptr<recob::Hit>> trackPlaneHits = trackHits.at(plane);
@@ -111,6 +111,14 @@ namespace lar_pandora {
                                       const geo::Vector_t& deltas,
                                       const float maxDisplacement) const = 0;
 
+    /**
+             *  @brief  Whether CheckDetectorGapSize can only pass for TPCs whose gap along X is within the gap size
+             *          threshold, so that the search for detector gaps need only test TPCs that are close in X
+             *
+             *  @result logic bool
+             */
+    virtual bool AreDetectorGapsLocalInX() const;
+
     /**
              *  @brief  Create a detector gap
              *
@@ -169,6 +177,14 @@ namespace lar_pandora {
       const pandora::Pandora* pPandora) const = 0;
   };
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline bool
+  LArPandoraDetectorType::AreDetectorGapsLocalInX() const
+  {
+    return false;
+  }
+
   namespace detector_functions {
 
     /**
@@ -36,6 +36,8 @@ namespace lar_pandora {
                               const geo::Vector_t& deltas,
                               const float maxDisplacement) const override;
 
+    bool AreDetectorGapsLocalInX() const override;
+
     LArDetectorGap CreateDetectorGap(const geo::Point_t& point1,
                                      const geo::Point_t& point2,
                                      const geo::Vector_t& widths) const override;
@@ -115,6 +117,15 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  inline bool
+  ProtoDUNEDualPhase::AreDetectorGapsLocalInX() const
+  {
+    // ATTN Gaps are made for TPCs far apart in Y or Z, whatever their separation in X
+    return false;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   inline LArDetectorGap
   ProtoDUNEDualPhase::CreateDetectorGap(const geo::Point_t& point1,
                                         const geo::Point_t& point2,
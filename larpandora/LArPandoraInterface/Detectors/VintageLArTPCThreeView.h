@@ -54,6 +54,8 @@ namespace lar_pandora {
                                       const geo::Vector_t& deltas,
                                       const float maxDisplacement) const override;
 
+    virtual bool AreDetectorGapsLocalInX() const override;
+
     virtual LArDetectorGap CreateDetectorGap(const geo::Point_t& point1,
                                              const geo::Point_t& point2,
                                              const geo::Vector_t& widths) const override;
@@ -185,6 +187,15 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  inline bool
+  VintageLArTPCThreeView::AreDetectorGapsLocalInX() const
+  {
+    // Gaps are only made for TPCs separated by at most the maximum gap size in X
+    return true;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   inline LArDetectorGap
   VintageLArTPCThreeView::CreateDetectorGap(const geo::Point_t& point1,
                                             const geo::Point_t& point2,
@@ -0,0 +1,40 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/HitFilterBaseTool.h
+ *
+ *  @brief  header for the lar pandora input hit filter base tool
+ */
+
+#ifndef LAR_PANDORA_HIT_FILTER_BASE_TOOL_H
+#define LAR_PANDORA_HIT_FILTER_BASE_TOOL_H 1
+
+#include "art/Framework/Principal/Event.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  Abstract base class for a tool that removes hits before they are passed to Pandora
+   */
+  class HitFilterBaseTool {
+  public:
+    virtual ~HitFilterBaseTool() noexcept = default;
+
+    /**
+     *  @brief  The tools interface function. Here the derived tool will split the input hits into
+     *          those to pass to Pandora and those to remove
+     *
+     *  @param  evt the art event
+     *  @param  inputHits the input vector of hits
+     *  @param  selectedHits the output vector of hits to pass to Pandora, in their input order
+     *  @param  rejectedHits the output vector of hits removed by the filter, in their input order
+     */
+    virtual void FilterHits(const art::Event& evt,
+                            const HitVector& inputHits,
+                            HitVector& selectedHits,
+                            HitVector& rejectedHits) = 0;
+  };
+
+} // namespace lar_pandora
+
+#endif // #ifndef LAR_PANDORA_HIT_FILTER_BASE_TOOL_H
@@ -0,0 +1,91 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/HitFilterTools/HitWindowFilter_tool.cc
+ *
+ *  @brief  implementation of the lar pandora hit window filter tool
+ */
+
+#include "art/Utilities/ToolMacros.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include "lardataobj/RecoBase/Hit.h"
+
+#include "larpandora/LArPandoraInterface/HitFilterBaseTool.h"
+
+#include <limits>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  Hit filter tool that removes hits outside a charge window or a peak time window
+   */
+  class HitWindowFilter : public HitFilterBaseTool {
+  public:
+    /**
+     *  @brief  Default constructor
+     *
+     *  @param  pset FHiCL parameter set
+     */
+    HitWindowFilter(fhicl::ParameterSet const& pset);
+
+    /**
+     *  @brief  Remove the hits with an integral or peak time outside the configured windows
+     *
+     *  @param  evt the art event
+     *  @param  inputHits the input vector of hits
+     *  @param  selectedHits the output vector of hits to pass to Pandora
+     *  @param  rejectedHits the output vector of hits outside the windows
+     */
+    void FilterHits(const art::Event& evt,
+                    const HitVector& inputHits,
+                    HitVector& selectedHits,
+                    HitVector& rejectedHits) override;
+
+  private:
+    float m_minIntegral; ///< The min hit integral to keep a hit
+    float m_maxIntegral; ///< The max hit integral to keep a hit
+    float m_minPeakTime; ///< The min hit peak time to keep a hit
+    float m_maxPeakTime; ///< The max hit peak time to keep a hit
+  };
+
+  DEFINE_ART_CLASS_TOOL(HitWindowFilter)
+
+} // namespace lar_pandora
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+// implementation follows
+
+namespace lar_pandora {
+
+  HitWindowFilter::HitWindowFilter(fhicl::ParameterSet const& pset)
+    : m_minIntegral(pset.get<float>("MinIntegral", std::numeric_limits<float>::lowest()))
+    , m_maxIntegral(pset.get<float>("MaxIntegral", std::numeric_limits<float>::max()))
+    , m_minPeakTime(pset.get<float>("MinPeakTime", std::numeric_limits<float>::lowest()))
+    , m_maxPeakTime(pset.get<float>("MaxPeakTime", std::numeric_limits<float>::max()))
+  {
+    if (m_minIntegral > m_maxIntegral || m_minPeakTime > m_maxPeakTime)
+      throw cet::exception("LArPandora")
+        << " HitWindowFilter - window minima must not exceed maxima " << std::endl;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  HitWindowFilter::FilterHits(const art::Event& /*evt*/,
+                              const HitVector& inputHits,
+                              HitVector& selectedHits,
+                              HitVector& rejectedHits)
+  {
+    for (const art::Ptr<recob::Hit>& hit : inputHits) {
+      const float integral(hit->Integral());
+      const float peakTime(hit->PeakTime());
+
+      if (integral >= m_minIntegral && integral <= m_maxIntegral && peakTime >= m_minPeakTime &&
+          peakTime <= m_maxPeakTime)
+        selectedHits.push_back(hit);
+      else
+        rejectedHits.push_back(hit);
+    }
+  }
+
+} // namespace lar_pandora
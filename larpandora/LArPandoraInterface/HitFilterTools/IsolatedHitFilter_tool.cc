@@ -0,0 +1,139 @@
+/**
+ *  @file   larpandora/LArPandoraInterface/HitFilterTools/IsolatedHitFilter_tool.cc
+ *
+ *  @brief  implementation of the lar pandora isolated hit filter tool
+ */
+
+#include "art/Utilities/ToolMacros.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include "lardataobj/RecoBase/Hit.h"
+
+#include "larpandora/LArPandoraInterface/HitFilterBaseTool.h"
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lar_pandora {
+
+  /**
+   *  @brief  Hit filter tool that removes hits with too few neighbours in a coarse per plane wire/time binning
+   */
+  class IsolatedHitFilter : public HitFilterBaseTool {
+  public:
+    /**
+     *  @brief  Default constructor
+     *
+     *  @param  pset FHiCL parameter set
+     */
+    IsolatedHitFilter(fhicl::ParameterSet const& pset);
+
+    /**
+     *  @brief  Remove the hits with fewer than the required number of neighbours in their own and adjacent bins
+     *
+     *  @param  evt the art event
+     *  @param  inputHits the input vector of hits
+     *  @param  selectedHits the output vector of hits to pass to Pandora
+     *  @param  rejectedHits the output vector of isolated hits
+     */
+    void FilterHits(const art::Event& evt,
+                    const HitVector& inputHits,
+                    HitVector& selectedHits,
+                    HitVector& rejectedHits) override;
+
+  private:
+    typedef std::unordered_map<std::uint64_t, unsigned int> BinToNHitsMap;
+
+    /**
+     *  @brief  Get the key of a wire/time bin
+     *
+     *  @param  wireBin the wire bin
+     *  @param  timeBin the time bin
+     *
+     *  @return the key
+     */
+    static std::uint64_t GetBinKey(const int wireBin, const int timeBin);
+
+    unsigned int m_wireBinSize;      ///< The number of wires in each bin
+    float m_timeBinSize;             ///< The number of ticks in each bin
+    unsigned int m_minNeighbourHits; ///< The min number of other hits in the surrounding 3x3 bins to keep a hit
+  };
+
+  DEFINE_ART_CLASS_TOOL(IsolatedHitFilter)
+
+} // namespace lar_pandora
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+// implementation follows
+
+namespace lar_pandora {
+
+  IsolatedHitFilter::IsolatedHitFilter(fhicl::ParameterSet const& pset)
+    : m_wireBinSize(pset.get<unsigned int>("WireBinSize", 4))
+    , m_timeBinSize(pset.get<float>("TimeBinSize", 20.f))
+    , m_minNeighbourHits(pset.get<unsigned int>("MinNeighbourHits", 1))
+  {
+    if (0 == m_wireBinSize || !(m_timeBinSize > 0.f))
+      throw cet::exception("LArPandora")
+        << " IsolatedHitFilter - wire and time bin sizes must be positive " << std::endl;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  IsolatedHitFilter::FilterHits(const art::Event& /*evt*/,
+                                const HitVector& inputHits,
+                                HitVector& selectedHits,
+                                HitVector& rejectedHits)
+  {
+    // Bin the hits on each plane, remembering the bin of each hit
+    std::map<geo::PlaneID, BinToNHitsMap> planeToBinMap;
+    std::vector<std::pair<int, int>> hitBins;
+    hitBins.reserve(inputHits.size());
+
+    for (const art::Ptr<recob::Hit>& hit : inputHits) {
+      const int wireBin(static_cast<int>(hit->WireID().Wire / m_wireBinSize));
+      const int timeBin(static_cast<int>(std::floor(hit->PeakTime() / m_timeBinSize)));
+
+      hitBins.emplace_back(wireBin, timeBin);
+      ++planeToBinMap[hit->WireID().planeID()][GetBinKey(wireBin, timeBin)];
+    }
+
+    // Keep the hits with enough other hits in their own and the adjacent bins
+    for (size_t hitIndex = 0; hitIndex < inputHits.size(); ++hitIndex) {
+      const art::Ptr<recob::Hit>& hit(inputHits[hitIndex]);
+      const BinToNHitsMap& binToNHitsMap(planeToBinMap.at(hit->WireID().planeID()));
+      const auto& [wireBin, timeBin] = hitBins[hitIndex];
+
+      // ATTN Start at minus one so the hit does not count itself
+      int nNeighbourHits(-1);
+
+      for (int dWire = -1; dWire <= 1; ++dWire) {
+        for (int dTime = -1; dTime <= 1; ++dTime) {
+          const auto iter(binToNHitsMap.find(GetBinKey(wireBin + dWire, timeBin + dTime)));
+          if (binToNHitsMap.end() != iter) nNeighbourHits += iter->second;
+        }
+      }
+
+      if (nNeighbourHits >= static_cast<int>(m_minNeighbourHits))
+        selectedHits.push_back(hit);
+      else
+        rejectedHits.push_back(hit);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  std::uint64_t
+  IsolatedHitFilter::GetBinKey(const int wireBin, const int timeBin)
+  {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(wireBin)) << 32) |
+           static_cast<std::uint32_t>(timeBin);
+  }
+
+} // namespace lar_pandora
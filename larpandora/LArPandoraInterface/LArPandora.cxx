@@ -6,6 +6,7 @@
  */
 
 #include "art/Framework/Principal/Event.h"
+#include "art/Utilities/make_tool.h"
 #include "art_root_io/TFileService.h"
 #include "cetlib/cpu_timer.h"
 
@@ -29,6 +30,7 @@
 #include "Api/PandoraApi.h"
 
 #include "larpandoracontent/LArContent.h"
+#include "larpandoracontent/LArControlFlow/MultiPandoraApi.h"
 #include "larpandoracontent/LArHelpers/LArPfoHelper.h"
 
 #include "larpandora/LArPandoraInterface/LArPandora.h"
@@ -38,6 +40,7 @@
 
 #include <iostream>
 #include <limits>
+#include <unordered_map>
 
 namespace lar_pandora {
 
@@ -59,11 +62,18 @@ namespace lar_pandora {
     , m_hitfinderModuleLabel(pset.get<std::string>("HitFinderModuleLabel"))
     , m_backtrackerModuleLabel(pset.get<std::string>("BackTrackerModuleLabel", ""))
     , m_allOutcomesInstanceLabel(pset.get<std::string>("AllOutcomesInstanceLabel", "allOutcomes"))
+    , m_filteredHitsInstanceLabel(
+        pset.get<std::string>("FilteredHitsInstanceLabel", "filteredHits"))
     , m_enableProduction(pset.get<bool>("EnableProduction", true))
     , m_enableDetectorGaps(pset.get<bool>("EnableLineGaps", true))
     , m_enableMCParticles(pset.get<bool>("EnableMCParticles", false))
     , m_disableRealDataCheck(pset.get<bool>("DisableRealDataCheck", false))
     , m_lineGapsCreated(false)
+    , m_validateGeometryLookup(pset.get<bool>("ValidateGeometryLookup", false))
+    , m_lightweightReset(pset.get<bool>("LightweightReset", false))
+    , m_measureResetTime(pset.get<bool>("MeasureResetTime", false))
+    , m_pandoraInputCreated(false)
+    , m_minHitsPerDriftVolume(pset.get<unsigned int>("MinHitsPerDriftVolume", 0))
   {
     m_inputSettings.m_useHitWidths = pset.get<bool>("UseHitWidths", true);
     m_inputSettings.m_useBirksCorrection = pset.get<bool>("UseBirksCorrection", false);
@@ -86,6 +96,14 @@ namespace lar_pandora {
     m_outputSettings.m_isNeutrinoRecoOnlyNoSlicing =
       (!m_shouldRunSlicing && m_shouldRunNeutrinoRecoOption && !m_shouldRunCosmicRecoOption);
     m_outputSettings.m_hitfinderModuleLabel = m_hitfinderModuleLabel;
+    m_outputSettings.m_spacePointErrorModel =
+      LArPandoraOutput::Settings::GetSpacePointErrorModel(
+        pset.get<std::string>("SpacePointErrorModel", "None"));
+    m_outputSettings.m_driftResolution_cm = pset.get<double>("DriftResolution", 0.);
+
+    if (pset.has_key("HitFilterTool"))
+      m_pHitFilterTool =
+        art::make_tool<HitFilterBaseTool>(pset.get<fhicl::ParameterSet>("HitFilterTool"));
 
     if (m_enableProduction) {
       // Set up the instance names to produces
@@ -125,6 +143,11 @@ namespace lar_pandora {
           produces<art::Assns<recob::PFParticle, recob::Slice>>(instanceName);
         }
       }
+
+      if (m_pHitFilterTool) {
+        produces<std::vector<recob::Slice>>(m_filteredHitsInstanceLabel);
+        produces<art::Assns<recob::Slice, recob::Hit>>(m_filteredHitsInstanceLabel);
+      }
     }
   }
 
@@ -134,8 +157,13 @@ namespace lar_pandora {
   LArPandora::beginJob()
   {
     LArDriftVolumeList driftVolumeList;
-    LArPandoraGeometry::LoadGeometry(
-      driftVolumeList, m_driftVolumeMap, m_inputSettings.m_useActiveBoundingBox);
+    LArPandoraGeometry::LoadGeometry(driftVolumeList,
+                                     m_driftVolumeMap,
+                                     m_driftVolumeLookup,
+                                     m_inputSettings.m_useActiveBoundingBox);
+
+    if (m_validateGeometryLookup)
+      LArPandoraGeometry::ValidateLookup(m_driftVolumeMap, m_driftVolumeLookup);
 
     this->CreatePandoraInstances();
 
@@ -152,7 +180,7 @@ namespace lar_pandora {
     // If using global drift volume approach, pass details of gaps between daughter volumes to the pandora instance
     if (m_enableDetectorGaps) {
       LArDetectorGapList listOfGaps;
-      LArPandoraGeometry::LoadDetectorGaps(listOfGaps, m_inputSettings.m_useActiveBoundingBox);
+      LArPandoraGeometry::LoadDetectorGaps(driftVolumeList, listOfGaps);
       LArPandoraInput::CreatePandoraDetectorGaps(m_inputSettings, driftVolumeList, listOfGaps);
     }
 
@@ -165,11 +193,41 @@ namespace lar_pandora {
   void
   LArPandora::produce(art::Event& evt)
   {
+    // ATTN Instances are left clean by the previous reset, so the output step writes empty products
+    if (this->IsBelowOccupancyThreshold(evt)) {
+      this->ProcessPandoraOutput(evt, IdToHitMap());
+      return;
+    }
+
     IdToHitMap idToHitMap;
     this->CreatePandoraInput(evt, idToHitMap);
-    this->RunPandoraInstances();
+
+    // ATTN The instances are left clean by the previous reset, so if they were given no input there is nothing to run or reset
+    const bool shouldRunPandora(!m_lightweightReset || m_pandoraInputCreated);
+
+    if (shouldRunPandora) this->RunPandoraInstances();
+
     this->ProcessPandoraOutput(evt, idToHitMap);
+
+    if (!shouldRunPandora) return;
+
+    if (!m_measureResetTime) {
+      this->ResetPandoraInstances();
+      return;
+    }
+
+    cet::cpu_timer resetTimer;
+    resetTimer.start();
     this->ResetPandoraInstances();
+    resetTimer.stop();
+
+    const size_t nDaughterInstances(
+      MultiPandoraApi::GetDaughterPandoraInstanceList(m_pPrimaryPandora).size());
+
+    mf::LogInfo("LArPandora") << " LArPandora::produce - reset of instance "
+                              << m_pPrimaryPandora->GetName() << " and its " << nDaughterInstances
+                              << " daughter instances took " << resetTimer.elapsed_real_time()
+                              << " s (cpu " << resetTimer.elapsed_cpu_time() << " s)";
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -195,6 +253,23 @@ namespace lar_pandora {
 
     LArPandoraHelper::CollectHits(evt, m_hitfinderModuleLabel, artHits);
 
+    if (m_pHitFilterTool) {
+      HitVector selectedHits;
+      m_filteredHits.clear();
+      m_pHitFilterTool->FilterHits(evt, artHits, selectedHits, m_filteredHits);
+
+      if (selectedHits.size() + m_filteredHits.size() != artHits.size())
+        throw cet::exception("LArPandora")
+          << " LArPandora::CreatePandoraInput - hit filter returned " << selectedHits.size()
+          << " selected and " << m_filteredHits.size() << " removed hits from "
+          << artHits.size() << " input hits " << std::endl;
+
+      mf::LogInfo("LArPandora") << " LArPandora::CreatePandoraInput - hit filter removed "
+                                << m_filteredHits.size() << " of " << artHits.size() << " hits";
+
+      artHits.swap(selectedHits);
+    }
+
     if (m_enableMCParticles && (m_disableRealDataCheck || !evt.isRealData())) {
       LArPandoraHelper::CollectMCParticles(evt, m_geantModuleLabel, artMCParticleVector);
 
@@ -227,7 +302,7 @@ namespace lar_pandora {
     }
 
     LArPandoraInput::CreatePandoraHits2D(
-      evt, m_inputSettings, m_driftVolumeMap, artHits, idToHitMap);
+      evt, m_inputSettings, m_driftVolumeLookup, artHits, idToHitMap);
 
     if (m_enableMCParticles && (m_disableRealDataCheck || !evt.isRealData())) {
       LArPandoraInput::CreatePandoraMCParticles(m_inputSettings,
@@ -236,6 +311,39 @@ namespace lar_pandora {
                                                 generatorArtMCParticleVector);
       LArPandoraInput::CreatePandoraMCLinks2D(m_inputSettings, idToHitMap, artHitsToTrackIDEs);
     }
+
+    m_pandoraInputCreated = (!idToHitMap.empty() || !artMCTruthToMCParticles.empty() ||
+                             !generatorArtMCParticleVector.empty());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  LArPandora::IsBelowOccupancyThreshold(const art::Event& evt) const
+  {
+    if (0 == m_minHitsPerDriftVolume) return false;
+
+    art::Handle<std::vector<recob::Hit>> hitHandle;
+    evt.getByLabel(m_hitfinderModuleLabel, hitHandle);
+
+    if (!hitHandle.isValid()) return true;
+
+    // Count the hits in each drift volume, stopping as soon as one volume reaches the threshold
+    std::unordered_map<unsigned int, unsigned int> volumeIdToNHitsMap;
+
+    for (const recob::Hit& hit : *hitHandle) {
+      const geo::WireID hitWireID(hit.WireID());
+      const unsigned int volumeId(
+        m_driftVolumeLookup.GetVolumeID(hitWireID.Cryostat, hitWireID.TPC));
+
+      if (++volumeIdToNHitsMap[volumeId] >= m_minHitsPerDriftVolume) return false;
+    }
+
+    mf::LogDebug("LArPandora") << " LArPandora::produce - skipping event with "
+                               << hitHandle->size() << " hits, fewer than "
+                               << m_minHitsPerDriftVolume << " in every drift volume" << std::endl;
+
+    return true;
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -252,7 +360,13 @@ namespace lar_pandora {
         m_outputSettings.m_allOutcomesInstanceLabel = m_allOutcomesInstanceLabel;
         LArPandoraOutput::ProduceArtOutput(m_outputSettings, idToHitMap, evt);
       }
+
+      if (m_pHitFilterTool)
+        LArPandoraOutput::ProduceFilteredHitsOutput(
+          m_filteredHitsInstanceLabel, m_filteredHits, evt);
     }
+
+    m_filteredHits.clear();
   }
 
 } // namespace lar_pandora
@@ -8,6 +8,7 @@
 #ifndef LAR_PANDORA_H
 #define LAR_PANDORA_H 1
 
+#include "larpandora/LArPandoraInterface/HitFilterBaseTool.h"
 #include "larpandora/LArPandoraInterface/ILArPandora.h"
 #include "larpandora/LArPandoraInterface/LArPandoraGeometry.h"
 #include "larpandora/LArPandoraInterface/LArPandoraInput.h"
@@ -37,6 +38,15 @@ namespace lar_pandora {
     void CreatePandoraInput(art::Event& evt, IdToHitMap& idToHitMap);
     void ProcessPandoraOutput(art::Event& evt, const IdToHitMap& idToHitMap);
 
+    /**
+     *  @brief  Check whether every drift volume has fewer input hits than the occupancy threshold
+     *
+     *  @param  evt the art event
+     *
+     *  @return whether the event is below the occupancy threshold
+     */
+    bool IsBelowOccupancyThreshold(const art::Event& evt) const;
+
     std::string m_configFile; ///< The config file
 
     bool
@@ -61,7 +71,8 @@ namespace lar_pandora {
     std::string m_hitfinderModuleLabel;   ///< The hit finder module label
     std::string m_backtrackerModuleLabel; ///< The back tracker module label
 
-    std::string m_allOutcomesInstanceLabel; ///< The instance label for all outcomes
+    std::string m_allOutcomesInstanceLabel;  ///< The instance label for all outcomes
+    std::string m_filteredHitsInstanceLabel; ///< The instance label for the hits removed by the hit filter
 
     bool m_enableProduction;   ///< Whether to persist output products
     bool m_enableDetectorGaps; ///< Whether to pass detector gap information to Pandora instances
@@ -70,11 +81,21 @@ namespace lar_pandora {
     bool
       m_disableRealDataCheck; ///< Whether to check if the input file contains real data before accessing MC information
     bool m_lineGapsCreated; ///< Book-keeping: whether line gap creation has been called
+    bool m_validateGeometryLookup; ///< Whether to check the drift volume lookup table in beginJob
+    bool
+      m_lightweightReset; ///< Whether to skip running and resetting the Pandora instances for events that give them no input
+    bool m_measureResetTime; ///< Whether to report the time taken to reset the Pandora instances
+    bool m_pandoraInputCreated; ///< Book-keeping: whether the current event gave any input to Pandora
+    unsigned int m_minHitsPerDriftVolume; ///< Min hits in any drift volume to run Pandora (0: always run)
+
+    std::unique_ptr<HitFilterBaseTool> m_pHitFilterTool; ///< The optional tool removing hits before Pandora
+    HitVector m_filteredHits; ///< Book-keeping: the hits removed by the hit filter in the current event
 
     LArPandoraInput::Settings m_inputSettings;   ///< The lar pandora input settings
     LArPandoraOutput::Settings m_outputSettings; ///< The lar pandora output settings
 
-    LArDriftVolumeMap m_driftVolumeMap; ///< The map from volume id to drift volume
+    LArDriftVolumeMap m_driftVolumeMap;       ///< The map from volume id to drift volume
+    LArDriftVolumeLookup m_driftVolumeLookup; ///< The cryostat/tpc lookup table of drift volumes
   };
 
 } // namespace lar_pandora
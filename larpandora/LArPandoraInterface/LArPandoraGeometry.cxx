@@ -11,10 +11,14 @@
 #include "larcorealg/Geometry/TPCGeo.h"
 #include "larcorealg/Geometry/WireGeo.h"
 
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
 #include "larpandora/LArPandoraInterface/Detectors/LArPandoraDetectorType.h"
 #include "larpandora/LArPandoraInterface/LArPandoraGeometry.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <numeric>
 #include <set>
 
 namespace lar_pandora {
@@ -28,63 +32,150 @@ namespace lar_pandora {
       throw cet::exception("LArPandora")
         << " LArPandoraGeometry::LoadDetectorGaps --- the list of gaps already exists ";
 
-    // Loop over drift volumes and write out the dead regions at their boundaries
     LArDriftVolumeList driftVolumeList;
     LArPandoraGeometry::LoadGeometry(driftVolumeList, useActiveBoundingBox);
+    LArPandoraGeometry::LoadDetectorGaps(driftVolumeList, listOfGaps);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraGeometry::LoadDetectorGaps(const LArDriftVolumeList& driftVolumeList,
+                                       LArDetectorGapList& listOfGaps)
+  {
     LArPandoraDetectorType* detType(detector_functions::GetDetectorType());
+    LArPandoraGeometry::LoadDetectorGaps(*detType, driftVolumeList, listOfGaps);
+  }
 
-    for (LArDriftVolumeList::const_iterator iter1 = driftVolumeList.begin(),
-                                            iterEnd1 = driftVolumeList.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const LArDriftVolume& driftVolume1 = *iter1;
+  //------------------------------------------------------------------------------------------------------------------------------------------
 
-      for (LArDriftVolumeList::const_iterator iter2 = iter1, iterEnd2 = driftVolumeList.end();
-           iter2 != iterEnd2;
-           ++iter2) {
-        const LArDriftVolume& driftVolume2 = *iter2;
+  void
+  LArPandoraGeometry::LoadDetectorGaps(const LArPandoraDetectorType& detType,
+                                       const LArDriftVolumeList& driftVolumeList,
+                                       LArDetectorGapList& listOfGaps)
+  {
+    // Detector gaps can only be loaded once - throw an exception if the output lists are already filled
+    if (!listOfGaps.empty())
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometry::LoadDetectorGaps --- the list of gaps already exists ";
 
-        if (driftVolume1.GetVolumeID() == driftVolume2.GetVolumeID()) continue;
+    const float maxDisplacement(LArDetectorGap::GetMaxGapSize());
 
-        const float maxDisplacement(LArDetectorGap::GetMaxGapSize());
-
-        const float deltaX(std::fabs(driftVolume1.GetCenterX() - driftVolume2.GetCenterX()));
-        const float deltaY(std::fabs(driftVolume1.GetCenterY() - driftVolume2.GetCenterY()));
-        const float deltaZ(std::fabs(driftVolume1.GetCenterZ() - driftVolume2.GetCenterZ()));
-
-        const float widthX(0.5f * (driftVolume1.GetWidthX() + driftVolume2.GetWidthX()));
-        const float widthY(0.5f * (driftVolume1.GetWidthY() + driftVolume2.GetWidthY()));
-        const float widthZ(0.5f * (driftVolume1.GetWidthZ() + driftVolume2.GetWidthZ()));
-
-        const float gapX(deltaX - widthX);
-        const float gapY(deltaY - widthY);
-        const float gapZ(deltaZ - widthZ);
-
-        const float X1((driftVolume1.GetCenterX() < driftVolume2.GetCenterX()) ?
-                         (driftVolume1.GetCenterX() + 0.5f * driftVolume1.GetWidthX()) :
-                         (driftVolume2.GetCenterX() + 0.5f * driftVolume2.GetWidthX()));
-        const float X2((driftVolume1.GetCenterX() > driftVolume2.GetCenterX()) ?
-                         (driftVolume1.GetCenterX() - 0.5f * driftVolume1.GetWidthX()) :
-                         (driftVolume2.GetCenterX() - 0.5f * driftVolume2.GetWidthX()));
-        const float Y1(std::min((driftVolume1.GetCenterY() - 0.5f * driftVolume1.GetWidthY()),
-                                (driftVolume2.GetCenterY() - 0.5f * driftVolume2.GetWidthY())));
-        const float Y2(std::max((driftVolume1.GetCenterY() + 0.5f * driftVolume1.GetWidthY()),
-                                (driftVolume2.GetCenterY() + 0.5f * driftVolume2.GetWidthY())));
-        const float Z1(std::min((driftVolume1.GetCenterZ() - 0.5f * driftVolume1.GetWidthZ()),
-                                (driftVolume2.GetCenterZ() - 0.5f * driftVolume2.GetWidthZ())));
-        const float Z2(std::max((driftVolume1.GetCenterZ() + 0.5f * driftVolume1.GetWidthZ()),
-                                (driftVolume2.GetCenterZ() + 0.5f * driftVolume2.GetWidthZ())));
-
-        geo::Vector_t gaps(gapX, gapY, gapZ), deltas(deltaX, deltaY, deltaZ);
-        if (detType->CheckDetectorGapSize(gaps, deltas, maxDisplacement)) {
-          geo::Point_t point1(X1, Y1, Z1), point2(X2, Y2, Z2);
-          geo::Vector_t widths(widthX, widthY, widthZ);
-          listOfGaps.emplace_back(detType->CreateDetectorGap(point1, point2, widths));
+    // Where gaps can only be made between volumes that are close in X, sweep along X and only test
+    // the volumes whose centres are near enough to allow a gap, otherwise test every pair of volumes
+    const bool isLocalInX(detType.AreDetectorGapsLocalInX());
+
+    std::vector<size_t> sortedIndices(driftVolumeList.size());
+    std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
+    float maxWidthX(0.f);
+
+    if (isLocalInX) {
+      std::stable_sort(sortedIndices.begin(),
+                       sortedIndices.end(),
+                       [&driftVolumeList](const size_t a, const size_t b) {
+                         return driftVolumeList[a].GetCenterX() < driftVolumeList[b].GetCenterX();
+                       });
+
+      for (const LArDriftVolume& driftVolume : driftVolumeList)
+        maxWidthX = std::max(maxWidthX, driftVolume.GetWidthX());
+    }
+
+    std::vector<size_t> candidateIndices;
+
+    // Loop over drift volumes and write out the dead regions at their boundaries
+    for (size_t index1 = 0; index1 < driftVolumeList.size(); ++index1) {
+      const LArDriftVolume& driftVolume1 = driftVolumeList[index1];
+
+      candidateIndices.clear();
+
+      if (isLocalInX) {
+        // The gap in X is the separation of the centres less half the sum of the widths, with some
+        // margin for rounding
+        const float centerX(driftVolume1.GetCenterX());
+        const float windowX(1.01f *
+                            (maxDisplacement + 0.5f * (driftVolume1.GetWidthX() + maxWidthX)));
+
+        auto lowerIter = std::lower_bound(
+          sortedIndices.begin(),
+          sortedIndices.end(),
+          centerX - windowX,
+          [&driftVolumeList](const size_t index, const float x) {
+            return driftVolumeList[index].GetCenterX() < x;
+          });
+        auto upperIter = std::upper_bound(
+          lowerIter,
+          sortedIndices.end(),
+          centerX + windowX,
+          [&driftVolumeList](const float x, const size_t index) {
+            return x < driftVolumeList[index].GetCenterX();
+          });
+
+        for (auto iter = lowerIter; iter != upperIter; ++iter) {
+          if (*iter > index1) candidateIndices.push_back(*iter);
         }
+
+        // Test the candidates in list order, so the gaps are listed as for a test of every pair
+        std::sort(candidateIndices.begin(), candidateIndices.end());
       }
+      else {
+        for (size_t index2 = index1 + 1; index2 < driftVolumeList.size(); ++index2)
+          candidateIndices.push_back(index2);
+      }
+
+      for (const size_t index2 : candidateIndices) {
+        const LArDriftVolume& driftVolume2 = driftVolumeList[index2];
+
+        if (driftVolume1.GetVolumeID() == driftVolume2.GetVolumeID()) continue;
 
-      detType->LoadDaughterDetectorGaps(driftVolume1, LArDetectorGap::GetMaxGapSize(), listOfGaps);
+        LArPandoraGeometry::LoadDetectorGap(detType, driftVolume1, driftVolume2, listOfGaps);
+      }
+
+      detType.LoadDaughterDetectorGaps(driftVolume1, maxDisplacement, listOfGaps);
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometry::LoadDetectorGap(const LArPandoraDetectorType& detType,
+                                      const LArDriftVolume& driftVolume1,
+                                      const LArDriftVolume& driftVolume2,
+                                      LArDetectorGapList& listOfGaps)
+  {
+    const float maxDisplacement(LArDetectorGap::GetMaxGapSize());
+
+    const float deltaX(std::fabs(driftVolume1.GetCenterX() - driftVolume2.GetCenterX()));
+    const float deltaY(std::fabs(driftVolume1.GetCenterY() - driftVolume2.GetCenterY()));
+    const float deltaZ(std::fabs(driftVolume1.GetCenterZ() - driftVolume2.GetCenterZ()));
+
+    const float widthX(0.5f * (driftVolume1.GetWidthX() + driftVolume2.GetWidthX()));
+    const float widthY(0.5f * (driftVolume1.GetWidthY() + driftVolume2.GetWidthY()));
+    const float widthZ(0.5f * (driftVolume1.GetWidthZ() + driftVolume2.GetWidthZ()));
+
+    const float gapX(deltaX - widthX);
+    const float gapY(deltaY - widthY);
+    const float gapZ(deltaZ - widthZ);
+
+    const float X1((driftVolume1.GetCenterX() < driftVolume2.GetCenterX()) ?
+                     (driftVolume1.GetCenterX() + 0.5f * driftVolume1.GetWidthX()) :
+                     (driftVolume2.GetCenterX() + 0.5f * driftVolume2.GetWidthX()));
+    const float X2((driftVolume1.GetCenterX() > driftVolume2.GetCenterX()) ?
+                     (driftVolume1.GetCenterX() - 0.5f * driftVolume1.GetWidthX()) :
+                     (driftVolume2.GetCenterX() - 0.5f * driftVolume2.GetWidthX()));
+    const float Y1(std::min((driftVolume1.GetCenterY() - 0.5f * driftVolume1.GetWidthY()),
+                            (driftVolume2.GetCenterY() - 0.5f * driftVolume2.GetWidthY())));
+    const float Y2(std::max((driftVolume1.GetCenterY() + 0.5f * driftVolume1.GetWidthY()),
+                            (driftVolume2.GetCenterY() + 0.5f * driftVolume2.GetWidthY())));
+    const float Z1(std::min((driftVolume1.GetCenterZ() - 0.5f * driftVolume1.GetWidthZ()),
+                            (driftVolume2.GetCenterZ() - 0.5f * driftVolume2.GetWidthZ())));
+    const float Z2(std::max((driftVolume1.GetCenterZ() + 0.5f * driftVolume1.GetWidthZ()),
+                            (driftVolume2.GetCenterZ() + 0.5f * driftVolume2.GetWidthZ())));
+
+    geo::Vector_t gaps(gapX, gapY, gapZ), deltas(deltaX, deltaY, deltaZ);
+    if (detType.CheckDetectorGapSize(gaps, deltas, maxDisplacement)) {
+      geo::Point_t point1(X1, Y1, Z1), point2(X2, Y2, Z2);
+      geo::Vector_t widths(widthX, widthY, widthZ);
+      listOfGaps.emplace_back(detType.CreateDetectorGap(point1, point2, widths));
     }
   }
 
@@ -112,6 +203,77 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraGeometry::LoadGeometry(LArDriftVolumeList& outputVolumeList,
+                                   LArDriftVolumeMap& outputVolumeMap,
+                                   LArDriftVolumeLookup& outputVolumeLookup,
+                                   const bool useActiveBoundingBox)
+  {
+    LArPandoraGeometry::LoadGeometry(outputVolumeList, outputVolumeMap, useActiveBoundingBox);
+    LArPandoraGeometry::LoadLookup(outputVolumeMap, outputVolumeLookup);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraGeometry::ValidateLookup(const LArDriftVolumeMap& driftVolumeMap,
+                                     const LArDriftVolumeLookup& driftVolumeLookup)
+  {
+    art::ServiceHandle<geo::Geometry const> theGeometry;
+
+    for (unsigned int icstat = 0; icstat < theGeometry->Ncryostats(); ++icstat) {
+      for (unsigned int itpc = 0; itpc < theGeometry->NTPC(icstat); ++itpc) {
+        if (driftVolumeMap.end() ==
+            driftVolumeMap.find(LArPandoraGeometry::GetTpcID(icstat, itpc))) {
+          bool isMissing(false);
+          try {
+            (void)driftVolumeLookup.GetVolumeID(icstat, itpc);
+          }
+          catch (const cet::exception&) {
+            isMissing = true;
+          }
+
+          if (!isMissing)
+            throw cet::exception("LArPandora")
+              << " LArPandoraGeometry::ValidateLookup --- cryostat " << icstat << " tpc " << itpc
+              << " has no drift volume but is in the lookup table ";
+          continue;
+        }
+
+        const unsigned int volumeID(
+          LArPandoraGeometry::GetVolumeID(driftVolumeMap, icstat, itpc));
+        const unsigned int daughterVolumeID(
+          LArPandoraGeometry::GetDaughterVolumeID(driftVolumeMap, icstat, itpc));
+        const bool isPositiveDrift(theGeometry->TPC(itpc, icstat).DriftDirection() == geo::kPosX);
+
+        bool isConsistent(
+          (volumeID == driftVolumeLookup.GetVolumeID(icstat, itpc)) &&
+          (daughterVolumeID == driftVolumeLookup.GetDaughterVolumeID(icstat, itpc)) &&
+          (isPositiveDrift == driftVolumeLookup.IsPositiveDrift(icstat, itpc)));
+
+        for (const geo::View_t view : {geo::kU, geo::kV, geo::kW, geo::kY}) {
+          if (LArPandoraGeometry::GetGlobalView(icstat, itpc, view) !=
+              driftVolumeLookup.GetGlobalView(icstat, itpc, view))
+            isConsistent = false;
+        }
+
+        for (const geo::View_t view : {geo::kU, geo::kV, geo::kW}) {
+          if (LArPandoraGeometry::GetTargetView(icstat, itpc, view) !=
+              driftVolumeLookup.GetTargetView(icstat, itpc, view))
+            isConsistent = false;
+        }
+
+        if (!isConsistent)
+          throw cet::exception("LArPandora")
+            << " LArPandoraGeometry::ValidateLookup --- lookup table differs from the drift volume "
+               "map for cryostat "
+            << icstat << " tpc " << itpc;
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   unsigned int
   LArPandoraGeometry::GetVolumeID(const LArDriftVolumeMap& driftVolumeMap,
                                   const unsigned int cstat,
@@ -188,6 +350,87 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraGeometry::LoadLookup(const LArDriftVolumeMap& driftVolumeMap,
+                                 LArDriftVolumeLookup& driftVolumeLookup)
+  {
+    if (driftVolumeLookup.IsLoaded())
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometry::LoadLookup --- the drift volume lookup table already exists ";
+
+    if (driftVolumeMap.empty())
+      throw cet::exception("LArPandora")
+        << " LArPandoraGeometry::LoadLookup --- detector geometry map is empty";
+
+    art::ServiceHandle<geo::Geometry const> theGeometry;
+
+    // One row per tpc, the rows of each cryostat following on from the previous cryostat
+    driftVolumeLookup.m_cryostatOffsets.assign(1, 0);
+    for (unsigned int icstat = 0; icstat < theGeometry->Ncryostats(); ++icstat)
+      driftVolumeLookup.m_cryostatOffsets.push_back(driftVolumeLookup.m_cryostatOffsets.back() +
+                                                    theGeometry->NTPC(icstat));
+
+    const size_t nRows(driftVolumeLookup.m_cryostatOffsets.back());
+    driftVolumeLookup.m_volumeIDs.assign(nRows, LArDriftVolumeLookup::kInvalidVolumeID);
+    driftVolumeLookup.m_daughterVolumeIDs.assign(nRows, LArDriftVolumeLookup::kInvalidVolumeID);
+    driftVolumeLookup.m_isPositiveDrift.assign(nRows, false);
+    driftVolumeLookup.m_globalViews.assign(3 * nRows, geo::kUnknown);
+    driftVolumeLookup.m_targetViews.assign(3 * nRows, geo::kUnknown);
+
+    for (unsigned int icstat = 0; icstat < theGeometry->Ncryostats(); ++icstat) {
+      for (unsigned int itpc = 0; itpc < theGeometry->NTPC(icstat); ++itpc) {
+        // TPCs outside every drift volume keep an invalid ID, looking them up throws as GetVolumeID
+        // does
+        if (driftVolumeMap.end() ==
+            driftVolumeMap.find(LArPandoraGeometry::GetTpcID(icstat, itpc)))
+          continue;
+
+        const size_t row(driftVolumeLookup.m_cryostatOffsets[icstat] + itpc);
+
+        driftVolumeLookup.m_volumeIDs[row] =
+          LArPandoraGeometry::GetVolumeID(driftVolumeMap, icstat, itpc);
+        driftVolumeLookup.m_daughterVolumeIDs[row] =
+          LArPandoraGeometry::GetDaughterVolumeID(driftVolumeMap, icstat, itpc);
+        driftVolumeLookup.m_isPositiveDrift[row] =
+          (theGeometry->TPC(itpc, icstat).DriftDirection() == geo::kPosX);
+
+        for (const geo::View_t view : {geo::kU, geo::kV, geo::kW}) {
+          driftVolumeLookup.m_globalViews[3 * row + view] =
+            LArPandoraGeometry::GetGlobalView(icstat, itpc, view);
+          driftVolumeLookup.m_targetViews[3 * row + view] =
+            LArPandoraGeometry::GetTargetView(icstat, itpc, view);
+        }
+      }
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  geo::View_t
+  LArPandoraGeometry::GetTargetView(const unsigned int cstat,
+                                    const unsigned int tpc,
+                                    const geo::View_t pandoraView)
+  {
+    LArPandoraDetectorType* detType(detector_functions::GetDetectorType());
+
+    // ATTN Some detector types have no plane to map to one of the views, these are left unknown so
+    // that CreatePandoraHits2D throws for hits in them, as the detector type call per hit did
+    try {
+      if (pandoraView == geo::kU) return detType->TargetViewU(tpc, cstat);
+      if (pandoraView == geo::kV) return detType->TargetViewV(tpc, cstat);
+      if (pandoraView == geo::kW) return detType->TargetViewW(tpc, cstat);
+    }
+    catch (const cet::exception&) {
+      mf::LogDebug("LArPandora") << " LArPandoraGeometry::GetTargetView --- unable to map view "
+                                 << pandoraView << " for cryostat " << cstat << " tpc " << tpc
+                                 << std::endl;
+    }
+
+    return geo::kUnknown;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   unsigned int
   LArPandoraGeometry::GetTpcID(const unsigned int cstat, const unsigned int tpc)
   {
@@ -464,6 +707,59 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  geo::View_t
+  LArDriftVolumeLookup::GetGlobalView(const unsigned int cstat,
+                                      const unsigned int tpc,
+                                      const geo::View_t hit_View) const
+  {
+    const size_t row(this->GetIndex(cstat, tpc));
+
+    // ATTN As LArPandoraGeometry::GetGlobalView, the Y view is never switched
+    if ((hit_View == geo::kU) || (hit_View == geo::kV) || (hit_View == geo::kW))
+      return m_globalViews[3 * row + hit_View];
+    else if (hit_View == geo::kY)
+      return hit_View;
+
+    throw cet::exception("LArPandora")
+      << " LArDriftVolumeLookup::GetGlobalView --- found an unknown plane view (not U, V or W) ";
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  geo::View_t
+  LArDriftVolumeLookup::GetTargetView(const unsigned int cstat,
+                                      const unsigned int tpc,
+                                      const geo::View_t pandoraView) const
+  {
+    if ((pandoraView != geo::kU) && (pandoraView != geo::kV) && (pandoraView != geo::kW))
+      throw cet::exception("LArPandora")
+        << " LArDriftVolumeLookup::GetTargetView --- Pandora view must be U, V or W ";
+
+    return m_targetViews[3 * this->GetIndex(cstat, tpc) + pandoraView];
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  size_t
+  LArDriftVolumeLookup::GetIndex(const unsigned int cstat, const unsigned int tpc) const
+  {
+    if (m_volumeIDs.empty())
+      throw cet::exception("LArPandora")
+        << " LArDriftVolumeLookup::GetIndex --- drift volume lookup table is empty";
+
+    if ((cstat + 1 < m_cryostatOffsets.size()) &&
+        (tpc < m_cryostatOffsets[cstat + 1] - m_cryostatOffsets[cstat])) {
+      const size_t row(m_cryostatOffsets[cstat] + tpc);
+      if (kInvalidVolumeID != m_volumeIDs[row]) return row;
+    }
+
+    throw cet::exception("LArPandora")
+      << " LArDriftVolumeLookup::GetIndex --- found a TPC that doesn't belong to a drift volume";
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   LArDriftVolume::LArDriftVolume(const unsigned int volumeID,
                                  const bool isPositiveDrift,
                                  const float wirePitchU,
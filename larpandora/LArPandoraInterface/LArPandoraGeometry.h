@@ -9,11 +9,14 @@
 
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 
+#include <limits>
 #include <map>
 #include <vector>
 
 namespace lar_pandora {
 
+  class LArPandoraDetectorType;
+
   /**
  *  @brief  drift volume class to hold properties of drift volume
  */
@@ -317,6 +320,86 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  /**
+ *  @brief  dense per cryostat/tpc table of the drift volume and view properties used for every hit
+ */
+  class LArDriftVolumeLookup {
+  public:
+    /**
+     *  @brief  Get drift volume ID for a cryostat/tpc pair, as LArPandoraGeometry::GetVolumeID
+     *
+     *  @param  cstat the input cryostat unique ID
+     *  @param  tpc the input tpc unique ID
+     */
+    unsigned int GetVolumeID(const unsigned int cstat, const unsigned int tpc) const;
+
+    /**
+     *  @brief  Get daughter volume ID for a cryostat/tpc pair, as LArPandoraGeometry::GetDaughterVolumeID
+     *
+     *  @param  cstat the input cryostat unique ID
+     *  @param  tpc the input tpc unique ID
+     */
+    unsigned int GetDaughterVolumeID(const unsigned int cstat, const unsigned int tpc) const;
+
+    /**
+     *  @brief  Return drift direction of a cryostat/tpc pair (true if positive)
+     *
+     *  @param  cstat the input cryostat unique ID
+     *  @param  tpc the input tpc unique ID
+     */
+    bool IsPositiveDrift(const unsigned int cstat, const unsigned int tpc) const;
+
+    /**
+     *  @brief  Convert to global coordinate system, as LArPandoraGeometry::GetGlobalView
+     *
+     *  @param  cstat the input cryostat
+     *  @param  tpc the input tpc
+     *  @param  hit_View the input view
+     */
+    geo::View_t GetGlobalView(const unsigned int cstat,
+                              const unsigned int tpc,
+                              const geo::View_t hit_View) const;
+
+    /**
+     *  @brief  Return the LArSoft view mapped to Pandora's U, V or W view for a cryostat/tpc pair, as the detector type
+     *
+     *  @param  cstat the input cryostat
+     *  @param  tpc the input tpc
+     *  @param  pandoraView the Pandora view, geo::kU, geo::kV or geo::kW
+     */
+    geo::View_t GetTargetView(const unsigned int cstat,
+                              const unsigned int tpc,
+                              const geo::View_t pandoraView) const;
+
+    /**
+     *  @brief  Whether the table has been filled
+     */
+    bool IsLoaded() const;
+
+  private:
+    /**
+     *  @brief  Return the row of a cryostat/tpc pair, throwing if it doesn't belong to a drift volume
+     *
+     *  @param  cstat the input cryostat
+     *  @param  tpc the input tpc
+     */
+    size_t GetIndex(const unsigned int cstat, const unsigned int tpc) const;
+
+    static constexpr unsigned int kInvalidVolumeID = std::numeric_limits<unsigned int>::max();
+
+    std::vector<size_t> m_cryostatOffsets;         ///< First row of each cryostat, then the row count
+    std::vector<unsigned int> m_volumeIDs;         ///< Drift volume ID of each row
+    std::vector<unsigned int> m_daughterVolumeIDs; ///< Daughter volume ID of each row
+    std::vector<bool> m_isPositiveDrift;           ///< Drift direction of each row
+    std::vector<geo::View_t> m_globalViews;        ///< Global view of U, V and W, three per row
+    std::vector<geo::View_t> m_targetViews;        ///< LArSoft view of Pandora's U, V and W, three per row
+
+    friend class LArPandoraGeometry;
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   /**
  *  @brief  LArPandoraGeometry class
  */
@@ -330,6 +413,26 @@ namespace lar_pandora {
      */
     static void LoadDetectorGaps(LArDetectorGapList& listOfGaps, const bool useActiveBoundingBox);
 
+    /**
+     *  @brief Load the 2D gaps between a list of drift volumes that has already been loaded
+     *
+     *  @param driftVolumeList the list of drift volumes, as from LoadGeometry
+     *  @param listOfGaps the output list of 2D gaps.
+     */
+    static void LoadDetectorGaps(const LArDriftVolumeList& driftVolumeList,
+                                 LArDetectorGapList& listOfGaps);
+
+    /**
+     *  @brief Load the 2D gaps between a list of drift volumes, for a given detector type
+     *
+     *  @param detType the detector type, deciding which pairs of volumes have a gap
+     *  @param driftVolumeList the list of drift volumes, as from LoadGeometry
+     *  @param listOfGaps the output list of 2D gaps.
+     */
+    static void LoadDetectorGaps(const LArPandoraDetectorType& detType,
+                                 const LArDriftVolumeList& driftVolumeList,
+                                 LArDetectorGapList& listOfGaps);
+
     /**
      *  @brief Load drift volume geometry
      *
@@ -341,6 +444,38 @@ namespace lar_pandora {
                              LArDriftVolumeMap& outputVolumeMap,
                              const bool useActiveBoundingBox);
 
+    /**
+     *  @brief Load drift volume geometry, and the per cryostat/tpc lookup table used for the hits
+     *
+     *  @param outputVolumeList the output list of drift volumes
+     *  @param outputVolumeMap the output mapping between cryostat/tpc and drift volumes
+     *  @param outputVolumeLookup the output lookup table of volume IDs, drift directions and views
+     *  @param useActiveBoundingBox when true use ActiveBoundingBox instead of the default midpoint. Meant to handle offsets and things in a better way.
+     */
+    static void LoadGeometry(LArDriftVolumeList& outputVolumeList,
+                             LArDriftVolumeMap& outputVolumeMap,
+                             LArDriftVolumeLookup& outputVolumeLookup,
+                             const bool useActiveBoundingBox);
+
+    /**
+     *  @brief  Check every entry of a lookup table against GetVolumeID, GetDaughterVolumeID, GetGlobalView and the
+     *          detector type, throwing on the first difference
+     *
+     *  @param  driftVolumeMap the mapping between cryostat/tpc and drift volumes
+     *  @param  driftVolumeLookup the lookup table made from it
+     */
+    static void ValidateLookup(const LArDriftVolumeMap& driftVolumeMap,
+                               const LArDriftVolumeLookup& driftVolumeLookup);
+
+    /**
+     *  @brief  Fill the lookup table from the mapping between cryostat/tpc and drift volumes
+     *
+     *  @param  driftVolumeMap the mapping between cryostat/tpc and drift volumes
+     *  @param  driftVolumeLookup to receive the lookup table
+     */
+    static void LoadLookup(const LArDriftVolumeMap& driftVolumeMap,
+                           LArDriftVolumeLookup& driftVolumeLookup);
+
     /**
      *  @brief  Get drift volume ID from a specified cryostat/tpc pair
      *
@@ -375,6 +510,30 @@ namespace lar_pandora {
                                      const geo::View_t hit_View);
 
   private:
+    /**
+     *  @brief  Add the gap between two drift volumes to the list, if the detector type finds one
+     *
+     *  @param  detType the detector type
+     *  @param  driftVolume1 the first drift volume
+     *  @param  driftVolume2 the second drift volume
+     *  @param  listOfGaps the list of 2D gaps to receive the gap
+     */
+    static void LoadDetectorGap(const LArPandoraDetectorType& detType,
+                                const LArDriftVolume& driftVolume1,
+                                const LArDriftVolume& driftVolume2,
+                                LArDetectorGapList& listOfGaps);
+
+    /**
+     *  @brief  Return the LArSoft view the detector type maps to a Pandora view, or geo::kUnknown if it cannot be mapped
+     *
+     *  @param  cstat the input cryostat
+     *  @param  tpc the input tpc
+     *  @param  pandoraView the Pandora view, geo::kU, geo::kV or geo::kW
+     */
+    static geo::View_t GetTargetView(const unsigned int cstat,
+                                     const unsigned int tpc,
+                                     const geo::View_t pandoraView);
+
     /**
      *  @brief  Generate a unique identifier for each TPC
      *
@@ -700,6 +859,39 @@ namespace lar_pandora {
     return m_tpcVolumeList;
   }
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline unsigned int
+  LArDriftVolumeLookup::GetVolumeID(const unsigned int cstat, const unsigned int tpc) const
+  {
+    return m_volumeIDs[this->GetIndex(cstat, tpc)];
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline unsigned int
+  LArDriftVolumeLookup::GetDaughterVolumeID(const unsigned int cstat, const unsigned int tpc) const
+  {
+    return m_daughterVolumeIDs[this->GetIndex(cstat, tpc)];
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline bool
+  LArDriftVolumeLookup::IsPositiveDrift(const unsigned int cstat, const unsigned int tpc) const
+  {
+    return m_isPositiveDrift[this->GetIndex(cstat, tpc)];
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline bool
+  LArDriftVolumeLookup::IsLoaded() const
+  {
+    return !m_volumeIDs.empty();
+  }
+
 } // namespace lar_pandora
 
 #endif // #ifndef LAR_PANDORA_GEOMETRY_H
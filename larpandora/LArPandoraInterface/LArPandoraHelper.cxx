@@ -37,6 +37,7 @@
 #include "Pandora/PdgTable.h"
 
 #include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+#include "larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h"
 
 #include <iostream>
 #include <limits>
@@ -527,16 +528,8 @@ namespace lar_pandora {
                                            HitsToPFParticles& hitsToParticles,
                                            const DaughterMode daughterMode)
   {
-    // Build mapping from particle to particle ID for parent/daughter navigation
-    PFParticleMap particleMap;
-
-    for (PFParticleVector::const_iterator iter1 = particleVector.begin(),
-                                          iterEnd1 = particleVector.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> particle = *iter1;
-      particleMap[particle->Self()] = particle;
-    }
+    // Build hierarchy of particles for parent/daughter navigation
+    const PFParticleHierarchy hierarchy(particleVector);
 
     // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
     for (PFParticlesToSpacePoints::const_iterator iter1 = particlesToSpacePoints.begin(),
@@ -546,11 +539,11 @@ namespace lar_pandora {
       const art::Ptr<recob::PFParticle> thisParticle = iter1->first;
       const art::Ptr<recob::PFParticle> particle(
         (kAddDaughters == daughterMode) ?
-          LArPandoraHelper::GetFinalStatePFParticle(particleMap, thisParticle) :
+          LArPandoraHelper::GetFinalStatePFParticle(hierarchy, thisParticle) :
           thisParticle);
 
       if ((kIgnoreDaughters == daughterMode) &&
-          !LArPandoraHelper::IsFinalState(particleMap, particle))
+          !LArPandoraHelper::IsFinalState(hierarchy, particle))
         continue;
 
       const SpacePointVector& spacePointVector = iter1->second;
@@ -584,16 +577,8 @@ namespace lar_pandora {
                                            HitsToPFParticles& hitsToParticles,
                                            const DaughterMode daughterMode)
   {
-    // Build mapping from particle to particle ID for parent/daughter navigation
-    PFParticleMap particleMap;
-
-    for (PFParticleVector::const_iterator iter1 = particleVector.begin(),
-                                          iterEnd1 = particleVector.end();
-         iter1 != iterEnd1;
-         ++iter1) {
-      const art::Ptr<recob::PFParticle> particle = *iter1;
-      particleMap[particle->Self()] = particle;
-    }
+    // Build hierarchy of particles for parent/daughter navigation
+    const PFParticleHierarchy hierarchy(particleVector);
 
     // Loop over hits and build mapping between reconstructed final-state particles and reconstructed hits
     for (PFParticlesToClusters::const_iterator iter1 = particlesToClusters.begin(),
@@ -603,11 +588,11 @@ namespace lar_pandora {
       const art::Ptr<recob::PFParticle> thisParticle = iter1->first;
       const art::Ptr<recob::PFParticle> particle(
         (kAddDaughters == daughterMode) ?
-          LArPandoraHelper::GetFinalStatePFParticle(particleMap, thisParticle) :
+          LArPandoraHelper::GetFinalStatePFParticle(hierarchy, thisParticle) :
           thisParticle);
 
       if ((kIgnoreDaughters == daughterMode) &&
-          !LArPandoraHelper::IsFinalState(particleMap, particle))
+          !LArPandoraHelper::IsFinalState(hierarchy, particle))
         continue;
 
       const ClusterVector& clusterVector = iter1->second;
@@ -722,16 +707,8 @@ namespace lar_pandora {
   LArPandoraHelper::SelectFinalStatePFParticles(const PFParticleVector& inputParticles,
                                                 PFParticleVector& outputParticles)
   {
-    // Build mapping from particle to particle ID for parent/daughter navigation
-    PFParticleMap particleMap;
-
-    for (PFParticleVector::const_iterator iter = inputParticles.begin(),
-                                          iterEnd = inputParticles.end();
-         iter != iterEnd;
-         ++iter) {
-      const art::Ptr<recob::PFParticle> particle = *iter;
-      particleMap[particle->Self()] = particle;
-    }
+    // Build hierarchy of particles for parent/daughter navigation
+    const PFParticleHierarchy hierarchy(inputParticles);
 
     // Select final-state particles
     for (PFParticleVector::const_iterator iter = inputParticles.begin(),
@@ -740,7 +717,7 @@ namespace lar_pandora {
          ++iter) {
       const art::Ptr<recob::PFParticle> particle = *iter;
 
-      if (LArPandoraHelper::IsFinalState(particleMap, particle))
+      if (LArPandoraHelper::IsFinalState(hierarchy, particle))
         outputParticles.push_back(particle);
     }
   }
@@ -1281,6 +1258,42 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  art::Ptr<recob::PFParticle>
+  LArPandoraHelper::GetParentPFParticle(const PFParticleHierarchy& hierarchy,
+                                        const art::Ptr<recob::PFParticle> inputParticle)
+  {
+    const size_t index(hierarchy.GetIndex(inputParticle->Self()));
+    const size_t rootIndex((PFParticleHierarchy::kInvalidIndex == index) ?
+                             PFParticleHierarchy::kInvalidIndex :
+                             hierarchy.GetRootIndex(index));
+
+    if (PFParticleHierarchy::kInvalidIndex == rootIndex)
+      throw cet::exception("LArPandora")
+        << " PandoraCollector::GetParentPFParticle --- Found a PFParticle without a particle ID ";
+
+    return hierarchy.GetParticle(rootIndex);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  art::Ptr<recob::PFParticle>
+  LArPandoraHelper::GetFinalStatePFParticle(const PFParticleHierarchy& hierarchy,
+                                            const art::Ptr<recob::PFParticle> inputParticle)
+  {
+    const size_t index(hierarchy.GetIndex(inputParticle->Self()));
+    const size_t finalStateIndex((PFParticleHierarchy::kInvalidIndex == index) ?
+                                   PFParticleHierarchy::kInvalidIndex :
+                                   hierarchy.GetFinalStateIndex(index));
+
+    if (PFParticleHierarchy::kInvalidIndex == finalStateIndex)
+      throw cet::exception("LArPandora") << " PandoraCollector::GetFinalStatePFParticle --- Found "
+                                            "a PFParticle without a particle ID ";
+
+    return hierarchy.GetParticle(finalStateIndex);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   art::Ptr<simb::MCParticle>
   LArPandoraHelper::GetParentMCParticle(const MCParticleMap& particleMap,
                                         const art::Ptr<simb::MCParticle> inputParticle)
@@ -1391,6 +1404,23 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  int
+  LArPandoraHelper::GetGeneration(const PFParticleHierarchy& hierarchy,
+                                  const art::Ptr<recob::PFParticle> inputParticle)
+  {
+    const size_t index(hierarchy.GetIndex(inputParticle->Self()));
+    const int nGenerations(
+      (PFParticleHierarchy::kInvalidIndex == index) ? 0 : hierarchy.GetGeneration(index));
+
+    if (0 == nGenerations)
+      throw cet::exception("LArPandora")
+        << " PandoraCollector::GetGeneration --- Found a PFParticle without a particle ID ";
+
+    return nGenerations;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   int
   LArPandoraHelper::GetParentNeutrino(const PFParticleMap& particleMap,
                                       const art::Ptr<recob::PFParticle> daughterParticle)
@@ -1415,6 +1445,27 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  int
+  LArPandoraHelper::GetParentNeutrino(const PFParticleHierarchy& hierarchy,
+                                      const art::Ptr<recob::PFParticle> daughterParticle)
+  {
+    const art::Ptr<recob::PFParticle> parentParticle =
+      LArPandoraHelper::GetParentPFParticle(hierarchy, daughterParticle);
+
+    if (LArPandoraHelper::IsNeutrino(parentParticle)) return parentParticle->PdgCode();
+
+    if (parentParticle->IsPrimary()) return 0;
+
+    const size_t parentIndex(hierarchy.GetIndex(parentParticle->Parent()));
+    if (PFParticleHierarchy::kInvalidIndex == parentIndex)
+      throw cet::exception("LArPandora")
+        << " PandoraCollector::GetParentNeutrino --- Found a PFParticle without a particle ID ";
+
+    return hierarchy.GetParticle(parentIndex)->PdgCode();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   bool
   LArPandoraHelper::IsFinalState(const PFParticleMap& particleMap,
                                  const art::Ptr<recob::PFParticle> daughterParticle)
@@ -1439,6 +1490,24 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  bool
+  LArPandoraHelper::IsFinalState(const PFParticleHierarchy& hierarchy,
+                                 const art::Ptr<recob::PFParticle> daughterParticle)
+  {
+    if (LArPandoraHelper::IsNeutrino(daughterParticle)) return false;
+
+    if (daughterParticle->IsPrimary()) return true;
+
+    const size_t parentIndex(hierarchy.GetIndex(daughterParticle->Parent()));
+    if (PFParticleHierarchy::kInvalidIndex == parentIndex)
+      throw cet::exception("LArPandora")
+        << " PandoraCollector::IsFinalState --- Found a PFParticle without a particle ID ";
+
+    return LArPandoraHelper::IsNeutrino(hierarchy.GetParticle(parentIndex));
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   bool
   LArPandoraHelper::IsNeutrino(const art::Ptr<recob::PFParticle> particle)
   {
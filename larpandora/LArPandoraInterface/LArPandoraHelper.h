@@ -113,6 +113,8 @@ namespace lar_pandora {
   typedef std::map<const pandora::Vertex*, unsigned int> ThreeDVertexMap;
   typedef std::map<int, HitVector> HitArray;
 
+  class PFParticleHierarchy;
+
   /**
  *  @brief  LArPandoraHelper class
  */
@@ -627,6 +629,30 @@ namespace lar_pandora {
       const PFParticleMap& particleMap,
       const art::Ptr<recob::PFParticle> daughterParticle);
 
+    /**
+     *  @brief Return the top-level parent particle from a precomputed particle hierarchy
+     *
+     *  @param hierarchy the precomputed hierarchy of reconstructed particles
+     *  @param daughterParticle the input PF particle
+     *
+     *  @return the top-level parent particle
+     */
+    static art::Ptr<recob::PFParticle> GetParentPFParticle(
+      const PFParticleHierarchy& hierarchy,
+      const art::Ptr<recob::PFParticle> daughterParticle);
+
+    /**
+     *  @brief Return the final-state parent particle from a precomputed particle hierarchy
+     *
+     *  @param hierarchy the precomputed hierarchy of reconstructed particles
+     *  @param daughterParticle the input PF particle
+     *
+     *  @return the final-state parent particle
+     */
+    static art::Ptr<recob::PFParticle> GetFinalStatePFParticle(
+      const PFParticleHierarchy& hierarchy,
+      const art::Ptr<recob::PFParticle> daughterParticle);
+
     /**
      *  @brief Return the top-level parent particle by navigating up the chain of parent/daughter associations
      *
@@ -671,6 +697,17 @@ namespace lar_pandora {
     static int GetGeneration(const PFParticleMap& particleMap,
                              const art::Ptr<recob::PFParticle> daughterParticle);
 
+    /**
+     *  @brief Return the generation of this particle (first generation if primary) from a precomputed particle hierarchy
+     *
+     *  @param hierarchy the precomputed hierarchy of reconstructed particles
+     *  @param daughterParticle the input daughter particle
+     *
+     *  @return the nth generation in the particle hierarchy
+     */
+    static int GetGeneration(const PFParticleHierarchy& hierarchy,
+                             const art::Ptr<recob::PFParticle> daughterParticle);
+
     /**
      *  @brief Return the parent neutrino PDG code (or zero for cosmics) for a given reconstructed particle
      *
@@ -682,6 +719,17 @@ namespace lar_pandora {
     static int GetParentNeutrino(const PFParticleMap& particleMap,
                                  const art::Ptr<recob::PFParticle> daughterParticle);
 
+    /**
+     *  @brief Return the parent neutrino PDG code (or zero for cosmics) from a precomputed particle hierarchy
+     *
+     *  @param hierarchy the precomputed hierarchy of reconstructed particles
+     *  @param daughterParticle the input daughter particle
+     *
+     *  @return the PDG code of the parent neutrinos (or zero for cosmics)
+     */
+    static int GetParentNeutrino(const PFParticleHierarchy& hierarchy,
+                                 const art::Ptr<recob::PFParticle> daughterParticle);
+
     /**
      *  @brief Determine whether a particle has been reconstructed as a final-state particle
      *
@@ -693,6 +741,17 @@ namespace lar_pandora {
     static bool IsFinalState(const PFParticleMap& particleMap,
                              const art::Ptr<recob::PFParticle> daughterParticle);
 
+    /**
+     *  @brief Determine whether a particle has been reconstructed as a final-state particle, using a precomputed particle hierarchy
+     *
+     *  @param hierarchy the precomputed hierarchy of reconstructed particles
+     *  @param daughterParticle the input daughter particle
+     *
+     *  @return true/false
+     */
+    static bool IsFinalState(const PFParticleHierarchy& hierarchy,
+                             const art::Ptr<recob::PFParticle> daughterParticle);
+
     /**
      *  @brief Determine whether a particle has been reconstructed as a neutrino
      *
@@ -45,6 +45,20 @@ namespace lar_pandora {
                                        const LArDriftVolumeMap& driftVolumeMap,
                                        const HitVector& hitVector,
                                        IdToHitMap& idToHitMap)
+  {
+    LArDriftVolumeLookup driftVolumeLookup;
+    LArPandoraGeometry::LoadLookup(driftVolumeMap, driftVolumeLookup);
+    LArPandoraInput::CreatePandoraHits2D(e, settings, driftVolumeLookup, hitVector, idToHitMap);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  void
+  LArPandoraInput::CreatePandoraHits2D(const art::Event& e,
+                                       const Settings& settings,
+                                       const LArDriftVolumeLookup& driftVolumeLookup,
+                                       const HitVector& hitVector,
+                                       IdToHitMap& idToHitMap)
   {
     mf::LogDebug("LArPandora") << " *** LArPandoraInput::CreatePandoraHits2D(...) *** "
                                << std::endl;
@@ -57,7 +71,6 @@ namespace lar_pandora {
 
     art::ServiceHandle<geo::Geometry const> theGeometry;
     auto const detProp = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e);
-    LArPandoraDetectorType* detType(detector_functions::GetDetectorType());
 
     // Loop over ART hits
     int hitCounter(settings.m_hitCounterOffset);
@@ -123,23 +136,26 @@ namespace lar_pandora {
         caloHitParameters.m_hadronicEnergy = mips * settings.m_mips_to_gev;
         caloHitParameters.m_pParentAddress = (void*)((intptr_t)(++hitCounter));
         caloHitParameters.m_larTPCVolumeId =
-          LArPandoraGeometry::GetVolumeID(driftVolumeMap, hit_WireID.Cryostat, hit_WireID.TPC);
-        caloHitParameters.m_daughterVolumeId = LArPandoraGeometry::GetDaughterVolumeID(
-          driftVolumeMap, hit_WireID.Cryostat, hit_WireID.TPC);
+          driftVolumeLookup.GetVolumeID(hit_WireID.Cryostat, hit_WireID.TPC);
+        caloHitParameters.m_daughterVolumeId =
+          driftVolumeLookup.GetDaughterVolumeID(hit_WireID.Cryostat, hit_WireID.TPC);
 
-        if (hit_View == detType->TargetViewW(hit_WireID.TPC, hit_WireID.Cryostat)) {
+        if (hit_View ==
+            driftVolumeLookup.GetTargetView(hit_WireID.Cryostat, hit_WireID.TPC, geo::kW)) {
           caloHitParameters.m_hitType = pandora::TPC_VIEW_W;
           const double wpos_cm(
             pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoW(y0_cm, z0_cm));
           caloHitParameters.m_positionVector = pandora::CartesianVector(xpos_cm, 0., wpos_cm);
         }
-        else if (hit_View == detType->TargetViewU(hit_WireID.TPC, hit_WireID.Cryostat)) {
+        else if (hit_View ==
+                 driftVolumeLookup.GetTargetView(hit_WireID.Cryostat, hit_WireID.TPC, geo::kU)) {
           caloHitParameters.m_hitType = pandora::TPC_VIEW_U;
           const double upos_cm(
             pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoU(y0_cm, z0_cm));
           caloHitParameters.m_positionVector = pandora::CartesianVector(xpos_cm, 0., upos_cm);
         }
-        else if (hit_View == detType->TargetViewV(hit_WireID.TPC, hit_WireID.Cryostat)) {
+        else if (hit_View ==
+                 driftVolumeLookup.GetTargetView(hit_WireID.Cryostat, hit_WireID.TPC, geo::kV)) {
           caloHitParameters.m_hitType = pandora::TPC_VIEW_V;
           const double vpos_cm(
             pPandora->GetPlugins()->GetLArTransformationPlugin()->YZtoV(y0_cm, z0_cm));
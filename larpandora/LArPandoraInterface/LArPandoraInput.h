@@ -56,6 +56,21 @@ namespace lar_pandora {
      *
      *  @param  evt art event being processed
      *  @param  settings the settings
+     *  @param  driftVolumeLookup the lookup table from cryostat/tpc to drift volume and views
+     *  @param  hits the input list of ART hits for this event
+     *  @param  idToHitMap to receive the mapping from Pandora hit ID to ART hit
+     */
+    static void CreatePandoraHits2D(const art::Event& evt,
+                                    const Settings& settings,
+                                    const LArDriftVolumeLookup& driftVolumeLookup,
+                                    const HitVector& hitVector,
+                                    IdToHitMap& idToHitMap);
+
+    /**
+     *  @brief  Create the Pandora 2D hits from the ART hits, building the drift volume lookup table for this call
+     *
+     *  @param  evt art event being processed
+     *  @param  settings the settings
      *  @param  driftVolumeMap the mapping from volume id to drift volume
      *  @param  hits the input list of ART hits for this event
      *  @param  idToHitMap to receive the mapping from Pandora hit ID to ART hit
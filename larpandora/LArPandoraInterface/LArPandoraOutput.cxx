@@ -38,12 +38,27 @@
 
 #include "larpandora/LArPandoraInterface/LArPandoraOutput.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <map>
 #include <numeric> // std::iota()
 
+namespace {
+
+  // Keys of the pfo properties read when building the output, made once rather than per lookup
+  const std::string kIsClearCosmicKey("IsClearCosmic");
+  const std::string kSliceIndexKey("SliceIndex");
+  const std::string kX0Key("X0");
+
+} // namespace
+
 namespace lar_pandora {
 
   void
@@ -103,6 +118,9 @@ namespace lar_pandora {
         LArPandoraOutput::CollectAllPfoOutcomes(settings.m_pPrimaryPandora) :
         LArPandoraOutput::CollectPfos(settings.m_pPrimaryPandora));
 
+    // Classify the pfos once, for the slices and T0s below
+    const PfoClassification pfoClassification(pfoVector);
+
     IdToIdVectorMap pfoToVerticesMap, pfoToTestBeamInteractionVerticesMap;
     const pandora::VertexVector vertexVector(LArPandoraOutput::CollectVertices(
       pfoVector, pfoToVerticesMap, lar_content::LArPfoHelper::GetVertex));
@@ -118,13 +136,13 @@ namespace lar_pandora {
       LArPandoraOutput::CollectClusters(pfoVector, pfoToClustersMap));
 
     IdToIdVectorMap pfoToThreeDHitsMap;
-    const pandora::CaloHitList threeDHitList(
+    const pandora::CaloHitVector threeDHitVector(
       LArPandoraOutput::Collect3DHits(pfoVector, pfoToThreeDHitsMap));
 
     // Get mapping from pandora hits to art hits
-    CaloHitToArtHitMap pandoraHitToArtHitMap;
-    LArPandoraOutput::GetPandoraToArtHitMap(
-      clusterList, threeDHitList, idToHitMap, pandoraHitToArtHitMap);
+    CaloHitToArtHitArray pandoraHitToArtHitArray;
+    LArPandoraOutput::GetPandoraToArtHitArray(
+      clusterList, threeDHitVector, idToHitMap, pandoraHitToArtHitArray);
 
     // Build the ART outputs from the pandora objects
     LArPandoraOutput::BuildVertices(vertexVector, outputVertices);
@@ -133,10 +151,11 @@ namespace lar_pandora {
       LArPandoraOutput::BuildVertices(testBeamInteractionVertexVector,
                                       outputTestBeamInteractionVertices);
 
-    LArPandoraOutput::BuildSpacePoints(evt,
+    LArPandoraOutput::BuildSpacePoints(settings,
+                                       evt,
                                        instanceLabel,
-                                       threeDHitList,
-                                       pandoraHitToArtHitMap,
+                                       threeDHitVector,
+                                       pandoraHitToArtHitArray,
                                        outputSpacePoints,
                                        outputSpacePointsToHits);
 
@@ -144,7 +163,7 @@ namespace lar_pandora {
     LArPandoraOutput::BuildClusters(evt,
                                     instanceLabel,
                                     clusterList,
-                                    pandoraHitToArtHitMap,
+                                    pandoraHitToArtHitArray,
                                     pfoToClustersMap,
                                     outputClusters,
                                     outputClustersToHits,
@@ -170,13 +189,15 @@ namespace lar_pandora {
                                     evt,
                                     instanceLabel,
                                     pfoVector,
+                                    pfoClassification,
                                     idToHitMap,
                                     outputSlices,
                                     outputParticlesToSlices,
                                     outputSlicesToHits);
 
     if (settings.m_shouldRunStitching)
-      LArPandoraOutput::BuildT0s(evt, instanceLabel, pfoVector, outputT0s, outputParticlesToT0s);
+      LArPandoraOutput::BuildT0s(
+        evt, instanceLabel, pfoVector, pfoClassification, outputT0s, outputParticlesToT0s);
 
     if (settings.m_shouldProduceTestBeamInteractionVertices)
       LArPandoraOutput::AssociateAdditionalVertices(evt,
@@ -219,6 +240,24 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  void
+  LArPandoraOutput::ProduceFilteredHitsOutput(const std::string& instanceLabel,
+                                              const HitVector& filteredHits,
+                                              art::Event& evt)
+  {
+    SliceCollection outputSlices(new std::vector<recob::Slice>);
+    SliceToHitCollection outputSlicesToHits(new art::Assns<recob::Slice, recob::Hit>);
+
+    const unsigned int sliceIndex(LArPandoraOutput::BuildDummySlice(outputSlices));
+    LArPandoraOutput::AddAssociation(
+      evt, instanceLabel, sliceIndex, filteredHits, outputSlicesToHits);
+
+    evt.put(std::move(outputSlices), instanceLabel);
+    evt.put(std::move(outputSlicesToHits), instanceLabel);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   bool
   LArPandoraOutput::GetPandoraInstance(const pandora::Pandora* const pPrimaryPandora,
                                        const std::string& name,
@@ -334,7 +373,7 @@ namespace lar_pandora {
     const pandora::ParticleFlowObject* const pParent(lar_content::LArPfoHelper::GetParentPfo(pPfo));
 
     const auto& properties(pParent->GetPropertiesMap());
-    const auto it(properties.find("IsClearCosmic"));
+    const auto it(properties.find(kIsClearCosmicKey));
 
     if (it == properties.end()) return false;
 
@@ -349,7 +388,7 @@ namespace lar_pandora {
     const pandora::ParticleFlowObject* const pParent(lar_content::LArPfoHelper::GetParentPfo(pPfo));
 
     const auto& properties(pParent->GetPropertiesMap());
-    return (properties.find("SliceIndex") != properties.end());
+    return (properties.find(kSliceIndexKey) != properties.end());
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -360,7 +399,7 @@ namespace lar_pandora {
     const pandora::ParticleFlowObject* const pParent(lar_content::LArPfoHelper::GetParentPfo(pPfo));
 
     const auto& properties(pParent->GetPropertiesMap());
-    const auto it(properties.find("SliceIndex"));
+    const auto it(properties.find(kSliceIndexKey));
 
     if (it == properties.end())
       throw cet::exception("LArPandora")
@@ -472,22 +511,38 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
-  pandora::CaloHitList
+  pandora::CaloHitVector
   LArPandoraOutput::Collect3DHits(const pandora::PfoVector& pfoVector,
                                   IdToIdVectorMap& pfoToThreeDHitsMap)
   {
-    pandora::CaloHitList caloHitList;
+    // Collect and sort the 3D hits of each pfo concurrently, each pfo only fills its own vector
+    std::vector<pandora::CaloHitVector> sorted3DHitVectors(pfoVector.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, pfoVector.size()),
+                      [&pfoVector, &sorted3DHitVectors](const tbb::blocked_range<size_t>& range) {
+                        for (size_t pfoId = range.begin(); pfoId != range.end(); ++pfoId)
+                          LArPandoraOutput::Collect3DHits(pfoVector[pfoId],
+                                                          sorted3DHitVectors[pfoId]);
+                      });
+
+    // The hit ids of each pfo start from the running total of the hits of the pfos before it
+    IdVector hitOffsets(pfoVector.size() + 1, 0);
+    for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId)
+      hitOffsets[pfoId + 1] = hitOffsets[pfoId] + sorted3DHitVectors[pfoId].size();
+
+    pandora::CaloHitVector caloHitVector;
+    caloHitVector.reserve(hitOffsets.back());
 
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
-      const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
+      const pandora::CaloHitVector& sorted3DHits(sorted3DHitVectors[pfoId]);
+
+      IdVector threeDHitIds(sorted3DHits.size());
+      std::iota(threeDHitIds.begin(), threeDHitIds.end(), hitOffsets[pfoId]);
 
-      if (!pfoToThreeDHitsMap.insert(IdToIdVectorMap::value_type(pfoId, {})).second)
+      if (!pfoToThreeDHitsMap.insert(IdToIdVectorMap::value_type(pfoId, std::move(threeDHitIds)))
+             .second)
         throw cet::exception("LArPandora")
           << " LArPandoraOutput::Collect3DHits --- repeated pfos in input list ";
 
-      pandora::CaloHitVector sorted3DHits;
-      LArPandoraOutput::Collect3DHits(pPfo, sorted3DHits);
-
       for (const pandora::CaloHit* const pCaloHit3D : sorted3DHits) {
         if (pandora::TPC_3D !=
             pCaloHit3D
@@ -495,12 +550,11 @@ namespace lar_pandora {
           throw cet::exception("LArPandora")
             << " LArPandoraOutput::Collect3DHits --- found a 2D hit in a 3D cluster";
 
-        pfoToThreeDHitsMap.at(pfoId).push_back(caloHitList.size());
-        caloHitList.push_back(pCaloHit3D);
+        caloHitVector.push_back(pCaloHit3D);
       }
     }
 
-    return caloHitList;
+    return caloHitVector;
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -520,45 +574,78 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  LArPandoraOutput::GetPandoraToArtHitMap(const pandora::ClusterList& clusterList,
-                                          const pandora::CaloHitList& threeDHitList,
-                                          const IdToHitMap& idToHitMap,
-                                          CaloHitToArtHitMap& pandoraHitToArtHitMap)
+  LArPandoraOutput::GetPandoraToArtHitArray(const pandora::ClusterList& clusterList,
+                                            const pandora::CaloHitVector& threeDHitVector,
+                                            const IdToHitMap& idToHitMap,
+                                            CaloHitToArtHitArray& pandoraHitToArtHitArray)
   {
-    // Collect 2D hits from clusters
-    for (const pandora::Cluster* const pCluster : clusterList) {
+    const pandora::ClusterVector clusterVector(clusterList.begin(), clusterList.end());
+
+    for (const pandora::Cluster* const pCluster : clusterVector) {
       if (pandora::TPC_3D == lar_content::LArClusterHelper::GetClusterHitType(pCluster))
         throw cet::exception("LArPandora")
-          << " LArPandoraOutput::GetPandoraToArtHitMap --- found a 3D input cluster ";
-
-      pandora::CaloHitVector sortedHits;
-      LArPandoraOutput::GetHitsInCluster(pCluster, sortedHits);
-
-      for (const pandora::CaloHit* const pCaloHit : sortedHits) {
-        if (!pandoraHitToArtHitMap
-               .insert(CaloHitToArtHitMap::value_type(
-                 pCaloHit, LArPandoraOutput::GetHit(idToHitMap, pCaloHit)))
-               .second)
-          throw cet::exception("LArPandora")
-            << " LArPandoraOutput::GetPandoraToArtHitMap --- found repeated input hits ";
-      }
+          << " LArPandoraOutput::GetPandoraToArtHitArray --- found a 3D input cluster ";
     }
 
-    for (const pandora::CaloHit* const pCaloHit : threeDHitList) {
+    for (const pandora::CaloHit* const pCaloHit : threeDHitVector) {
       if (pCaloHit->GetHitType() != pandora::TPC_3D)
         throw cet::exception("LArPandora")
-          << " LArPandoraOutput::GetPandoraToArtHitMap --- found a non-3D hit in the input list ";
-
-      // ATTN get the 2D calo hit from the 3D calo hit then find the art hit!
-      if (!pandoraHitToArtHitMap
-             .insert(CaloHitToArtHitMap::value_type(
-               pCaloHit,
-               LArPandoraOutput::GetHit(
-                 idToHitMap, static_cast<const pandora::CaloHit*>(pCaloHit->GetParentAddress()))))
-             .second)
-        throw cet::exception("LArPandora")
-          << " LArPandoraOutput::GetPandoraToArtHitMap --- found repeated input hits ";
+          << " LArPandoraOutput::GetPandoraToArtHitArray --- found a non-3D hit in the input list ";
     }
+
+    // Sort the 2D hits of each cluster concurrently
+    const size_t nClusters(clusterVector.size());
+    std::vector<pandora::CaloHitVector> sortedHitVectors(nClusters);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nClusters),
+                      [&clusterVector, &sortedHitVectors](const tbb::blocked_range<size_t>& range) {
+                        for (size_t i = range.begin(); i != range.end(); ++i)
+                          LArPandoraOutput::GetHitsInCluster(clusterVector[i], sortedHitVectors[i]);
+                      });
+
+    // Number the 2D hits cluster by cluster, the first hit of each cluster following all the hits before it
+    IdVector& clusterOffsets(pandoraHitToArtHitArray.m_clusterOffsets);
+    clusterOffsets.assign(nClusters + 1, 0);
+    for (size_t i = 0; i < nClusters; ++i)
+      clusterOffsets[i + 1] = clusterOffsets[i] + sortedHitVectors[i].size();
+
+    pandora::CaloHitVector& twoDHits(pandoraHitToArtHitArray.m_twoDHits);
+    HitVector& twoDArtHits(pandoraHitToArtHitArray.m_twoDArtHits);
+    HitVector& threeDArtHits(pandoraHitToArtHitArray.m_threeDArtHits);
+    twoDHits.resize(clusterOffsets.back());
+    twoDArtHits.resize(clusterOffsets.back());
+    threeDArtHits.resize(threeDHitVector.size());
+
+    // Look up the ART hits concurrently, each hit is written to its own slot
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nClusters),
+                      [&](const tbb::blocked_range<size_t>& range) {
+                        for (size_t i = range.begin(); i != range.end(); ++i) {
+                          size_t hitIndex(clusterOffsets[i]);
+                          for (const pandora::CaloHit* const pCaloHit : sortedHitVectors[i]) {
+                            twoDHits[hitIndex] = pCaloHit;
+                            twoDArtHits[hitIndex] = LArPandoraOutput::GetHit(idToHitMap, pCaloHit);
+                            ++hitIndex;
+                          }
+                        }
+                      });
+
+    // ATTN get the 2D calo hit from the 3D calo hit then find the art hit!
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, threeDHitVector.size()),
+                      [&](const tbb::blocked_range<size_t>& range) {
+                        for (size_t hitId = range.begin(); hitId != range.end(); ++hitId)
+                          threeDArtHits[hitId] = LArPandoraOutput::GetHit(
+                            idToHitMap,
+                            static_cast<const pandora::CaloHit*>(
+                              threeDHitVector[hitId]->GetParentAddress()));
+                      });
+
+    // Each pandora hit may only be output once
+    pandora::CaloHitVector allHits(twoDHits);
+    allHits.insert(allHits.end(), threeDHitVector.begin(), threeDHitVector.end());
+    tbb::parallel_sort(allHits.begin(), allHits.end());
+
+    if (std::adjacent_find(allHits.begin(), allHits.end()) != allHits.end())
+      throw cet::exception("LArPandora")
+        << " LArPandoraOutput::GetPandoraToArtHitArray --- found repeated input hits ";
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -606,28 +693,39 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  LArPandoraOutput::BuildSpacePoints(const art::Event& event,
+  LArPandoraOutput::BuildSpacePoints(const Settings& settings,
+                                     const art::Event& event,
                                      const std::string& instanceLabel,
-                                     const pandora::CaloHitList& threeDHitList,
-                                     const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+                                     const pandora::CaloHitVector& threeDHitVector,
+                                     const CaloHitToArtHitArray& pandoraHitToArtHitArray,
                                      SpacePointCollection& outputSpacePoints,
                                      SpacePointToHitCollection& outputSpacePointsToHits)
   {
-    pandora::CaloHitVector threeDHitVector;
-    threeDHitVector.insert(threeDHitVector.end(), threeDHitList.begin(), threeDHitList.end());
-
-    for (unsigned int hitId = 0; hitId < threeDHitVector.size(); hitId++) {
-      const pandora::CaloHit* const pCaloHit(threeDHitVector.at(hitId));
-
-      CaloHitToArtHitMap::const_iterator it(pandoraHitToArtHitMap.find(pCaloHit));
-      if (it == pandoraHitToArtHitMap.end())
-        throw cet::exception("LArPandora") << " LArPandoraOutput::BuildSpacePoints --- found a "
-                                              "pandora hit without a corresponding art hit ";
-
-      LArPandoraOutput::AddAssociation(
-        event, instanceLabel, hitId, {it->second}, outputSpacePointsToHits);
-      outputSpacePoints->push_back(LArPandoraOutput::BuildSpacePoint(pCaloHit, hitId));
-    }
+    const HitVector& threeDArtHits(pandoraHitToArtHitArray.m_threeDArtHits);
+    if (threeDArtHits.size() != threeDHitVector.size())
+      throw cet::exception("LArPandora") << " LArPandoraOutput::BuildSpacePoints --- found a "
+                                            "pandora hit without a corresponding art hit ";
+
+    std::vector<SpacePointErrorMatrix> errorMatrices;
+    LArPandoraOutput::GetSpacePointErrorMatrices(
+      settings, threeDHitVector, threeDArtHits, errorMatrices);
+
+    // Build the spacepoints concurrently, each into the slot given by its hit id
+    std::vector<recob::SpacePoint> spacePoints(threeDHitVector.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, threeDHitVector.size()),
+                      [&](const tbb::blocked_range<size_t>& range) {
+                        for (size_t hitId = range.begin(); hitId != range.end(); ++hitId)
+                          spacePoints[hitId] = LArPandoraOutput::BuildSpacePoint(
+                            threeDHitVector[hitId], hitId, errorMatrices[hitId]);
+                      });
+
+    outputSpacePoints->insert(outputSpacePoints->end(),
+                              std::make_move_iterator(spacePoints.begin()),
+                              std::make_move_iterator(spacePoints.end()));
+
+    const art::PtrMaker<recob::SpacePoint> makeSpacePointPtr(event, instanceLabel);
+    for (size_t hitId = 0; hitId < threeDHitVector.size(); ++hitId)
+      outputSpacePointsToHits->addSingle(makeSpacePointPtr(hitId), threeDArtHits[hitId]);
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -636,7 +734,7 @@ namespace lar_pandora {
   LArPandoraOutput::BuildClusters(const art::Event& event,
                                   const std::string& instanceLabel,
                                   const pandora::ClusterList& clusterList,
-                                  const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+                                  const CaloHitToArtHitArray& pandoraHitToArtHitArray,
                                   const IdToIdVectorMap& pfoToClustersMap,
                                   ClusterCollection& outputClusters,
                                   ClusterToHitCollection& outputClustersToHits,
@@ -651,16 +749,19 @@ namespace lar_pandora {
       art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(event, clock_data);
     util::GeometryUtilities const gser{*geom, clock_data, det_prop};
 
+    if (pandoraHitToArtHitArray.m_clusterOffsets.size() != clusterList.size() + 1)
+      throw cet::exception("LArPandora")
+        << " LArPandoraOutput::BuildClusters --- hit mapping does not match the input clusters ";
+
     // Produce the art clusters
     size_t nextClusterId(0);
     IdToIdVectorMap pandoraClusterToArtClustersMap;
-    for (const pandora::Cluster* const pCluster : clusterList) {
+    for (size_t clusterId = 0; clusterId < clusterList.size(); ++clusterId) {
       std::vector<HitVector> hitVectors;
       const std::vector<recob::Cluster> clusters(
         LArPandoraOutput::BuildClusters(gser,
-                                        pCluster,
-                                        clusterList,
-                                        pandoraHitToArtHitMap,
+                                        clusterId,
+                                        pandoraHitToArtHitArray,
                                         pandoraClusterToArtClustersMap,
                                         hitVectors,
                                         nextClusterId,
@@ -758,6 +859,8 @@ namespace lar_pandora {
                                           PFParticleMetadataCollection& outputParticleMetadata,
                                           PFParticleToMetadataCollection& outputParticlesToMetadata)
   {
+    outputParticleMetadata->reserve(outputParticleMetadata->size() + pfoVector.size());
+
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
       const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
 
@@ -766,9 +869,9 @@ namespace lar_pandora {
                                        pfoId,
                                        outputParticleMetadata->size(),
                                        outputParticlesToMetadata);
-      larpandoraobj::PFParticleMetadata pPFParticleMetadata(
-        LArPandoraHelper::GetPFParticleMetadata(pPfo));
-      outputParticleMetadata->push_back(pPFParticleMetadata);
+
+      // ATTN build the metadata in place, copying the properties map once
+      outputParticleMetadata->emplace_back(pPfo->GetPropertiesMap());
     }
   }
 
@@ -780,6 +883,7 @@ namespace lar_pandora {
                                 const art::Event& event,
                                 const std::string& instanceLabel,
                                 const pandora::PfoVector& pfoVector,
+                                const PfoClassification& pfoClassification,
                                 const IdToHitMap& idToHitMap,
                                 SliceCollection& outputSlices,
                                 PFParticleToSliceCollection& outputParticlesToSlices,
@@ -813,9 +917,9 @@ namespace lar_pandora {
       const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
 
       // If this PFO is the parent of a hierarchy we have yet to use, then add a new slice
-      if (LArPandoraOutput::IsFromSlice(pPfo)) continue;
+      if (pfoClassification.IsFromSlice(pfoId)) continue;
 
-      if (lar_content::LArPfoHelper::GetParentPfo(pPfo) != pPfo) continue;
+      if (pfoClassification.GetParent(pfoId) != pPfo) continue;
 
       if (!parentPfoToSliceIndexMap
              .emplace(pPfo,
@@ -828,21 +932,18 @@ namespace lar_pandora {
 
     // Add the associations from PFOs to slices
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
-      const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
-
       // For PFOs that are from a Pandora slice, add the association and move on to the next PFO
-      if (LArPandoraOutput::IsFromSlice(pPfo)) {
+      if (pfoClassification.IsFromSlice(pfoId)) {
         LArPandoraOutput::AddAssociation(event,
                                          instanceLabel,
                                          pfoId,
-                                         LArPandoraOutput::GetSliceIndex(pPfo),
+                                         pfoClassification.GetSliceIndex(pfoId),
                                          outputParticlesToSlices);
         continue;
       }
 
       // Get the parent of the particle
-      const pandora::ParticleFlowObject* const pParent(
-        lar_content::LArPfoHelper::GetParentPfo(pPfo));
+      const pandora::ParticleFlowObject* const pParent(pfoClassification.GetParent(pfoId));
       if (parentPfoToSliceIndexMap.find(pParent) == parentPfoToSliceIndexMap.end())
         throw cet::exception("LArPandora")
           << " LArPandoraOutput::BuildSlices --- found pfo without a parent in the input list ";
@@ -873,7 +974,7 @@ namespace lar_pandora {
   //------------------------------------------------------------------------------------------------------------------------------------------
 
   void
-  LArPandoraOutput::CopyAllHitsToSingleSlice(const Settings& settings,
+  LArPandoraOutput::CopyAllHitsToSingleSlice(const Settings& /*settings*/,
                                              const art::Event& event,
                                              const std::string& instanceLabel,
                                              const pandora::PfoVector& pfoVector,
@@ -884,14 +985,15 @@ namespace lar_pandora {
   {
     const unsigned int sliceIndex(LArPandoraOutput::BuildDummySlice(outputSlices));
 
-    // Add all of the hits in the events to the slice
+    // Add the hits given to Pandora, so that hits removed before Pandora are not in the slice
     HitVector hits;
-    LArPandoraHelper::CollectHits(event, settings.m_hitfinderModuleLabel, hits);
+    hits.reserve(idToHitMap.size());
+    for (const auto& idAndHit : idToHitMap)
+      hits.push_back(idAndHit.second);
+
     LArPandoraOutput::AddAssociation(event, instanceLabel, sliceIndex, hits, outputSlicesToHits);
 
-    mf::LogDebug("LArPandora") << "Finding hits with label: " << settings.m_hitfinderModuleLabel
-                               << std::endl;
-    mf::LogDebug("LArPandora") << " - Found " << hits.size() << std::endl;
+    mf::LogDebug("LArPandora") << " - Found " << hits.size() << " input hits" << std::endl;
     mf::LogDebug("LArPandora") << " - Making associations " << outputSlicesToHits->size()
                                << std::endl;
 
@@ -945,19 +1047,39 @@ namespace lar_pandora {
   LArPandoraOutput::BuildT0s(const art::Event& event,
                              const std::string& instanceLabel,
                              const pandora::PfoVector& pfoVector,
+                             const PfoClassification& pfoClassification,
                              T0Collection& outputT0s,
                              PFParticleToT0Collection& outputParticlesToT0s)
   {
+    // The timing data are the same for every pfo in the event
+    auto const clock_data =
+      art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
+    auto const det_prop =
+      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(event, clock_data);
+    const double cm_per_tick(det_prop.GetXTicksCoefficient());
+    const double ns_per_tick(sampling_rate(clock_data));
+
+    const std::vector<double> t0s(
+      LArPandoraOutput::GetT0s(pfoClassification, pfoVector.size(), ns_per_tick, cm_per_tick));
+
+    // ATTN: Only non-zero values are outputted.
+    const size_t nT0s(std::count_if(t0s.begin(), t0s.end(), [](const double T0) {
+      return std::fabs(T0) > std::numeric_limits<double>::epsilon();
+    }));
+    outputT0s->reserve(outputT0s->size() + nT0s);
+
+    const art::PtrMaker<recob::PFParticle> makePfoPtr(event, instanceLabel);
+    const art::PtrMaker<anab::T0> makeT0Ptr(event, instanceLabel);
+
     size_t nextT0Id(0);
     for (unsigned int pfoId = 0; pfoId < pfoVector.size(); ++pfoId) {
-      const pandora::ParticleFlowObject* const pPfo(pfoVector.at(pfoId));
+      const double T0(t0s[pfoId]);
+      if (std::fabs(T0) <= std::numeric_limits<double>::epsilon()) continue;
 
-      anab::T0 t0;
-      if (!LArPandoraOutput::BuildT0(event, pPfo, pfoVector, nextT0Id, t0)) continue;
-
-      LArPandoraOutput::AddAssociation(
-        event, instanceLabel, pfoId, nextT0Id - 1, outputParticlesToT0s);
-      outputT0s->push_back(t0);
+      // Output T0 objects [arguments are:  time (nanoseconds);  trigger type (3 for TPC stitching!);  pfparticle SelfID code;  T0 ID code]
+      outputT0s->emplace_back(T0, 3, pfoId, nextT0Id);
+      outputParticlesToT0s->addSingle(makePfoPtr(pfoId), makeT0Ptr(nextT0Id));
+      ++nextT0Id;
     }
   }
 
@@ -1023,9 +1145,8 @@ namespace lar_pandora {
 
   std::vector<recob::Cluster>
   LArPandoraOutput::BuildClusters(util::GeometryUtilities const& gser,
-                                  const pandora::Cluster* const pCluster,
-                                  const pandora::ClusterList& clusterList,
-                                  const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+                                  const size_t clusterId,
+                                  const CaloHitToArtHitArray& pandoraHitToArtHitArray,
                                   IdToIdVectorMap& pandoraClusterToArtClustersMap,
                                   std::vector<HitVector>& hitVectors,
                                   size_t& nextId,
@@ -1033,25 +1154,24 @@ namespace lar_pandora {
   {
     std::vector<recob::Cluster> clusters;
 
-    // Get the cluster ID and set up the map entry
-    const size_t clusterId(LArPandoraOutput::GetId(pCluster, clusterList));
+    // Set up the map entry
     if (!pandoraClusterToArtClustersMap.insert(IdToIdVectorMap::value_type(clusterId, {})).second)
       throw cet::exception("LArPandora")
         << " LArPandoraOutput::BuildClusters --- repeated clusters in input list ";
 
-    pandora::CaloHitVector sortedHits;
-    LArPandoraOutput::GetHitsInCluster(pCluster, sortedHits);
+    // The sorted hits of the cluster and their art hits
+    const IdVector& clusterOffsets(pandoraHitToArtHitArray.m_clusterOffsets);
+    if (clusterId + 1 >= clusterOffsets.size())
+      throw cet::exception("LArPandora")
+        << " LArPandoraOutput::BuildClusters --- couldn't find art hits for input pandora cluster ";
 
     HitArray hitArray; // hits organised by drift volume
     HitList isolatedHits;
 
-    for (const pandora::CaloHit* const pCaloHit2D : sortedHits) {
-      CaloHitToArtHitMap::const_iterator it(pandoraHitToArtHitMap.find(pCaloHit2D));
-      if (it == pandoraHitToArtHitMap.end())
-        throw cet::exception("LArPandora")
-          << " LArPandoraOutput::BuildClusters --- couldn't find art hit for input pandora hit ";
-
-      const art::Ptr<recob::Hit> hit(it->second);
+    for (size_t hitIndex = clusterOffsets[clusterId]; hitIndex < clusterOffsets[clusterId + 1];
+         ++hitIndex) {
+      const pandora::CaloHit* const pCaloHit2D(pandoraHitToArtHitArray.m_twoDHits.at(hitIndex));
+      const art::Ptr<recob::Hit> hit(pandoraHitToArtHitArray.m_twoDArtHits.at(hitIndex));
 
       const geo::WireID wireID(hit->WireID());
       const unsigned int volID(100000 * wireID.Cryostat + wireID.TPC);
@@ -1166,7 +1286,8 @@ namespace lar_pandora {
 
   recob::SpacePoint
   LArPandoraOutput::BuildSpacePoint(const pandora::CaloHit* const pCaloHit,
-                                    const size_t spacePointId)
+                                    const size_t spacePointId,
+                                    const SpacePointErrorMatrix& errorMatrix)
   {
     if (pandora::TPC_3D != pCaloHit->GetHitType())
       throw cet::exception("LArPandora")
@@ -1175,8 +1296,12 @@ namespace lar_pandora {
     const pandora::CartesianVector point(pCaloHit->GetPositionVector());
     double xyz[3] = {point.GetX(), point.GetY(), point.GetZ()};
 
-    // ATTN using dummy information
-    double dxdydz[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0}; // TODO: Fill in the error matrix
+    double dxdydz[6] = {errorMatrix[0],
+                        errorMatrix[1],
+                        errorMatrix[2],
+                        errorMatrix[3],
+                        errorMatrix[4],
+                        errorMatrix[5]};
     double chi2(0.0);
 
     return recob::SpacePoint(xyz, dxdydz, chi2, spacePointId);
@@ -1184,32 +1309,100 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
-  bool
-  LArPandoraOutput::BuildT0(const art::Event& e,
-                            const pandora::ParticleFlowObject* const pPfo,
-                            const pandora::PfoVector& pfoVector,
-                            size_t& nextId,
-                            anab::T0& t0)
+  void
+  LArPandoraOutput::GetSpacePointErrorMatrices(const Settings& settings,
+                                               const pandora::CaloHitVector& threeDHitVector,
+                                               const HitVector& threeDArtHits,
+                                               std::vector<SpacePointErrorMatrix>& errorMatrices)
   {
-    const pandora::ParticleFlowObject* const pParent(lar_content::LArPfoHelper::GetParentPfo(pPfo));
-    const float x0(pParent->GetPropertiesMap().count("X0") ? pParent->GetPropertiesMap().at("X0") :
-                                                             0.f);
+    const size_t nHits(threeDHitVector.size());
+    errorMatrices.assign(nHits, SpacePointErrorMatrix());
 
-    auto const clock_data = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(e);
-    auto const det_prop =
-      art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e, clock_data);
-    const double cm_per_tick(det_prop.GetXTicksCoefficient());
-    const double ns_per_tick(sampling_rate(clock_data));
+    if (Settings::kNoErrors == settings.m_spacePointErrorModel) return;
+
+    // Direction across the wires in the y-z plane, fetched once per plane
+    art::ServiceHandle<geo::Geometry const> geom{};
+    std::map<geo::PlaneID, std::pair<double, double>> planeToWireNormalMap;
+    std::vector<std::pair<double, double>> wireNormals(nHits);
 
-    // ATTN: T0 values are currently calculated in nanoseconds relative to the trigger offset. Only non-zero values are outputted.
-    const double T0(x0 * ns_per_tick / cm_per_tick);
+    for (size_t hitId = 0; hitId < nHits; ++hitId) {
+      const geo::PlaneID planeID(threeDArtHits[hitId]->WireID().planeID());
+      auto iter(planeToWireNormalMap.find(planeID));
 
-    if (std::fabs(T0) <= std::numeric_limits<double>::epsilon()) return false;
+      if (planeToWireNormalMap.end() == iter) {
+        const auto direction(geom->Plane(planeID).GetIncreasingWireDirection());
+        const double norm(std::sqrt(direction.Y() * direction.Y() + direction.Z() * direction.Z()));
 
-    // Output T0 objects [arguments are:  time (nanoseconds);  trigger type (3 for TPC stitching!);  pfparticle SelfID code;  T0 ID code]
-    t0 = anab::T0(T0, 3, LArPandoraOutput::GetId(pPfo, pfoVector), nextId++);
+        if (!(norm > std::numeric_limits<double>::epsilon()))
+          throw cet::exception("LArPandora")
+            << " LArPandoraOutput::GetSpacePointErrorMatrices --- plane " << planeID
+            << " has no wire direction in y-z ";
 
-    return true;
+        iter = planeToWireNormalMap
+                 .emplace(planeID, std::make_pair(direction.Y() / norm, direction.Z() / norm))
+                 .first;
+      }
+
+      wireNormals[hitId] = iter->second;
+    }
+
+    // Gather the cell sizes of the 2D hits, the 2D hit width in x and the wire pitch
+    std::vector<double> hitWidths(nHits), wirePitches(nHits);
+    for (size_t hitId = 0; hitId < nHits; ++hitId) {
+      const pandora::CaloHit* const pCaloHit2D(
+        static_cast<const pandora::CaloHit*>(threeDHitVector[hitId]->GetParentAddress()));
+      hitWidths[hitId] = pCaloHit2D->GetCellSize1();
+      wirePitches[hitId] = pCaloHit2D->GetCellThickness();
+    }
+
+    // ATTN the hit width spans the peak time +/- one rms, so half of it is the width of the charge in x
+    const double driftVariance(settings.m_driftResolution_cm * settings.m_driftResolution_cm);
+    const double widthScale(
+      Settings::kHitWidthErrors == settings.m_spacePointErrorModel ? 0.25 : 0.);
+
+    // A hit is equally likely to be anywhere across the pitch of its wire
+    for (size_t hitId = 0; hitId < nHits; ++hitId) {
+      const double pitchVariance(wirePitches[hitId] * wirePitches[hitId] / 12.);
+      const double normalY(wireNormals[hitId].first), normalZ(wireNormals[hitId].second);
+
+      SpacePointErrorMatrix& errorMatrix(errorMatrices[hitId]);
+      errorMatrix[0] = widthScale * hitWidths[hitId] * hitWidths[hitId] + driftVariance;
+      errorMatrix[2] = pitchVariance * normalY * normalY;
+      errorMatrix[4] = pitchVariance * normalY * normalZ;
+      errorMatrix[5] = pitchVariance * normalZ * normalZ;
+    }
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  std::vector<double>
+  LArPandoraOutput::GetT0s(const PfoClassification& pfoClassification,
+                           const size_t nPfos,
+                           const double nsPerTick,
+                           const double cmPerTick)
+  {
+    std::vector<double> t0s(nPfos, 0.);
+
+    // The pfos of a hierarchy share the stitching shift of their parent, so convert each parent once
+    std::unordered_map<const pandora::ParticleFlowObject*, double> parentToT0Map;
+
+    for (size_t pfoId = 0; pfoId < nPfos; ++pfoId) {
+      const pandora::ParticleFlowObject* const pParent(pfoClassification.GetParent(pfoId));
+      const auto parentIter(parentToT0Map.emplace(pParent, 0.));
+
+      if (parentIter.second) {
+        const auto& properties(pParent->GetPropertiesMap());
+        const auto it(properties.find(kX0Key));
+        const float x0(it != properties.end() ? it->second : 0.f);
+
+        // ATTN: T0 values are currently calculated in nanoseconds relative to the trigger offset.
+        parentIter.first->second = x0 * nsPerTick / cmPerTick;
+      }
+
+      t0s[pfoId] = parentIter.first->second;
+    }
+
+    return t0s;
   }
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -1221,6 +1414,8 @@ namespace lar_pandora {
     , m_shouldProduceAllOutcomes(false)
     , m_shouldProduceTestBeamInteractionVertices(false)
     , m_isNeutrinoRecoOnlyNoSlicing(false)
+    , m_spacePointErrorModel(kNoErrors)
+    , m_driftResolution_cm(0.)
   {}
 
   //------------------------------------------------------------------------------------------------------------------------------------------
@@ -1232,6 +1427,10 @@ namespace lar_pandora {
       throw cet::exception("LArPandora")
         << " LArPandoraOutput::Settings::Validate --- primary Pandora instance does not exist ";
 
+    if (m_driftResolution_cm < 0.)
+      throw cet::exception("LArPandora")
+        << " LArPandoraOutput::Settings::Validate --- drift resolution must not be negative ";
+
     if (!m_shouldProduceAllOutcomes) return;
 
     if (m_allOutcomesInstanceLabel.empty())
@@ -1239,4 +1438,55 @@ namespace lar_pandora {
         << " LArPandoraOutput::Settings::Validate --- all outcomes instance label not set ";
   }
 
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArPandoraOutput::Settings::SpacePointErrorModel
+  LArPandoraOutput::Settings::GetSpacePointErrorModel(const std::string& name)
+  {
+    if ("None" == name) return kNoErrors;
+
+    if ("WirePitch" == name) return kWirePitchErrors;
+
+    if ("HitWidth" == name) return kHitWidthErrors;
+
+    throw cet::exception("LArPandora")
+      << " LArPandoraOutput::Settings::GetSpacePointErrorModel --- unknown error model: " << name;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArPandoraOutput::PfoClassification::PfoClassification(const pandora::PfoVector& pfoVector)
+  {
+    const size_t nPfos(pfoVector.size());
+    m_parents.reserve(nPfos);
+    m_isFromSlice.reserve(nPfos);
+    m_sliceIndices.reserve(nPfos);
+
+    // The pfos of a hierarchy share a parent, so only read the properties of each parent once
+    std::unordered_map<const pandora::ParticleFlowObject*, size_t> parentToFirstPfoIdMap;
+
+    for (size_t pfoId = 0; pfoId < nPfos; ++pfoId) {
+      const pandora::ParticleFlowObject* const pParent(
+        lar_content::LArPfoHelper::GetParentPfo(pfoVector.at(pfoId)));
+      m_parents.push_back(pParent);
+
+      const auto parentIter(parentToFirstPfoIdMap.emplace(pParent, pfoId));
+      if (!parentIter.second) {
+        const size_t firstPfoId(parentIter.first->second);
+        m_isFromSlice.push_back(m_isFromSlice.at(firstPfoId));
+        m_sliceIndices.push_back(m_sliceIndices.at(firstPfoId));
+        continue;
+      }
+
+      const auto& properties(pParent->GetPropertiesMap());
+      const auto sliceIter(properties.find(kSliceIndexKey));
+      const bool isFromSlice(sliceIter != properties.end());
+
+      m_isFromSlice.push_back(isFromSlice);
+      m_sliceIndices.push_back(
+        isFromSlice ? static_cast<unsigned int>(std::round(sliceIter->second)) : 0);
+    }
+  }
+
 } // namespace lar_pandora
@@ -20,6 +20,8 @@
 
 #include "Pandora/PandoraInternal.h"
 
+#include <array>
+
 namespace pandora {
   class Pandora;
 }
@@ -35,7 +37,6 @@ namespace lar_pandora {
   public:
     typedef std::vector<size_t> IdVector;
     typedef std::map<size_t, IdVector> IdToIdVectorMap;
-    typedef std::map<const pandora::CaloHit*, art::Ptr<recob::Hit>> CaloHitToArtHitMap;
 
     typedef std::unique_ptr<std::vector<recob::PFParticle>> PFParticleCollection;
     typedef std::unique_ptr<std::vector<recob::Vertex>> VertexCollection;
@@ -62,11 +63,22 @@ namespace lar_pandora {
     typedef std::unique_ptr<art::Assns<recob::SpacePoint, recob::Hit>> SpacePointToHitCollection;
     typedef std::unique_ptr<art::Assns<recob::Slice, recob::Hit>> SliceToHitCollection;
 
+    typedef std::array<double, 6> SpacePointErrorMatrix; ///< Lower triangle: xx, xy, yy, xz, yz, zz
+
     /**
      *  @brief  Settings class
      */
     class Settings {
     public:
+      /**
+         *  @brief  SpacePointErrorModel enumeration
+         */
+      enum SpacePointErrorModel {
+        kNoErrors = 0,        // Leave the spacepoint error matrices empty
+        kWirePitchErrors = 1, // Use the wire pitch across the wires in y-z and the drift resolution for x
+        kHitWidthErrors = 2   // As kWirePitchErrors, adding the 2D hit width to the x error
+      };
+
       /**
          *  @brief  Default constructor
          */
@@ -77,6 +89,15 @@ namespace lar_pandora {
          */
       void Validate() const;
 
+      /**
+         *  @brief  Get the spacepoint error model with a given name
+         *
+         *  @param  name the name of the model: None, WirePitch or HitWidth
+         *
+         *  @return the spacepoint error model
+         */
+      static SpacePointErrorModel GetSpacePointErrorModel(const std::string& name);
+
       const pandora::Pandora* m_pPrimaryPandora; ///<
       bool m_shouldRunStitching;                 ///<
       bool
@@ -90,7 +111,60 @@ namespace lar_pandora {
         m_testBeamInteractionVerticesInstanceLabel; ///< The label for the test beam interaction vertices
       bool
         m_isNeutrinoRecoOnlyNoSlicing; ///< If we are running the neutrino reconstruction only with no slicing
-      std::string m_hitfinderModuleLabel; ///< The hit finder module label
+      std::string m_hitfinderModuleLabel;          ///< The hit finder module label
+      SpacePointErrorModel m_spacePointErrorModel; ///< How to fill the spacepoint error matrices
+      double m_driftResolution_cm;                 ///< The drift resolution added to the x errors
+    };
+
+    /**
+     *  @brief  Mapping from pandora hits to ART hits, held in flat arrays indexed by hit ordinal
+     *          The 2D hits are numbered cluster by cluster, in position order, and the 3D hits by spacepoint id
+     */
+    class CaloHitToArtHitArray {
+    public:
+      IdVector m_clusterOffsets;         ///< The first 2D hit of each cluster, then the total
+      pandora::CaloHitVector m_twoDHits; ///< The 2D hits of each cluster, sorted by position
+      HitVector m_twoDArtHits;           ///< The ART hit of each 2D hit
+      HitVector m_threeDArtHits;         ///< The ART hit of each 3D hit
+    };
+
+    /**
+     *  @brief  Per event classification of the output pfos, filled in one pass and indexed by pfo id
+     */
+    class PfoClassification {
+    public:
+      /**
+         *  @brief  Constructor, reading the properties of the parent of each pfo
+         *
+         *  @param  pfoVector the input vector of all pfos to be output
+         */
+      PfoClassification(const pandora::PfoVector& pfoVector);
+
+      /**
+         *  @brief  Get the parent of the pfo, at the top of its hierarchy
+         *
+         *  @param  pfoId the id of the pfo
+         */
+      const pandora::ParticleFlowObject* GetParent(const size_t pfoId) const;
+
+      /**
+         *  @brief  Check if the pfo is from a slice
+         *
+         *  @param  pfoId the id of the pfo
+         */
+      bool IsFromSlice(const size_t pfoId) const;
+
+      /**
+         *  @brief  Get the index of the slice from which the pfo was produced
+         *
+         *  @param  pfoId the id of the pfo
+         */
+      unsigned int GetSliceIndex(const size_t pfoId) const;
+
+    private:
+      std::vector<const pandora::ParticleFlowObject*> m_parents; ///< The parent of each pfo
+      std::vector<bool> m_isFromSlice;                           ///< If the pfo is from a slice
+      std::vector<unsigned int> m_sliceIndices;                  ///< The slice index of each pfo
     };
 
     /**
@@ -104,6 +178,17 @@ namespace lar_pandora {
                                  const IdToHitMap& idToHitMap,
                                  art::Event& evt);
 
+    /**
+     *  @brief  Write the hits removed by the input hit filter into ART event, as the hits of one dummy slice
+     *
+     *  @param  instanceLabel the instance label of the output products
+     *  @param  filteredHits the hits removed before Pandora ingestion
+     *  @param  evt the ART event
+     */
+    static void ProduceFilteredHitsOutput(const std::string& instanceLabel,
+                                          const HitVector& filteredHits,
+                                          art::Event& evt);
+
     /**
      *  @brief  Get the address of a pandora instance with a given name
      *
@@ -217,16 +302,16 @@ namespace lar_pandora {
                               pandora::CaloHitVector& caloHits);
 
     /**
-     *  @brief  Collect a sorted list of all 3D hits contained in the input pfo list
+     *  @brief  Collect a sorted vector of all 3D hits contained in the input pfo list
      *          Order is guaranteed provided pfoVector is ordered
      *
      *  @param  pfoVector the input list of pfos
      *  @param  pfoToThreeDHitsMap the output mapping from pfo ID to 3D hit IDs
      *
-     *  @return the list of 3D hits collected
+     *  @return the vector of 3D hits collected
      */
-    static pandora::CaloHitList Collect3DHits(const pandora::PfoVector& pfoVector,
-                                              IdToIdVectorMap& pfoToThreeDHitsMap);
+    static pandora::CaloHitVector Collect3DHits(const pandora::PfoVector& pfoVector,
+                                                IdToIdVectorMap& pfoToThreeDHitsMap);
 
     /**
      *  @brief  Find the index of an input object in an input list. Throw an exception if it doesn't exist
@@ -254,14 +339,14 @@ namespace lar_pandora {
      *  @brief  Collect all 2D and 3D hits that were used / produced in the reconstruction and map them to their corresponding ART hit
      *
      *  @param  clusterList input list of all 2D clusters to be output
-     *  @param  threeDHitList input list of all 3D hits to be output (as spacepoints)
+     *  @param  threeDHitVector input vector of all 3D hits to be output (as spacepoints)
      *  @param  idToHitMap input mapping from pandora hit ID to ART hit
-     *  @param  pandoraHitToArtHitMap output mapping from pandora hit to ART hit
+     *  @param  pandoraHitToArtHitArray output mapping from pandora hit to ART hit
      */
-    static void GetPandoraToArtHitMap(const pandora::ClusterList& clusterList,
-                                      const pandora::CaloHitList& threeDHitList,
-                                      const IdToHitMap& idToHitMap,
-                                      CaloHitToArtHitMap& pandoraHitToArtHitMap);
+    static void GetPandoraToArtHitArray(const pandora::ClusterList& clusterList,
+                                        const pandora::CaloHitVector& threeDHitVector,
+                                        const IdToHitMap& idToHitMap,
+                                        CaloHitToArtHitArray& pandoraHitToArtHitArray);
 
     /**
      *  @brief  Look up ART hit from an input Pandora hit
@@ -285,16 +370,18 @@ namespace lar_pandora {
      *  @brief  Convert pandora 3D hits to ART spacepoints and add them to the output vector
      *          Create the associations between spacepoints and hits
      *
+     *  @param  settings the settings
      *  @param  event the art event
-     *  @param  threeDHitList the input list of 3D hits to convert
-     *  @param  pandoraHitToArtHitMap the input mapping from pandora hits to ART hits
+     *  @param  threeDHitVector the input vector of 3D hits to convert
+     *  @param  pandoraHitToArtHitArray the input mapping from pandora hits to ART hits
      *  @param  outputSpacePoints the output vector of spacepoints
      *  @param  outputSpacePointsToHits the output associations between spacepoints and hits
      */
-    static void BuildSpacePoints(const art::Event& event,
+    static void BuildSpacePoints(const Settings& settings,
+                                 const art::Event& event,
                                  const std::string& instanceLabel,
-                                 const pandora::CaloHitList& threeDHitList,
-                                 const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+                                 const pandora::CaloHitVector& threeDHitVector,
+                                 const CaloHitToArtHitArray& pandoraHitToArtHitArray,
                                  SpacePointCollection& outputSpacePoints,
                                  SpacePointToHitCollection& outputSpacePointsToHits);
 
@@ -305,7 +392,7 @@ namespace lar_pandora {
      *
      *  @param  event the art event
      *  @param  clusterList the input list of 2D pandora clusters to convert
-     *  @param  pandoraHitToArtHitMap the input mapping from pandora hits to ART hits
+     *  @param  pandoraHitToArtHitArray the input mapping from pandora hits to ART hits
      *  @param  pfoToClustersMap the input mapping from pfo ID to cluster IDs
      *  @param  outputClusters the output vector of clusters
      *  @param  outputClustersToHits the output associations between clusters and hits
@@ -314,7 +401,7 @@ namespace lar_pandora {
     static void BuildClusters(const art::Event& event,
                               const std::string& instanceLabel,
                               const pandora::ClusterList& clusterList,
-                              const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+                              const CaloHitToArtHitArray& pandoraHitToArtHitArray,
                               const IdToIdVectorMap& pfoToClustersMap,
                               ClusterCollection& outputClusters,
                               ClusterToHitCollection& outputClustersToHits,
@@ -383,6 +470,7 @@ namespace lar_pandora {
      *  @param  event the art event
      *  @param  instanceLabel the label for the collections to be produced
      *  @param  pfoVector the input vector of all pfos to be output
+     *  @param  pfoClassification the classification of the input pfos
      *  @param  idToHitMap input mapping from pandora hit ID to ART hit
      *  @param  outputSlices the output collection of slices to populate
      *  @param  outputParticlesToSlices the output association from particles to slices
@@ -393,6 +481,7 @@ namespace lar_pandora {
                             const art::Event& event,
                             const std::string& instanceLabel,
                             const pandora::PfoVector& pfoVector,
+                            const PfoClassification& pfoClassification,
                             const IdToHitMap& idToHitMap,
                             SliceCollection& outputSlices,
                             PFParticleToSliceCollection& outputParticlesToSlices,
@@ -406,7 +495,7 @@ namespace lar_pandora {
     static unsigned int BuildDummySlice(SliceCollection& outputSlices);
 
     /**
-     *  @brief  Ouput a single slice containing all of the input hits
+     *  @brief  Ouput a single slice containing all of the hits given to Pandora
      *
      *  @param  settings the settings
      *  @param  event the art event
@@ -450,12 +539,14 @@ namespace lar_pandora {
      *  @param  event the art event
      *  @param  instanceLabel the label for the collections to be produced
      *  @param  pfoVector the input list of pfos
+     *  @param  pfoClassification the classification of the input pfos
      *  @param  outputT0s the output vector of T0s
      *  @param  outputParticlesToT0s the output associations between PFParticles and T0s
      */
     static void BuildT0s(const art::Event& event,
                          const std::string& instanceLabel,
                          const pandora::PfoVector& pfoVector,
+                         const PfoClassification& pfoClassification,
                          T0Collection& outputT0s,
                          PFParticleToT0Collection& outputParticlesToT0s);
 
@@ -474,11 +565,31 @@ namespace lar_pandora {
      *
      *  @param  pCaloHit the input hit
      *  @param  spacePointId the id of the space-point to produce
+     *  @param  errorMatrix the position covariance matrix
      *
      *  @param  the ART spacepoint
      */
-    static recob::SpacePoint BuildSpacePoint(const pandora::CaloHit* const pCaloHit,
-                                             const size_t spacePointId);
+    static recob::SpacePoint BuildSpacePoint(
+      const pandora::CaloHit* const pCaloHit,
+      const size_t spacePointId,
+      const SpacePointErrorMatrix& errorMatrix = SpacePointErrorMatrix());
+
+    /**
+     *  @brief  Calculate the position covariances of a vector of 3D hits from the 2D hits they were made from
+     *
+     *  The wire pitch of the parent 2D hit constrains the position across its wires in the y-z plane, so
+     *  it is projected onto y and z using the wire direction of its plane. The position along the wires
+     *  is not measured by the parent hit and gets no error from it.
+     *
+     *  @param  settings the settings
+     *  @param  threeDHitVector the input vector of 3D hits
+     *  @param  threeDArtHits the art hits the 3D hits were made from, in the same order
+     *  @param  errorMatrices the output covariance matrix of each hit
+     */
+    static void GetSpacePointErrorMatrices(const Settings& settings,
+                                           const pandora::CaloHitVector& threeDHitVector,
+                                           const HitVector& threeDArtHits,
+                                           std::vector<SpacePointErrorMatrix>& errorMatrices);
 
     /**
      *  @brief  Collect a sorted list of all 2D hits in a cluster
@@ -492,9 +603,8 @@ namespace lar_pandora {
     /**
      *  @brief  Convert from a pandora 2D cluster to a vector of ART clusters (produce multiple if the cluster is split over drift volumes)
      *
-     *  @param  pCluster the input cluster
-     *  @param  clusterList the input list of clusters
-     *  @param  pandoraHitToArtHitMap the input mapping from pandora hits to ART hits
+     *  @param  clusterId the id of the input cluster
+     *  @param  pandoraHitToArtHitArray the input mapping from pandora hits to ART hits
      *  @param  pandoraClusterToArtClustersMap output mapping from pandora cluster ID to art cluster IDs
      *  @param  hitVectors the output vectors of hits for each cluster produced used to produce associations
      *  @param  algo algorithm set to fill cluster members
@@ -503,9 +613,8 @@ namespace lar_pandora {
      */
     static std::vector<recob::Cluster> BuildClusters(
       util::GeometryUtilities const& gser,
-      const pandora::Cluster* const pCluster,
-      const pandora::ClusterList& clusterList,
-      const CaloHitToArtHitMap& pandoraHitToArtHitMap,
+      const size_t clusterId,
+      const CaloHitToArtHitArray& pandoraHitToArtHitArray,
       IdToIdVectorMap& pandoraClusterToArtClustersMap,
       std::vector<HitVector>& hitVectors,
       size_t& nextId,
@@ -544,21 +653,19 @@ namespace lar_pandora {
                                              const pandora::PfoVector& pfoVector);
 
     /**
-     *  @brief  If required, build a T0 for the input pfo
+     *  @brief  Calculate the T0 of each pfo from the stitching hit shift distance of its parent
      *
-     *  @param  event the ART event
-     *  @param  pPfo the input pfo
-     *  @param  pfoVector the input list of pfos
-     *  @param  nextId the ID of the T0 - will be incremented if the t0 was produced
-     *  @param  t0 the output T0
+     *  @param  pfoClassification the classification of the input pfos
+     *  @param  nPfos the number of input pfos
+     *  @param  nsPerTick the readout sampling period in nanoseconds
+     *  @param  cmPerTick the drift distance per readout tick in cm
      *
-     *  @return if a T0 was produced (calculated from the stitching hit shift distance)
+     *  @return the T0 of each pfo, in nanoseconds relative to the trigger offset
      */
-    static bool BuildT0(const art::Event& event,
-                        const pandora::ParticleFlowObject* const pPfo,
-                        const pandora::PfoVector& pfoVector,
-                        size_t& nextId,
-                        anab::T0& t0);
+    static std::vector<double> GetT0s(const PfoClassification& pfoClassification,
+                                      const size_t nPfos,
+                                      const double nsPerTick,
+                                      const double cmPerTick);
 
     /**
      *  @brief  Add an association between objects with two given ids
@@ -608,6 +715,34 @@ namespace lar_pandora {
 
   //------------------------------------------------------------------------------------------------------------------------------------------
 
+  inline const pandora::ParticleFlowObject*
+  LArPandoraOutput::PfoClassification::GetParent(const size_t pfoId) const
+  {
+    return m_parents.at(pfoId);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline bool
+  LArPandoraOutput::PfoClassification::IsFromSlice(const size_t pfoId) const
+  {
+    return m_isFromSlice.at(pfoId);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline unsigned int
+  LArPandoraOutput::PfoClassification::GetSliceIndex(const size_t pfoId) const
+  {
+    if (!m_isFromSlice.at(pfoId))
+      throw cet::exception("LArPandora")
+        << " LArPandoraOutput::GetSliceIndex--- Input PFO was not from a slice ";
+
+    return m_sliceIndices.at(pfoId);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
   template <typename T>
   inline size_t
   LArPandoraOutput::GetId(const T* const pT, const std::list<const T*>& tList)
@@ -0,0 +1,82 @@
+/**
+ *  @file  larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.cxx
+ *
+ *  @brief precomputed view of the PFParticle parent/daughter hierarchy
+ *
+ */
+
+#include "lardataobj/RecoBase/PFParticle.h"
+
+#include "larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h"
+
+#include <algorithm>
+
+namespace lar_pandora {
+
+  PFParticleHierarchy::PFParticleHierarchy(const PFParticleVector& particleVector)
+    : m_particles(particleVector)
+  {
+    const size_t nParticles(m_particles.size());
+
+    size_t maxSelf(0);
+    for (const art::Ptr<recob::PFParticle>& particle : m_particles)
+      maxSelf = std::max(maxSelf, particle->Self());
+
+    // ATTN Later particles with a duplicate ID win, as for PFParticleMap
+    m_selfToIndex.assign(nParticles ? maxSelf + 1 : 0, kInvalidIndex);
+    for (size_t index = 0; index < nParticles; ++index)
+      m_selfToIndex[m_particles[index]->Self()] = index;
+
+    m_parentIndex.assign(nParticles, kInvalidIndex);
+    for (size_t index = 0; index < nParticles; ++index) {
+      const art::Ptr<recob::PFParticle>& particle(m_particles[index]);
+      if (!particle->IsPrimary()) m_parentIndex[index] = this->GetIndex(particle->Parent());
+    }
+
+    // Resolve each chain of parents once, walking up to the first resolved ancestor and back down
+    m_rootIndex.assign(nParticles, kInvalidIndex);
+    m_finalStateIndex.assign(nParticles, kInvalidIndex);
+    m_generation.assign(nParticles, 0);
+
+    enum State : char { kUnvisited = 0, kVisiting = 1, kResolved = 2 };
+    std::vector<char> state(nParticles, kUnvisited);
+    std::vector<size_t> chain;
+
+    for (size_t index = 0; index < nParticles; ++index) {
+      size_t thisIndex(index);
+
+      while ((kInvalidIndex != thisIndex) && (kUnvisited == state[thisIndex])) {
+        state[thisIndex] = kVisiting;
+        chain.push_back(thisIndex);
+        thisIndex = m_parentIndex[thisIndex];
+      }
+
+      while (!chain.empty()) {
+        const size_t daughterIndex(chain.back());
+        chain.pop_back();
+
+        const art::Ptr<recob::PFParticle>& daughter(m_particles[daughterIndex]);
+        const size_t parentIndex(m_parentIndex[daughterIndex]);
+
+        if (daughter->IsPrimary()) {
+          m_rootIndex[daughterIndex] = daughterIndex;
+          m_finalStateIndex[daughterIndex] = daughterIndex;
+          m_generation[daughterIndex] = 1;
+        }
+        else if ((kInvalidIndex != parentIndex) && (kResolved == state[parentIndex])) {
+          // ATTN A loop in the parent links leaves the parent unresolved, so it is treated as a broken chain
+          m_rootIndex[daughterIndex] = m_rootIndex[parentIndex];
+          m_finalStateIndex[daughterIndex] =
+            LArPandoraHelper::IsNeutrino(m_particles[parentIndex]) ?
+              daughterIndex :
+              m_finalStateIndex[parentIndex];
+          m_generation[daughterIndex] =
+            (m_generation[parentIndex] > 0) ? m_generation[parentIndex] + 1 : 0;
+        }
+
+        state[daughterIndex] = kResolved;
+      }
+    }
+  }
+
+} // namespace lar_pandora
@@ -0,0 +1,160 @@
+/**
+ *  @file  larpandora/LArPandoraInterface/LArPandoraPFParticleHierarchy.h
+ *
+ *  @brief precomputed view of the PFParticle parent/daughter hierarchy
+ *
+ */
+#ifndef LAR_PANDORA_PFPARTICLE_HIERARCHY_H
+#define LAR_PANDORA_PFPARTICLE_HIERARCHY_H
+
+#include "larpandora/LArPandoraInterface/LArPandoraHelper.h"
+
+#include <limits>
+#include <vector>
+
+namespace lar_pandora {
+
+  /**
+ *  @brief  PFParticleHierarchy class, answering parent/daughter navigation queries by array lookup
+ */
+  class PFParticleHierarchy {
+  public:
+    static constexpr size_t kInvalidIndex = std::numeric_limits<size_t>::max();
+
+    /**
+     *  @brief  Default constructor, creating an empty hierarchy
+     */
+    PFParticleHierarchy() = default;
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  particleVector the input vector of reconstructed particles (it has to be all of them!)
+     */
+    explicit PFParticleHierarchy(const PFParticleVector& particleVector);
+
+    /**
+     *  @brief  Get the number of particles in the hierarchy
+     */
+    size_t GetNParticles() const;
+
+    /**
+     *  @brief  Get the particle stored at a given index
+     *
+     *  @param  index the index of the particle in the hierarchy
+     */
+    const art::Ptr<recob::PFParticle>& GetParticle(const size_t index) const;
+
+    /**
+     *  @brief  Get the index of the particle with a given particle ID
+     *
+     *  @param  self the particle ID
+     *
+     *  @return the index, or kInvalidIndex if the particle ID is unknown
+     */
+    size_t GetIndex(const size_t self) const;
+
+    /**
+     *  @brief  Get the index of the parent of a particle
+     *
+     *  @param  index the index of the particle in the hierarchy
+     *
+     *  @return the parent index, or kInvalidIndex for primary particles and unknown parents
+     */
+    size_t GetParentIndex(const size_t index) const;
+
+    /**
+     *  @brief  Get the index of the top-level parent of a particle
+     *
+     *  @param  index the index of the particle in the hierarchy
+     *
+     *  @return the top-level parent index, or kInvalidIndex if the chain of parents is broken
+     */
+    size_t GetRootIndex(const size_t index) const;
+
+    /**
+     *  @brief  Get the index of the final-state parent of a particle
+     *
+     *  @param  index the index of the particle in the hierarchy
+     *
+     *  @return the final-state parent index, or kInvalidIndex if the chain of parents is broken
+     */
+    size_t GetFinalStateIndex(const size_t index) const;
+
+    /**
+     *  @brief  Get the generation of a particle (first generation if primary)
+     *
+     *  @param  index the index of the particle in the hierarchy
+     *
+     *  @return the generation, or zero if the chain of parents is broken
+     */
+    int GetGeneration(const size_t index) const;
+
+  private:
+    PFParticleVector m_particles;          ///< The particles, in input order
+    std::vector<size_t> m_selfToIndex;     ///< Dense mapping from particle ID to index
+    std::vector<size_t> m_parentIndex;     ///< The parent index of each particle
+    std::vector<size_t> m_rootIndex;       ///< The top-level parent index of each particle
+    std::vector<size_t> m_finalStateIndex; ///< The final-state parent index of each particle
+    std::vector<int> m_generation;         ///< The generation of each particle
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline size_t
+  PFParticleHierarchy::GetNParticles() const
+  {
+    return m_particles.size();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline const art::Ptr<recob::PFParticle>&
+  PFParticleHierarchy::GetParticle(const size_t index) const
+  {
+    return m_particles.at(index);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline size_t
+  PFParticleHierarchy::GetIndex(const size_t self) const
+  {
+    return (self < m_selfToIndex.size()) ? m_selfToIndex[self] : kInvalidIndex;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline size_t
+  PFParticleHierarchy::GetParentIndex(const size_t index) const
+  {
+    return m_parentIndex.at(index);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline size_t
+  PFParticleHierarchy::GetRootIndex(const size_t index) const
+  {
+    return m_rootIndex.at(index);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline size_t
+  PFParticleHierarchy::GetFinalStateIndex(const size_t index) const
+  {
+    return m_finalStateIndex.at(index);
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  inline int
+  PFParticleHierarchy::GetGeneration(const size_t index) const
+  {
+    return m_generation.at(index);
+  }
+
+} // namespace lar_pandora
+
+#endif //  LAR_PANDORA_PFPARTICLE_HIERARCHY_H
@@ -0,0 +1,181 @@
+/**
+ *  @file   test/LArPandoraEventBuilding/ShowerTrajPointIndex_test.cc
+ *
+ *  @brief  Check that the projection search in ShowerTrajPointIndex finds the same trajectory points as the loop over
+ *          every point that ShowerTrajPointdEdx used before
+ */
+
+#include "larpandora/LArPandoraEventBuilding/LArPandoraShower/Algs/ShowerTrajPointIndex.hh"
+
+#include "TVector3.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using reco::shower::ShowerTrajPointIndex;
+
+namespace {
+
+  /**
+   *  @brief  A generated track: the trajectory point positions and whether each point is valid
+   */
+  struct TestTrack {
+    std::vector<TVector3> m_positions;
+    std::vector<bool> m_isValid;
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+   *  @brief  The loop over every trajectory point, as in ShowerTrajPointdEdx before the index
+   */
+  unsigned int
+  FindClosestBruteForce(const TestTrack& track, const TVector3& pos, const double maxDist)
+  {
+    unsigned int index = ShowerTrajPointIndex::kNoPoint;
+    double MinDist = 999;
+
+    for (unsigned int traj = 0; traj < track.m_positions.size(); ++traj) {
+      if (!track.m_isValid[traj]) continue;
+
+      const TVector3 dist = pos - track.m_positions[traj];
+
+      if (dist.Mag() < MinDist && dist.Mag() < maxDist) {
+        index = traj;
+        MinDist = dist.Mag();
+      }
+    }
+
+    return index;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+   *  @brief  A random walk with small steps and occasional kinks, some invalid points, some repeated points to give
+   *          ties, and, when curling, a track that turns back on itself so the projections are not monotonic
+   */
+  TestTrack
+  MakeTrack(const unsigned int seed, const unsigned int nPoints, const bool isCurling)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    std::normal_distribution<double> scatter(0., 0.05);
+
+    TestTrack track;
+    TVector3 position(0., 0., 0.);
+    TVector3 direction(0., 0., 1.);
+
+    for (unsigned int traj = 0; traj < nPoints; ++traj) {
+      if (traj > 0 && uniform(generator) < 0.02) {
+        track.m_positions.push_back(track.m_positions.back());
+      }
+      else {
+        direction += TVector3(scatter(generator), scatter(generator), scatter(generator));
+
+        if (uniform(generator) < 0.001) direction.RotateX(M_PI / 4.);
+
+        if (isCurling) direction.RotateY(2. * M_PI / 2000.);
+
+        direction = direction.Unit();
+        position += 0.3 * direction;
+        track.m_positions.push_back(position);
+      }
+
+      track.m_isValid.push_back(uniform(generator) > 0.05);
+    }
+
+    return track;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+   *  @brief  Query positions near random trajectory points, and some far from the track
+   */
+  std::vector<TVector3>
+  MakeQueries(const unsigned int seed, const TestTrack& track, const unsigned int nQueries)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<unsigned int> trajDistribution(0, track.m_positions.size() - 1);
+    std::normal_distribution<double> offset(0., 1.);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+
+    std::vector<TVector3> queries;
+
+    for (unsigned int query = 0; query < nQueries; ++query) {
+      const TVector3& trajPosition(track.m_positions[trajDistribution(generator)]);
+
+      if (uniform(generator) < 0.05) {
+        queries.push_back(trajPosition);
+      }
+      else {
+        const double scale(uniform(generator) < 0.1 ? 50. : 1.);
+        queries.push_back(trajPosition + scale * TVector3(offset(generator),
+                                                          offset(generator),
+                                                          offset(generator)));
+      }
+    }
+
+    return queries;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+   *  @brief  Compare the index with the loop over every point for each query and max distance
+   *
+   *  @return whether every query gave the same point, and the queries both found and missed points
+   */
+  bool
+  CheckTrack(const TestTrack& track, const std::vector<TVector3>& queries)
+  {
+    // The tool passes MaxDist * wirepitch; include a distance above the 999 cm cap on the loop
+    const std::vector<double> maxDists = {0.1, 0.9, 3., 30., 2000.};
+
+    ShowerTrajPointIndex trajPointIndex;
+    trajPointIndex.Fill(track.m_positions, track.m_isValid);
+
+    bool isFound(false), isMissed(false);
+
+    for (const double maxDist : maxDists) {
+      for (const TVector3& pos : queries) {
+        const unsigned int index(trajPointIndex.FindClosest(pos, maxDist));
+
+        if (index != FindClosestBruteForce(track, pos, maxDist)) return false;
+
+        if (ShowerTrajPointIndex::kNoPoint == index)
+          isMissed = true;
+        else
+          isFound = true;
+      }
+    }
+
+    return isFound && isMissed;
+  }
+
+} // namespace
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+int
+main()
+{
+  bool isPassed(true);
+
+  // Short tracks stay below the 999 sentinel, long ones go beyond it
+  const unsigned int nPointsList[2] = {300, 2500};
+
+  for (unsigned int seed = 1; seed <= 3; ++seed) {
+    for (const unsigned int nPoints : nPointsList) {
+      for (const bool isCurling : {false, true}) {
+        const TestTrack track(MakeTrack(seed, nPoints, isCurling));
+        isPassed &= CheckTrack(track, MakeQueries(seed + 100, track, 300));
+      }
+    }
+  }
+
+  return isPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
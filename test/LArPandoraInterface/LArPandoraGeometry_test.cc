@@ -0,0 +1,215 @@
+/**
+ *  @file   test/LArPandoraInterface/LArPandoraGeometry_test.cc
+ *
+ *  @brief  Check that the sweep along X in LArPandoraGeometry::LoadDetectorGaps finds the same gaps as a test of every
+ *          pair of drift volumes, on generated layouts with thousands of volumes
+ */
+
+#include "larpandora/LArPandoraInterface/Detectors/VintageLArTPCThreeView.h"
+#include "larpandora/LArPandoraInterface/LArPandoraGeometry.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+using namespace lar_pandora;
+
+namespace {
+
+  /**
+   *  @brief  The three view detector type, with the sweep along X switched off so every pair is tested
+   */
+  class AllPairsThreeView : public VintageLArTPCThreeView {
+  public:
+    bool
+    AreDetectorGapsLocalInX() const override
+    {
+      return false;
+    }
+  };
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  LArDriftVolume
+  MakeVolume(const unsigned int volumeID,
+             const float centerX,
+             const float centerY,
+             const float centerZ,
+             const float widthX,
+             const float widthY,
+             const float widthZ)
+  {
+    return LArDriftVolume(volumeID,
+                          true,
+                          0.3f,
+                          0.3f,
+                          0.3f,
+                          0.f,
+                          0.f,
+                          0.f,
+                          centerX,
+                          centerY,
+                          centerZ,
+                          widthX,
+                          widthY,
+                          widthZ,
+                          0.f,
+                          LArDaughterDriftVolumeList());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  bool
+  AreSameGaps(const LArDetectorGap& gap1, const LArDetectorGap& gap2)
+  {
+    return (gap1.GetX1() == gap2.GetX1() && gap1.GetY1() == gap2.GetY1() &&
+            gap1.GetZ1() == gap2.GetZ1() && gap1.GetX2() == gap2.GetX2() &&
+            gap1.GetY2() == gap2.GetY2() && gap1.GetZ2() == gap2.GetZ2());
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+   *  @brief  Load the gaps with the sweep and with every pair, and check that the lists are identical
+   *
+   *  @param  driftVolumeList the layout
+   *  @param  nExpectedGaps the number of gaps expected, or -1 if not known
+   *
+   *  @return whether the lists are identical and have the expected number of gaps, or at least one if not known
+   */
+  bool
+  CheckLayout(const LArDriftVolumeList& driftVolumeList, const int nExpectedGaps = -1)
+  {
+    const VintageLArTPCThreeView sweepDetectorType;
+    const AllPairsThreeView allPairsDetectorType;
+
+    LArDetectorGapList sweepGaps, allPairsGaps;
+    LArPandoraGeometry::LoadDetectorGaps(sweepDetectorType, driftVolumeList, sweepGaps);
+    LArPandoraGeometry::LoadDetectorGaps(allPairsDetectorType, driftVolumeList, allPairsGaps);
+
+    if (sweepGaps.size() != allPairsGaps.size()) return false;
+
+    for (size_t gapIndex = 0; gapIndex < sweepGaps.size(); ++gapIndex) {
+      if (!AreSameGaps(sweepGaps[gapIndex], allPairsGaps[gapIndex])) return false;
+    }
+
+    if (nExpectedGaps >= 0) return (static_cast<int>(sweepGaps.size()) == nExpectedGaps);
+
+    return !sweepGaps.empty();
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+   *  @brief  Columns of volumes along X on a grid in Y-Z, with column gaps below, at and just above the max gap size
+   */
+  LArDriftVolumeList
+  MakeGridLayout()
+  {
+    const float maxGap(LArDetectorGap::GetMaxGapSize());
+    const float columnGaps[4] = {10.f, maxGap, maxGap + 0.5f, 0.f};
+    const float widthX(250.f);
+
+    LArDriftVolumeList driftVolumeList;
+    unsigned int volumeID(0);
+    float centerX(0.f);
+
+    for (unsigned int iX = 0; iX < 40; ++iX) {
+      for (unsigned int iY = 0; iY < 10; ++iY) {
+        for (unsigned int iZ = 0; iZ < 10; ++iZ)
+          driftVolumeList.push_back(
+            MakeVolume(volumeID++, centerX, 20.f * iY, 20.f * iZ, widthX, 20.f, 20.f));
+      }
+
+      centerX += widthX + columnGaps[iX % 4];
+    }
+
+    return driftVolumeList;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+   *  @brief  Randomly placed volumes of random widths, in the order they are generated
+   */
+  LArDriftVolumeList
+  MakeRandomLayout(const unsigned int seed, const unsigned int nVolumes)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> centerXDistribution(0.f, 1.e5f);
+    std::uniform_real_distribution<float> widthXDistribution(5.f, 500.f);
+    std::uniform_int_distribution<int> centerYZDistribution(0, 3);
+
+    LArDriftVolumeList driftVolumeList;
+
+    for (unsigned int volumeID = 0; volumeID < nVolumes; ++volumeID)
+      driftVolumeList.push_back(MakeVolume(volumeID,
+                                           centerXDistribution(generator),
+                                           15.f * centerYZDistribution(generator),
+                                           15.f * centerYZDistribution(generator),
+                                           widthXDistribution(generator),
+                                           100.f,
+                                           100.f));
+
+    return driftVolumeList;
+  }
+
+  //------------------------------------------------------------------------------------------------------------------------------------------
+
+  /**
+   *  @brief  Pairs of the widest volumes at the edge of the sweep window: the centres are the max gap size plus the
+   *          max width apart, at large X where the float rounding is coarse, so without the 1% margin they would sit
+   *          exactly on the edge of the window. Each pair at the max gap size gives one gap, those just beyond none.
+   */
+  LArDriftVolumeList
+  MakeMarginLayout(unsigned int& nExpectedGaps)
+  {
+    const float maxGap(LArDetectorGap::GetMaxGapSize());
+    const float widthX(1000.f);
+
+    LArDriftVolumeList driftVolumeList;
+    unsigned int volumeID(0);
+    nExpectedGaps = 0;
+
+    for (unsigned int iPair = 0; iPair < 200; ++iPair) {
+      const float centerX1(1.e4f + 3.7f * widthX * iPair + 0.1f * iPair);
+      const bool isAtMaxGap(0 == iPair % 2);
+      const float centerX2(centerX1 + widthX + (isAtMaxGap ? maxGap : maxGap + 0.01f));
+
+      driftVolumeList.push_back(MakeVolume(volumeID++, centerX1, 0.f, 0.f, widthX, 100.f, 100.f));
+      driftVolumeList.push_back(MakeVolume(volumeID++, centerX2, 0.f, 0.f, widthX, 100.f, 100.f));
+
+      // The float gap decides, exactly as LoadDetectorGap computes it
+      const float gapX(std::fabs(centerX2 - centerX1) - 0.5f * (widthX + widthX));
+      if (gapX >= 0.f && gapX <= maxGap) ++nExpectedGaps;
+    }
+
+    // A narrow pair, tested with a window set by the widest volume
+    driftVolumeList.push_back(MakeVolume(volumeID++, -5000.f, 0.f, 0.f, 10.f, 100.f, 100.f));
+    driftVolumeList.push_back(
+      MakeVolume(volumeID++, -5000.f + 10.f + maxGap, 0.f, 0.f, 10.f, 100.f, 100.f));
+    ++nExpectedGaps;
+
+    return driftVolumeList;
+  }
+
+} // namespace
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+int
+main()
+{
+  bool success(true);
+
+  success = CheckLayout(MakeGridLayout()) && success;
+
+  for (unsigned int seed = 1; seed <= 5; ++seed)
+    success = CheckLayout(MakeRandomLayout(seed, 3000)) && success;
+
+  unsigned int nExpectedGaps(0);
+  const LArDriftVolumeList marginLayout(MakeMarginLayout(nExpectedGaps));
+  success = CheckLayout(marginLayout, static_cast<int>(nExpectedGaps)) && success;
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}